@@ -0,0 +1,221 @@
+/**
+ * @file	adc_measure.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * ADC measurement service referenced to the internal bandgap.
+ *
+ * At each reference measurement two factors are computed:
+ *
+ *   scale = VBG / bandgap, in mV per count, Q19: the product by a result
+ *           is below VDDA * 2^19, so it fits 32 bits up to 8 V;
+ *   slope = VBG / (bandgap * m), in m°C per count, Q16.
+ *
+ * The temperature is then an offset, fixed by VTEMP25 and m, minus the
+ * result times the slope.
+ *
+ */
+
+#include <string.h>
+#include "adc_measure.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define ADC_MEASURE_SCALE_SHIFT 19U
+#define ADC_MEASURE_SLOPE_SHIFT 16U
+
+/*!< Highest VDDA accepted, above the absolute maximum rating.*/
+#define ADC_MEASURE_MAX_VDDA_MV 4000U
+
+/*!< Sample time and average of the reference conversions.*/
+#define ADC_MEASURE_SC3 (ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(kADC16_HardwareAverageCount32))
+
+/*!< Service runtime data.*/
+typedef struct{
+	ADC_Type *base;
+	uint32_t bandgap_uV;
+	uint32_t tempSlope_uV;
+	int32_t tempOffset_mC;  /*!< Temperature of a 0 V result.*/
+	uint16_t refreshScans;
+	uint16_t scans;         /*!< Updates since the last reference.*/
+	uint32_t scale;         /*!< mV per count, Q19.*/
+	uint32_t slope;         /*!< m°C per count, Q16.*/
+	adcMeasureReference_t reference;
+}adcMeasureHandle_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Converts a single ended channel by software, polling the end.
+ *
+ */
+static uint16_t Convert(ADC_Type *base, uint32_t channel);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static adcMeasureHandle_t s_measure;
+
+/*!< Resolution of each CFG1 MODE, single ended.*/
+static const uint8_t s_modeBits[4] = {8U, 12U, 10U, 16U};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint16_t Convert(ADC_Type *base, uint32_t channel)
+{
+	base->SC1[0] = ADC_SC1_ADCH(channel);
+	while(!(base->SC1[0] & ADC_SC1_COCO_MASK))
+	{
+	}
+
+	return (uint16_t)base->R[0];
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+void AdcMeasure_GetDefaultConfig(adcMeasureConfig_t *config)
+{
+	config->base = ADC0;
+	config->bandgap_uV = 1000000U;
+	config->temp25_uV = 716000U;
+	config->tempSlope_uV = 1620U;
+	config->refreshScans = 16U;
+}
+
+status_t AdcMeasure_Init(const adcMeasureConfig_t *config)
+{
+	if((config == NULL) || (config->base == NULL) || (config->bandgap_uV == 0U) ||
+	   (config->tempSlope_uV == 0U) || (config->refreshScans == 0U))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	memset(&s_measure, 0, sizeof(s_measure));
+	s_measure.base = config->base;
+	s_measure.bandgap_uV = config->bandgap_uV;
+	s_measure.tempSlope_uV = config->tempSlope_uV;
+	s_measure.refreshScans = config->refreshScans;
+	s_measure.tempOffset_mC = 25000 + (int32_t)(((uint64_t)config->temp25_uV * 1000U) / config->tempSlope_uV);
+
+	/* The bandgap reaches the ADC only through its buffer. ACKISO is
+	 * write 1 to clear, it is not written back. */
+	PMC->REGSC = (PMC->REGSC & ~PMC_REGSC_ACKISO_MASK) | PMC_REGSC_BGBE_MASK;
+
+	return AdcMeasure_Refresh();
+}
+
+status_t AdcMeasure_Refresh(void)
+{
+	ADC_Type *base = s_measure.base;
+	uint32_t cfg1, cfg2, sc2, sc3;
+	uint32_t bits, vdda_mV;
+	uint16_t bandgap, temperature;
+
+	if(base->SC2 & ADC_SC2_ADACT_MASK)
+	{
+		return kStatus_AdcMeasure_Busy;
+	}
+
+	cfg1 = base->CFG1;
+	cfg2 = base->CFG2;
+	sc2 = base->SC2;
+	sc3 = base->SC3;
+
+	/* Software trigger, long sample time (ADLSTS = 0: 20 extra cycles). */
+	base->SC2 = sc2 & ~(ADC_SC2_ADTRG_MASK | ADC_SC2_ACFE_MASK | ADC_SC2_DMAEN_MASK);
+	base->CFG1 = cfg1 | ADC_CFG1_ADLSMP_MASK;
+	base->CFG2 = cfg2 & ~(ADC_CFG2_MUXSEL_MASK | ADC_CFG2_ADLSTS_MASK);
+	base->SC3 = ADC_MEASURE_SC3;
+
+	temperature = Convert(base, ADC_MEASURE_TEMPERATURE_CHANNEL);
+	bandgap = Convert(base, ADC_MEASURE_BANDGAP_CHANNEL);
+
+	/* CAL and CALF are not written back. */
+	base->CFG1 = cfg1;
+	base->CFG2 = cfg2;
+	base->SC3 = sc3 & ~(ADC_SC3_CAL_MASK | ADC_SC3_CALF_MASK);
+	base->SC2 = sc2;
+	/* With the hardware trigger the user must arm SC1A again. */
+	base->SC1[0] = ADC_SC1_ADCH(0x1FU);
+
+	bits = s_modeBits[(cfg1 & ADC_CFG1_MODE_MASK) >> ADC_CFG1_MODE_SHIFT];
+
+	if(bandgap == 0U)
+	{
+		return kStatus_OutOfRange;
+	}
+	vdda_mV = (uint32_t)((((uint64_t)s_measure.bandgap_uV << bits) / bandgap + 500U) / 1000U);
+	if(vdda_mV > ADC_MEASURE_MAX_VDDA_MV)
+	{
+		return kStatus_OutOfRange;
+	}
+
+	s_measure.scale = (uint32_t)((((uint64_t)s_measure.bandgap_uV << ADC_MEASURE_SCALE_SHIFT) + 500U * bandgap) /
+	                             (1000U * bandgap));
+	s_measure.slope = (uint32_t)(((((uint64_t)s_measure.bandgap_uV * 1000U) << ADC_MEASURE_SLOPE_SHIFT) +
+	                              ((uint64_t)s_measure.tempSlope_uV * bandgap) / 2U) /
+	                             ((uint64_t)s_measure.tempSlope_uV * bandgap));
+
+	s_measure.reference.vdda_mV = (uint16_t)vdda_mV;
+	s_measure.reference.bandgap = bandgap;
+	s_measure.reference.temperature = temperature;
+	s_measure.reference.bits = (uint8_t)bits;
+	s_measure.reference.temperature_mC = AdcMeasure_ToMilliCelsius(temperature);
+	s_measure.reference.refreshes++;
+	s_measure.scans = 0U;
+
+	return kStatus_Success;
+}
+
+status_t AdcMeasure_Update(void)
+{
+	if(++s_measure.scans < s_measure.refreshScans)
+	{
+		return kStatus_Success;
+	}
+
+	/* On error scans stays at the limit, so the next call tries again. */
+	s_measure.scans = s_measure.refreshScans;
+
+	return AdcMeasure_Refresh();
+}
+
+uint32_t AdcMeasure_ToMillivolts(uint16_t counts)
+{
+	return (counts * s_measure.scale + (1U << (ADC_MEASURE_SCALE_SHIFT - 1U))) >> ADC_MEASURE_SCALE_SHIFT;
+}
+
+int32_t AdcMeasure_ToMilliCelsius(uint16_t counts)
+{
+	return s_measure.tempOffset_mC - (int32_t)(((uint64_t)counts * s_measure.slope) >> ADC_MEASURE_SLOPE_SHIFT);
+}
+
+void AdcMeasure_GetReference(adcMeasureReference_t *reference)
+{
+	*reference = s_measure.reference;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file	adc_measure.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * ADC measurement service: results in millivolts and milli degrees
+ * Celsius, referenced to the internal bandgap instead of a nominal VREFH.
+ *
+ * The bandgap (ADC0 channel 27, VBG = 1.00 V typical) is converted from
+ * time to time, and gives the actual supply:
+ *
+ *   VDDA = VBG * 2^N / bandgap
+ *
+ * so a result of any channel, in the same resolution, is:
+ *
+ *   V = counts * VBG / bandgap
+ *
+ * The internal temperature sensor (channel 26) is converted together, and
+ * gives, with the datasheet typical values VTEMP25 = 716 mV and
+ * m = 1.62 mV/C:
+ *
+ *   T = 25 C - (VTEMP - VTEMP25) / m
+ *
+ * All the divisions are done only when the reference is measured, which
+ * happens once every refreshScans calls of AdcMeasure_Update(): each
+ * conversion is then a multiplication and a shift, in fixed point.
+ *
+ * The reference conversions are made by software, with the long sample
+ * time and 32 samples hardware average, and the ADC registers are
+ * restored after them. They must be made while the ADC is idle, e.g.
+ * between the scans of adc_scan with the software trigger.
+ *
+ */
+
+#ifndef ADC_MEASURE_H_
+#define ADC_MEASURE_H_
+
+#include <stdint.h>
+#include "fsl_common.h"
+#include "fsl_adc16.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup adc_measure
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Internal channels.*/
+#define ADC_MEASURE_TEMPERATURE_CHANNEL 26U
+#define ADC_MEASURE_BANDGAP_CHANNEL 27U
+
+/*!< Status codes.*/
+enum _adc_measure_status{
+	kStatus_AdcMeasure_Busy = MAKE_STATUS(kStatusGroup_ApplicationRangeStart, 1), /*!< The ADC is converting.*/
+};
+
+/*!
+ * @brief Service configuration structure.
+ */
+typedef struct{
+	ADC_Type *base;         /*!< ADC peripheral base address.*/
+	uint32_t bandgap_uV;    /*!< Bandgap voltage (VBG).*/
+	uint32_t temp25_uV;     /*!< Temperature sensor voltage at 25 C (VTEMP25).*/
+	uint32_t tempSlope_uV;  /*!< Temperature sensor slope, per C (m).*/
+	uint16_t refreshScans;  /*!< AdcMeasure_Update() calls between reference measurements.*/
+}adcMeasureConfig_t;
+
+/*!
+ * @brief The last reference measurement.
+ */
+typedef struct{
+	uint16_t vdda_mV;       /*!< Supply (VREFH) voltage.*/
+	int32_t temperature_mC; /*!< Chip temperature.*/
+	uint16_t bandgap;       /*!< Bandgap result.*/
+	uint16_t temperature;   /*!< Temperature sensor result.*/
+	uint8_t bits;           /*!< Resolution of the results.*/
+	uint32_t refreshes;     /*!< Number of reference measurements.*/
+}adcMeasureReference_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Gets the datasheet typical values, with a reference measurement
+ *        every 16 updates.
+ *
+ * @param config - the configuration to be filled.
+ *
+ */
+void AdcMeasure_GetDefaultConfig(adcMeasureConfig_t *config);
+
+/**
+ * @brief Enables the bandgap buffer and measures the reference.
+ *
+ *        The ADC must be initialized and calibrated, in the resolution of
+ *        the conversions to be converted.
+ *
+ * @param config - the configuration.
+ *
+ * @return The AdcMeasure_Refresh() status;
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t AdcMeasure_Init(const adcMeasureConfig_t *config);
+
+/**
+ * @brief Measures the bandgap and the temperature sensor now.
+ *
+ * @return kStatus_Success if measured;
+ *         kStatus_AdcMeasure_Busy if the ADC is converting;
+ *         kStatus_OutOfRange if the bandgap result is not plausible (the
+ *         previous reference is kept).
+ *
+ */
+status_t AdcMeasure_Refresh(void);
+
+/**
+ * @brief Counts a scan, measuring the reference at every refreshScans
+ *        calls. Must be called while the ADC is idle.
+ *
+ * @return kStatus_Success if nothing was due or if measured; else the
+ *         AdcMeasure_Refresh() status, and it is tried again at the next
+ *         call.
+ *
+ */
+status_t AdcMeasure_Update(void);
+
+/**
+ * @brief Converts a single ended result to millivolts.
+ *
+ * @param counts - the result.
+ *
+ * @return The voltage, in mV.
+ *
+ */
+uint32_t AdcMeasure_ToMillivolts(uint16_t counts);
+
+/**
+ * @brief Converts a temperature sensor result to milli degrees Celsius.
+ *
+ * @param counts - the temperature sensor result.
+ *
+ * @return The temperature, in m°C.
+ *
+ */
+int32_t AdcMeasure_ToMilliCelsius(uint16_t counts);
+
+/**
+ * @brief Copies the last reference measurement.
+ *
+ * @param reference - where it is copied.
+ *
+ */
+void AdcMeasure_GetReference(adcMeasureReference_t *reference);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* ADC_MEASURE_H_ */
@@ -0,0 +1,238 @@
+/**
+ * @file	adc_scan.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A multichannel scan sequencer for the KL25Z ADC16, chained from the
+ * conversion complete interrupt.
+ *
+ */
+
+#include "adc_scan.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define ADC_SCAN_MAX_CHANNEL_NUMBER 30U /*!< 31 (0x1F) disables the module.*/
+
+/*!< Register values of one channel, computed once by AdcScan_Init(),
+ *   so the ISR only writes them.*/
+typedef struct{
+	uint8_t sc1;  /*!< ADCH, DIFF and AIEN.*/
+	uint8_t cfg2; /*!< MUXSEL.*/
+	uint8_t sc3;  /*!< AVGE and AVGS.*/
+}adcScanRegisters_t;
+
+/*!< Sequencer runtime data.*/
+typedef struct{
+	ADC_Type *base;
+	adcScanRegisters_t channels[ADC_SCAN_MAX_CHANNELS];
+	uint8_t count;
+	bool hardwareTrigger;
+	volatile bool busy;       /*!< Software triggered scan running.*/
+	uint8_t index;            /*!< Channel being converted.*/
+	uint8_t active;           /*!< Vector being written.*/
+	volatile uint8_t latest;  /*!< Last complete vector.*/
+	volatile uint32_t sequence;
+	uint16_t vectors[2][ADC_SCAN_MAX_CHANNELS];
+	adcScanCallback_t callback;
+	void *userData;
+}adcScanHandle_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static adcScanHandle_t s_scan;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/**
+ * @brief Writes the channel registers. The SC1A write starts the conversion,
+ *        or arms it if the hardware trigger is enabled.
+ *
+ */
+static inline void LoadChannel(ADC_Type *base, const adcScanRegisters_t *channel)
+{
+	base->CFG2 = (base->CFG2 & ~ADC_CFG2_MUXSEL_MASK) | channel->cfg2;
+	/* CALF is write 1 to clear, it is not written back. */
+	base->SC3 = (base->SC3 & ~(ADC_SC3_AVGE_MASK | ADC_SC3_AVGS_MASK | ADC_SC3_CALF_MASK)) | channel->sc3;
+	base->SC1[0] = channel->sc1;
+}
+
+status_t AdcScan_Init(const adcScanConfig_t *config)
+{
+	uint32_t i;
+
+	if((config == NULL) || (config->base == NULL) || (config->channels == NULL) ||
+	   (config->channelsCount == 0U) || (config->channelsCount > ADC_SCAN_MAX_CHANNELS))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	for(i = 0U; i < config->channelsCount; i++)
+	{
+		if(config->channels[i].channelNumber > ADC_SCAN_MAX_CHANNEL_NUMBER)
+		{
+			return kStatus_InvalidArgument;
+		}
+	}
+
+	DisableIRQ(ADC0_IRQn);
+
+	memset(&s_scan, 0, sizeof(s_scan));
+	s_scan.base = config->base;
+	s_scan.count = config->channelsCount;
+	s_scan.hardwareTrigger = config->enableHardwareTrigger;
+	s_scan.callback = config->callback;
+	s_scan.userData = config->userData;
+
+	for(i = 0U; i < config->channelsCount; i++)
+	{
+		const adcScanChannel_t *channel = &config->channels[i];
+
+		s_scan.channels[i].sc1 = ADC_SC1_ADCH(channel->channelNumber) |
+		                         ADC_SC1_DIFF(channel->enableDifferential ? 1U : 0U) | ADC_SC1_AIEN_MASK;
+		s_scan.channels[i].cfg2 = ADC_CFG2_MUXSEL(channel->mux);
+		s_scan.channels[i].sc3 = (channel->average == kADC16_HardwareAverageDisabled) ?
+		                         0U : (ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(channel->average));
+	}
+
+	/* Single conversions: the sequencer starts each one. */
+	config->base->SC3 &= ~(ADC_SC3_ADCO_MASK | ADC_SC3_CALF_MASK);
+	(void)config->base->R[0];
+
+	if(s_scan.hardwareTrigger)
+	{
+		config->base->SC2 |= ADC_SC2_ADTRG_MASK;
+		LoadChannel(config->base, &s_scan.channels[0]);
+	}
+	else
+	{
+		config->base->SC2 &= ~ADC_SC2_ADTRG_MASK;
+	}
+
+	EnableIRQ(ADC0_IRQn);
+
+	return kStatus_Success;
+}
+
+void AdcScan_Deinit(void)
+{
+	DisableIRQ(ADC0_IRQn);
+	/* ADCH = 0x1F disables the conversions. */
+	s_scan.base->SC1[0] = ADC_SC1_ADCH_MASK;
+	s_scan.busy = false;
+}
+
+status_t AdcScan_Trigger(void)
+{
+	status_t status = kStatus_Success;
+	uint32_t primask = DisableGlobalIRQ();
+
+	if(s_scan.hardwareTrigger || s_scan.busy)
+	{
+		status = kStatus_AdcScan_Busy;
+	}
+	else
+	{
+		s_scan.busy = true;
+		s_scan.index = 0U;
+		LoadChannel(s_scan.base, &s_scan.channels[0]);
+	}
+	EnableGlobalIRQ(primask);
+
+	return status;
+}
+
+bool AdcScan_IsBusy(void)
+{
+	if(s_scan.hardwareTrigger)
+	{
+		/* Armed between the scans: busy only after the first conversion. */
+		return s_scan.index != 0U;
+	}
+
+	return s_scan.busy;
+}
+
+uint32_t AdcScan_GetLatest(uint16_t *values)
+{
+	uint32_t sequence;
+	uint32_t primask = DisableGlobalIRQ();
+
+	memcpy(values, s_scan.vectors[s_scan.latest], s_scan.count * sizeof(uint16_t));
+	sequence = s_scan.sequence;
+	EnableGlobalIRQ(primask);
+
+	return sequence;
+}
+
+void AdcScan_IRQHandler(void)
+{
+	ADC_Type *base = s_scan.base;
+	adcScanResult_t result;
+
+	if(!(base->SC1[0] & ADC_SC1_COCO_MASK))
+	{
+		return;
+	}
+
+	/* Reading R clears COCO. */
+	s_scan.vectors[s_scan.active][s_scan.index] = (uint16_t)base->R[0];
+	s_scan.index++;
+
+	if(s_scan.index < s_scan.count)
+	{
+		if(s_scan.hardwareTrigger && (s_scan.index == 1U))
+		{
+			/* The rest of the scan is started by software. */
+			base->SC2 &= ~ADC_SC2_ADTRG_MASK;
+		}
+		LoadChannel(base, &s_scan.channels[s_scan.index]);
+		return;
+	}
+
+	/* Scan complete: the vector is delivered and the other one is filled next. */
+	result.values = s_scan.vectors[s_scan.active];
+	result.count = s_scan.count;
+	result.sequence = ++s_scan.sequence;
+	s_scan.latest = s_scan.active;
+	s_scan.active ^= 1U;
+	s_scan.index = 0U;
+
+	if(s_scan.hardwareTrigger)
+	{
+		/* Armed for the next trigger. */
+		base->SC2 |= ADC_SC2_ADTRG_MASK;
+		LoadChannel(base, &s_scan.channels[0]);
+	}
+	else
+	{
+		s_scan.busy = false;
+	}
+
+	if(s_scan.callback != NULL)
+	{
+		s_scan.callback(&result, s_scan.userData);
+	}
+}
@@ -0,0 +1,177 @@
+/**
+ * @file	adc_scan.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A multichannel scan sequencer for the KL25Z ADC16.
+ *
+ * A scan converts a list of channels, each one with its own mux (A/B),
+ * single ended or differential input and hardware averaging, and
+ * delivers the results as one sample vector.
+ *
+ * The first conversion is started by the hardware trigger (selected in
+ * SIM_SOPT7, e.g. TPM0 overflow) or by AdcScan_Trigger(). Each next
+ * conversion is chained from the conversion complete (COCO) interrupt:
+ * the ISR only reads the result and writes the precomputed CFG2, SC3 and
+ * SC1A values of the next channel, so the delay between the channels is
+ * the conversion time plus a constant interrupt latency, and the CPU
+ * does nothing while the conversions run.
+ *
+ * The results are written in two alternate vectors: the one passed to
+ * the callback stays valid until the end of the next scan.
+ *
+ * The ADC must be previously initialized and calibrated with the fsl_adc16
+ * driver. The application must call AdcScan_IRQHandler() from
+ * ADC0_IRQHandler().
+ *
+ */
+
+#ifndef ADC_SCAN_H_
+#define ADC_SCAN_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "fsl_adc16.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup adc_scan
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Maximum number of channels in a scan.*/
+#ifndef ADC_SCAN_MAX_CHANNELS
+#define ADC_SCAN_MAX_CHANNELS 16U
+#endif
+
+/*!< Status codes.*/
+enum _adc_scan_status{
+	kStatus_AdcScan_Busy = MAKE_STATUS(kStatusGroup_ApplicationRangeStart, 0), /*!< A scan is running.*/
+};
+
+/*!
+ * @brief One channel of the scan list.
+ */
+typedef struct{
+	uint8_t channelNumber;                 /*!< ADCH value (0 to 30).*/
+	adc16_channel_mux_mode_t mux;          /*!< Mux A or B, for the channels 4 to 7.*/
+	bool enableDifferential;               /*!< Differential conversion (DADP/DADM pairs).*/
+	adc16_hardware_average_mode_t average; /*!< Hardware averaging of this channel.*/
+}adcScanChannel_t;
+
+/*!
+ * @brief A complete scan.
+ */
+typedef struct{
+	const uint16_t *values; /*!< Results in the list order. Differential results
+	                             are two's complement (cast to int16_t).*/
+	uint8_t count;          /*!< Number of results.*/
+	uint32_t sequence;      /*!< Scan number, incremented by each completed scan.*/
+}adcScanResult_t;
+
+/*!< Scan complete callback, called in interrupt context.*/
+typedef void (*adcScanCallback_t)(const adcScanResult_t *result, void *userData);
+
+/*!
+ * @brief Sequencer configuration structure.
+ */
+typedef struct{
+	ADC_Type *base;                   /*!< ADC peripheral base address.*/
+	const adcScanChannel_t *channels; /*!< Channel list, copied by AdcScan_Init().*/
+	uint8_t channelsCount;            /*!< Number of channels (1 to ADC_SCAN_MAX_CHANNELS).*/
+	bool enableHardwareTrigger;       /*!< Start each scan by the hardware trigger.*/
+	adcScanCallback_t callback;       /*!< Scan complete callback, can be NULL.*/
+	void *userData;                   /*!< Parameter passed to the callback.*/
+}adcScanConfig_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Configures the sequencer.
+ *
+ *        With the hardware trigger, the ADC is armed and the scans start
+ *        at each trigger. The trigger period must be longer than the scan
+ *        time: a trigger during a scan is ignored by the ADC.
+ *
+ * @param config - the configuration.
+ *
+ * @return kStatus_Success if configured;
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t AdcScan_Init(const adcScanConfig_t *config);
+
+/**
+ * @brief Stops the sequencer, disabling the ADC interrupt.
+ *
+ */
+void AdcScan_Deinit(void);
+
+/**
+ * @brief Starts a scan by software.
+ *
+ * @return kStatus_Success if started;
+ *         kStatus_AdcScan_Busy if a scan is running.
+ *
+ */
+status_t AdcScan_Trigger(void);
+
+/**
+ * @brief Tests if a scan is running.
+ *
+ * @return true if the ADC is converting a scan.
+ *
+ */
+bool AdcScan_IsBusy(void);
+
+/**
+ * @brief Copies the last complete sample vector.
+ *
+ * @param values - where the results will be copied (one per channel).
+ *
+ * @return The scan number of the values, 0 if no scan was completed.
+ *
+ */
+uint32_t AdcScan_GetLatest(uint16_t *values);
+
+/**
+ * @brief The sequencer interrupt routine.
+ *
+ *        Must be called from ADC0_IRQHandler().
+ *
+ */
+void AdcScan_IRQHandler(void);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* ADC_SCAN_H_ */
@@ -44,27 +44,44 @@
 #include "fsl_adc16.h"
 #include "stdbool.h"
 #include "delay.h"
+#include "adc_scan.h"
+#include "adc_measure.h"
 
 /* TODO: insert other definitions and declarations here. */
-#define ADC_GROUP_A 0U
 #define ADC_CHANNEL 4U
+#define ADC_AXES 2U
 
 /*******************************************************************************
  * Variables
  ******************************************************************************/
 
+/* Eixos X e Y: mesmo canal, mux A (ADC0_SE4a) e mux B (ADC0_SE4b). */
+static const adcScanChannel_t g_joystickChannels[ADC_AXES] = {
+    {ADC_CHANNEL, kADC16_ChannelMuxA, false, kADC16_HardwareAverageCount4},
+    {ADC_CHANNEL, kADC16_ChannelMuxB, false, kADC16_HardwareAverageCount4},
+};
+
 /*******************************************************************************
  * Code
  ******************************************************************************/
 
+void ADC0_IRQHandler(void)
+{
+    AdcScan_IRQHandler();
+}
+
 /*
  * @brief   Application entry point.
  */
 int main(void) {
 
     adc16_config_t adc16ConfigStruct;
-    adc16_channel_config_t adcChannel4ConfigStruct;
-    char axis;
+    adcScanConfig_t scanConfig;
+    adcMeasureConfig_t measureConfig;
+    adcMeasureReference_t reference;
+    uint16_t axes[ADC_AXES];
+    uint32_t primask;
+    bool busy;
 
   	/* Init board hardware. */
     BOARD_InitBootPins();
@@ -92,26 +109,46 @@ int main(void) {
     	PRINTF("ADC16_DoAutoCalibration() Failed.\r\n");
     }
 
-    adcChannel4ConfigStruct.channelNumber = ADC_CHANNEL;
-    adcChannel4ConfigStruct.enableInterruptOnConversionCompleted = false;
-    adcChannel4ConfigStruct.enableDifferentialConversion = false;
+    /* Mede o bandgap e o sensor de temperatura internos: VDDA real em vez do nominal. */
+    AdcMeasure_GetDefaultConfig(&measureConfig);
+    if (kStatus_Success != AdcMeasure_Init(&measureConfig))
+    {
+        PRINTF("ADC bandgap reference Failed.\r\n");
+    }
+
+    /* O sequenciador troca o mux e encadeia as conversões na interrupção do ADC. */
+    scanConfig.base = ADC0;
+    scanConfig.channels = g_joystickChannels;
+    scanConfig.channelsCount = ADC_AXES;
+    scanConfig.enableHardwareTrigger = false;
+    scanConfig.callback = NULL;
+    scanConfig.userData = NULL;
+    AdcScan_Init(&scanConfig);
 
     while(true)
     {
-    	ADC16_SetChannelMuxMode(ADC0, kADC16_ChannelMuxA);
-    	axis = 'X';
-    	for(int i = 0; i < 2; ++i)
+    	AdcScan_Trigger();
+    	// Espere pelo fim da varredura dormindo até a próxima interrupção.
+    	// O teste é feito com as interrupções mascaradas: uma interrupção
+    	// pendente ainda acorda o WFI, então o fim da varredura não é perdido.
+    	do
     	{
-        	ADC16_SetChannelConfig(ADC0, ADC_GROUP_A, &adcChannel4ConfigStruct);
-    		// Espere pelo fim da conversão e depois pegue o valor.
-    		while (kADC16_ChannelConversionDoneFlag != ADC16_GetChannelStatusFlags(ADC0, ADC_GROUP_A))
+    		primask = DisableGlobalIRQ();
+    		busy = AdcScan_IsBusy();
+    		if (busy)
     		{
+    			__WFI();
     		}
-    		// O valor pego aqui será de 12 bits: 0 à 4095
-    		PRINTF("ADC Value %c: %d\r\n", axis, ADC16_GetChannelConversionValue(ADC0, ADC_GROUP_A));
-    		ADC16_SetChannelMuxMode(ADC0, kADC16_ChannelMuxB);
-    		axis = 'Y';
-    	}
+    		EnableGlobalIRQ(primask);
+    	} while (busy);
+    	AdcScan_GetLatest(axes);
+    	// A referência é medida de novo a cada 16 varreduras, com o ADC parado.
+    	AdcMeasure_Update();
+    	AdcMeasure_GetReference(&reference);
+    	// Os valores serão de 12 bits: 0 à 4095
+    	PRINTF("ADC Value X: %d (%u mV)\r\n", axes[0], AdcMeasure_ToMillivolts(axes[0]));
+    	PRINTF("ADC Value Y: %d (%u mV)\r\n", axes[1], AdcMeasure_ToMillivolts(axes[1]));
+    	PRINTF("VDDA: %u mV, Temperature: %d mC\r\n", reference.vdda_mV, reference.temperature_mC);
     	PRINTF("\n");
     	Delay_Waitms(300);
     }
@@ -0,0 +1,313 @@
+/**
+ * @file	adc_cal.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * ADC16 calibration cache in flash.
+ *
+ * The record is read straight from the memory mapped flash; only the
+ * erase and program commands go through the fsl_flash driver, whose
+ * command launch runs from RAM.
+ *
+ * The CLPD to CLP0 and CLMD to CLM0 registers are consecutive in the
+ * ADC16 map, so they are copied as two arrays.
+ *
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "adc_cal.h"
+#include "fsl_flash.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define ADC_CAL_MAGIC   0x4C414341U /*!< "ACAL".*/
+#define ADC_CAL_VERSION 1U
+
+#define ADC_CAL_CLP_COUNT 7U /*!< CLPD, CLPS, CLP4 to CLP0 (and the same for CLMx).*/
+
+#define ADC_CAL_FLAG_TAG (1U << 0) /*!< The record has the conditions tag.*/
+
+/*!< Flash record, a multiple of the program unit (4 bytes).*/
+typedef struct{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t flags;
+	uint32_t config;          /*!< ADC configuration of the calibration.*/
+	int32_t temperature_mC;
+	uint16_t vdda_mV;
+	uint16_t ofs;
+	uint16_t pg;
+	uint16_t mg;
+	uint16_t clp[ADC_CAL_CLP_COUNT];
+	uint16_t clm[ADC_CAL_CLP_COUNT];
+	uint16_t reserved;
+	uint16_t crc;             /*!< CRC-16/CCITT of the fields above.*/
+}adcCalRecord_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Initializes the flash driver, once; fails if the image reaches
+ *        the record sector.
+ *
+ */
+static status_t FlashInit(void);
+
+/**
+ * @brief Packs the ADC settings that change the calibration: CFG1, the
+ *        high speed and long sample bits of CFG2, the averaging and the
+ *        voltage reference.
+ *
+ */
+static uint32_t GetConfigKey(ADC_Type *base);
+
+/**
+ * @brief Computes the CRC-16/CCITT of the record, except the CRC itself.
+ *
+ */
+static uint16_t RecordCrc(const adcCalRecord_t *record);
+
+/**
+ * @brief Tests if |a - b| > tolerance.
+ *
+ */
+static inline bool OutOfTolerance(int32_t a, int32_t b, uint32_t tolerance);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*!< End of the image in flash, defined by the linker script.*/
+extern uint8_t _image_end[];
+
+static flash_config_t s_flash;
+static bool s_flashReady = false;
+
+/*!< CRC-16/CCITT of each nibble.*/
+static const uint16_t s_crcTable[16] = {
+	0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+	0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU,
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static status_t FlashInit(void)
+{
+	status_t status;
+
+	if(s_flashReady)
+	{
+		return kStatus_Success;
+	}
+
+	/* The sector is reserved in the project memory map; if the map or the
+	 * address is changed, the erase must not reach the code. */
+	if((uint32_t)_image_end > ADC_CAL_FLASH_ADDRESS)
+	{
+		return kStatus_OutOfRange;
+	}
+
+	memset(&s_flash, 0, sizeof(s_flash));
+	status = FLASH_Init(&s_flash);
+#if FLASH_DRIVER_IS_FLASH_RESIDENT
+	if(status == kStatus_Success)
+	{
+		status = FLASH_PrepareExecuteInRamFunctions(&s_flash);
+	}
+#endif
+	s_flashReady = (status == kStatus_Success);
+
+	return status;
+}
+
+static uint32_t GetConfigKey(ADC_Type *base)
+{
+	uint32_t key;
+
+	key = base->CFG1 & 0xFFU;
+	key |= (base->CFG2 & (ADC_CFG2_ADHSC_MASK | ADC_CFG2_ADLSTS_MASK)) << 8U;
+	key |= (base->SC3 & (ADC_SC3_AVGE_MASK | ADC_SC3_AVGS_MASK)) << 16U;
+	key |= (base->SC2 & ADC_SC2_REFSEL_MASK) << 24U;
+
+	return key;
+}
+
+static uint16_t RecordCrc(const adcCalRecord_t *record)
+{
+	const uint8_t *data = (const uint8_t *)record;
+	size_t length = offsetof(adcCalRecord_t, crc);
+	uint16_t crc = 0xFFFFU;
+
+	while(length--)
+	{
+		crc = (uint16_t)(crc << 4U) ^ s_crcTable[(crc >> 12U) ^ (*data >> 4U)];
+		crc = (uint16_t)(crc << 4U) ^ s_crcTable[(crc >> 12U) ^ (*data & 0x0FU)];
+		data++;
+	}
+
+	return crc;
+}
+
+static inline bool OutOfTolerance(int32_t a, int32_t b, uint32_t tolerance)
+{
+	uint32_t difference = (a > b) ? (uint32_t)(a - b) : (uint32_t)(b - a);
+
+	return difference > tolerance;
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t AdcCal_Load(ADC_Type *base, const adcCalTag_t *tag, const adcCalTag_t *tolerance)
+{
+	const adcCalRecord_t *record = (const adcCalRecord_t *)ADC_CAL_FLASH_ADDRESS;
+	volatile uint32_t *clp = &base->CLPD;
+	volatile uint32_t *clm = &base->CLMD;
+	uint32_t i;
+
+	if((record->magic != ADC_CAL_MAGIC) || (record->version != ADC_CAL_VERSION) ||
+	   (record->crc != RecordCrc(record)) || (record->config != GetConfigKey(base)))
+	{
+		return kStatus_AdcCal_Invalid;
+	}
+
+	if(tolerance != NULL)
+	{
+		/* Unknown conditions can not be compared. */
+		if((tag == NULL) || ((record->flags & ADC_CAL_FLAG_TAG) == 0U) ||
+		   OutOfTolerance(tag->temperature_mC, record->temperature_mC, (uint32_t)tolerance->temperature_mC) ||
+		   OutOfTolerance(tag->vdda_mV, record->vdda_mV, tolerance->vdda_mV))
+		{
+			return kStatus_AdcCal_Stale;
+		}
+	}
+
+	base->OFS = record->ofs;
+	base->PG = record->pg;
+	base->MG = record->mg;
+	for(i = 0U; i < ADC_CAL_CLP_COUNT; i++)
+	{
+		clp[i] = record->clp[i];
+		clm[i] = record->clm[i];
+	}
+
+	return kStatus_Success;
+}
+
+status_t AdcCal_Save(ADC_Type *base, const adcCalTag_t *tag)
+{
+	adcCalRecord_t record;
+	volatile uint32_t *clp = &base->CLPD;
+	volatile uint32_t *clm = &base->CLMD;
+	status_t status;
+	uint32_t primask;
+	uint32_t i;
+
+	memset(&record, 0, sizeof(record));
+	record.magic = ADC_CAL_MAGIC;
+	record.version = ADC_CAL_VERSION;
+	record.config = GetConfigKey(base);
+	if(tag != NULL)
+	{
+		record.flags = ADC_CAL_FLAG_TAG;
+		record.temperature_mC = tag->temperature_mC;
+		record.vdda_mV = tag->vdda_mV;
+	}
+	record.ofs = (uint16_t)base->OFS;
+	record.pg = (uint16_t)base->PG;
+	record.mg = (uint16_t)base->MG;
+	for(i = 0U; i < ADC_CAL_CLP_COUNT; i++)
+	{
+		record.clp[i] = (uint16_t)clp[i];
+		record.clm[i] = (uint16_t)clm[i];
+	}
+	record.crc = RecordCrc(&record);
+
+	/* Saves an erase cycle when booting with the same calibration. */
+	if(memcmp(&record, (const void *)ADC_CAL_FLASH_ADDRESS, sizeof(record)) == 0)
+	{
+		return kStatus_Success;
+	}
+
+	status = FlashInit();
+	if(status != kStatus_Success)
+	{
+		return status;
+	}
+
+	primask = DisableGlobalIRQ();
+	status = FLASH_Erase(&s_flash, ADC_CAL_FLASH_ADDRESS, FSL_FEATURE_FLASH_PFLASH_BLOCK_SECTOR_SIZE,
+	                     kFLASH_ApiEraseKey);
+	if(status == kStatus_Success)
+	{
+		status = FLASH_Program(&s_flash, ADC_CAL_FLASH_ADDRESS, (uint32_t *)&record, sizeof(record));
+	}
+	EnableGlobalIRQ(primask);
+
+	return status;
+}
+
+status_t AdcCal_Restore(ADC_Type *base, const adcCalTag_t *tag, const adcCalTag_t *tolerance, adcCalSource_t *source)
+{
+	adcCalSource_t origin = kAdcCal_FromFlash;
+
+	if(AdcCal_Load(base, tag, tolerance) != kStatus_Success)
+	{
+		/* The driver suspends the hardware trigger during the calibration. */
+		if(ADC16_DoAutoCalibration(base) != kStatus_Success)
+		{
+			return kStatus_Fail;
+		}
+		origin = (AdcCal_Save(base, tag) == kStatus_Success) ? kAdcCal_Calibrated : kAdcCal_NotSaved;
+	}
+
+	if(source != NULL)
+	{
+		*source = origin;
+	}
+
+	return kStatus_Success;
+}
+
+status_t AdcCal_Invalidate(void)
+{
+	status_t status;
+	uint32_t primask;
+
+	status = FlashInit();
+	if(status != kStatus_Success)
+	{
+		return status;
+	}
+
+	primask = DisableGlobalIRQ();
+	status = FLASH_Erase(&s_flash, ADC_CAL_FLASH_ADDRESS, FSL_FEATURE_FLASH_PFLASH_BLOCK_SECTOR_SIZE,
+	                     kFLASH_ApiEraseKey);
+	EnableGlobalIRQ(primask);
+
+	return status;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file	adc_cal.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * ADC16 calibration cache in flash.
+ *
+ * ADC16_DoAutoCalibration() takes some milliseconds before the first
+ * sample. Its results (OFS, PG, MG and the CLPx/CLMx registers) are
+ * stored in a flash sector, with a CRC, the ADC configuration they were
+ * measured with and a tag of the temperature and VDDA of that moment.
+ * In the next boots they are written back in the registers in some
+ * microseconds, and the calibration runs again only when:
+ *
+ *   - the record is missing or corrupted (magic, version or CRC);
+ *   - the ADC configuration (clock, mode, sample time, averaging) changed;
+ *   - the temperature or VDDA moved away from the tag more than the
+ *     given tolerance (stale calibration).
+ *
+ * The sector is given by ADC_CAL_FLASH_ADDRESS, by default the last one,
+ * and must not be used by the linker for code or data: the project memory
+ * map ends PROGRAM_FLASH one sector before it (127 KB), and the record is
+ * neither erased nor written if the image end (_image_end) reaches it.
+ *
+ * The interrupts are disabled while the sector is erased and programmed,
+ * since the flash can not be read meanwhile.
+ *
+ */
+
+#ifndef ADC_CAL_H_
+#define ADC_CAL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "fsl_adc16.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup adc_cal
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Flash sector of the record.*/
+#ifndef ADC_CAL_FLASH_ADDRESS
+#define ADC_CAL_FLASH_ADDRESS (FSL_FEATURE_FLASH_PFLASH_BLOCK_COUNT * FSL_FEATURE_FLASH_PFLASH_BLOCK_SIZE - \
+                               FSL_FEATURE_FLASH_PFLASH_BLOCK_SECTOR_SIZE)
+#endif
+
+/*!< Status codes.*/
+enum _adc_cal_status{
+	kStatus_AdcCal_Invalid = MAKE_STATUS(kStatusGroup_ApplicationRangeStart, 0), /*!< No valid record, or
+	                                                                                   for another configuration.*/
+	kStatus_AdcCal_Stale = MAKE_STATUS(kStatusGroup_ApplicationRangeStart, 1),   /*!< Valid record, but the
+	                                                                                   conditions changed.*/
+};
+
+/*!
+ * @brief Conditions of a calibration.
+ */
+typedef struct{
+	int32_t temperature_mC; /*!< Chip temperature, in milli degrees Celsius.*/
+	uint16_t vdda_mV;       /*!< Analog supply, in millivolts.*/
+}adcCalTag_t;
+
+/*!< How the calibration was obtained by AdcCal_Restore().*/
+typedef enum{
+	kAdcCal_FromFlash = 0U,  /*!< Loaded from the record.*/
+	kAdcCal_Calibrated,      /*!< Calibrated and saved.*/
+	kAdcCal_NotSaved,        /*!< Calibrated, but the record could not be written.*/
+}adcCalSource_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Loads the calibration from flash into the ADC registers.
+ *
+ *        The ADC must be initialized with its final configuration, since
+ *        the record is only accepted for the same one.
+ *
+ * @param base      - ADC peripheral base address.
+ * @param tag       - the current conditions, can be NULL if unknown.
+ * @param tolerance - the maximum difference from the recorded conditions;
+ *                    NULL to ignore them.
+ *
+ * @return kStatus_Success if loaded;
+ *         kStatus_AdcCal_Invalid if there is no valid record;
+ *         kStatus_AdcCal_Stale if the conditions are out of the tolerance
+ *         (the registers are not written).
+ *
+ */
+status_t AdcCal_Load(ADC_Type *base, const adcCalTag_t *tag, const adcCalTag_t *tolerance);
+
+/**
+ * @brief Stores the current calibration registers in flash.
+ *
+ *        Must be called after a successful ADC16_DoAutoCalibration().
+ *        Nothing is written if the record is already equal.
+ *
+ * @param base - ADC peripheral base address.
+ * @param tag  - the conditions of the calibration, can be NULL if unknown.
+ *
+ * @return kStatus_Success if stored;
+ *         kStatus_OutOfRange if the image reaches the record sector;
+ *         or an fsl_flash error code.
+ *
+ */
+status_t AdcCal_Save(ADC_Type *base, const adcCalTag_t *tag);
+
+/**
+ * @brief Loads the calibration, or calibrates and saves it when the record
+ *        is invalid or stale. Replaces ADC16_DoAutoCalibration() at boot.
+ *
+ *        The calibration works with the hardware trigger enabled, which is
+ *        suspended meanwhile.
+ *
+ * @param base      - ADC peripheral base address.
+ * @param tag       - the current conditions, can be NULL if unknown.
+ * @param tolerance - the maximum difference from the recorded conditions;
+ *                    NULL to ignore them.
+ * @param source    - where the origin of the calibration is stored, can be NULL.
+ *
+ * @return kStatus_Success if the ADC is calibrated (even if not saved);
+ *         kStatus_Fail if the calibration failed.
+ *
+ */
+status_t AdcCal_Restore(ADC_Type *base, const adcCalTag_t *tag, const adcCalTag_t *tolerance, adcCalSource_t *source);
+
+/**
+ * @brief Erases the record, forcing a calibration in the next restore.
+ *
+ * @return kStatus_Success if erased;
+ *         kStatus_OutOfRange if the image reaches the record sector;
+ *         or an fsl_flash error code.
+ *
+ */
+status_t AdcCal_Invalidate(void);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* ADC_CAL_H_ */
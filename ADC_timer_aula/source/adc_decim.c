@@ -0,0 +1,245 @@
+/**
+ * @file	adc_decim.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Oversampling and decimation for extra ADC effective bits.
+ *
+ */
+
+#include "adc_decim.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define ADC_DECIM_MAX_TARGET_BITS 20U
+#define ADC_DECIM_MAX_DECIMATION 4096U
+#define ADC_DECIM_CIC2_MIN_DECIMATION 8U /*!< From here the plan uses a CIC of order 2.*/
+#define ADC_DECIM_ACCUMULATOR_BITS 32U
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Returns log2 of a power of two.
+ *
+ */
+static inline uint8_t Log2(uint32_t x)
+{
+	uint8_t n = 0U;
+
+	while(x > 1U)
+	{
+		x >>= 1U;
+		n++;
+	}
+
+	return n;
+}
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+status_t AdcDecim_Plan(uint32_t outputRate_Hz,
+                       uint8_t targetBits,
+                       uint8_t inputBits,
+                       uint8_t adcEffectiveBits,
+                       uint32_t maxConversionRate_Hz,
+                       adcDecimPlan_t *plan)
+{
+	/* Hardware averaging counts, from the highest, and their register values. */
+	static const uint8_t hwCounts[] = {32U, 16U, 8U, 4U};
+	static const adc16_hardware_average_mode_t hwModes[] = {kADC16_HardwareAverageCount32,
+	                                                        kADC16_HardwareAverageCount16,
+	                                                        kADC16_HardwareAverageCount8,
+	                                                        kADC16_HardwareAverageCount4};
+	uint32_t extraBits, ratio, hwRatio, hwMaxRatio, i;
+	uint64_t rate;
+
+	if((plan == NULL) || (outputRate_Hz == 0U) || (targetBits == 0U) || (targetBits > ADC_DECIM_MAX_TARGET_BITS) ||
+	   ((inputBits != 8U) && (inputBits != 10U) && (inputBits != 12U) && (inputBits != 16U)) ||
+	   (adcEffectiveBits == 0U) || (adcEffectiveBits > inputBits))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	/* One extra bit for each 4 times more samples. */
+	extraBits = (targetBits > adcEffectiveBits) ? (uint32_t)(targetBits - adcEffectiveBits) : 0U;
+	if(extraBits > Log2(ADC_DECIM_MAX_DECIMATION * 32U) / 2U)
+	{
+		/* More than the hardware and software ratios together (4^8). */
+		return kStatus_InvalidArgument;
+	}
+	ratio = 1UL << (2U * extraBits);
+
+	/* The hardware average is truncated to the result width, so it only
+	 * gives the bits between the effective bits and the result width. */
+	hwMaxRatio = 1UL << (2U * (inputBits - adcEffectiveBits));
+	if(hwMaxRatio > ratio)
+	{
+		hwMaxRatio = ratio;
+	}
+
+	plan->hardwareAverage = kADC16_HardwareAverageDisabled;
+	hwRatio = 1U;
+	for(i = 0U; i < ARRAY_SIZE(hwCounts); i++)
+	{
+		if(hwCounts[i] <= hwMaxRatio)
+		{
+			plan->hardwareAverage = hwModes[i];
+			hwRatio = hwCounts[i];
+			break;
+		}
+	}
+
+	if((ratio / hwRatio) > ADC_DECIM_MAX_DECIMATION)
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	plan->decimation = (uint16_t)(ratio / hwRatio);
+	plan->order = (plan->decimation >= ADC_DECIM_CIC2_MIN_DECIMATION) ? 2U : 1U;
+	if((uint32_t)(inputBits + plan->order * Log2(plan->decimation)) > ADC_DECIM_ACCUMULATOR_BITS)
+	{
+		plan->order = 1U;
+	}
+	plan->inputBits = inputBits;
+	plan->outputBits = targetBits;
+	plan->effectiveBits = adcEffectiveBits + (uint8_t)extraBits;
+
+	rate = (uint64_t)outputRate_Hz * plan->decimation;
+	plan->resultRate_Hz = (rate > UINT32_MAX) ? UINT32_MAX : (uint32_t)rate;
+	rate *= hwRatio;
+	plan->conversionRate_Hz = (rate > UINT32_MAX) ? UINT32_MAX : (uint32_t)rate;
+
+	return (rate <= maxConversionRate_Hz) ? kStatus_Success : kStatus_OutOfRange;
+}
+
+status_t AdcDecim_Init(adcDecim_t *decim, const adcDecimPlan_t *plan)
+{
+	uint32_t cicBits;
+
+	if((decim == NULL) || (plan == NULL) || (plan->order == 0U) || (plan->order > ADC_DECIM_MAX_ORDER) ||
+	   (plan->decimation == 0U) || (plan->decimation > ADC_DECIM_MAX_DECIMATION) ||
+	   (plan->decimation & (plan->decimation - 1U)))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	/* The CIC gain is decimation^order. */
+	cicBits = plan->inputBits + plan->order * Log2(plan->decimation);
+	if(cicBits > ADC_DECIM_ACCUMULATOR_BITS)
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	memset(decim, 0, sizeof(*decim));
+	decim->decimation = plan->decimation;
+	decim->order = plan->order;
+	if(cicBits >= plan->outputBits)
+	{
+		decim->shift = (uint8_t)(cicBits - plan->outputBits);
+	}
+	else
+	{
+		decim->leftShift = (uint8_t)(plan->outputBits - cicBits);
+	}
+
+	return kStatus_Success;
+}
+
+size_t AdcDecim_Process(adcDecim_t *decim, const uint16_t *input, size_t count, uint32_t *output)
+{
+	uint32_t i1 = decim->integrators[0];
+	uint32_t i2 = decim->integrators[1];
+	uint32_t i3 = decim->integrators[2];
+	uint32_t c, t;
+	uint16_t phase = decim->phase;
+	size_t outputs = 0U;
+
+	/* One loop per order, so the integrators stay in registers and there
+	 * is no test of the order per sample. The unsigned overflow of the
+	 * integrators is cancelled by the combs. */
+	switch(decim->order)
+	{
+	case 1U:
+		while(count--)
+		{
+			i1 += *input++;
+			if(++phase == decim->decimation)
+			{
+				phase = 0U;
+				c = i1 - decim->delays[0];
+				decim->delays[0] = i1;
+				output[outputs++] = (c >> decim->shift) << decim->leftShift;
+			}
+		}
+		break;
+
+	case 2U:
+		while(count--)
+		{
+			i1 += *input++;
+			i2 += i1;
+			if(++phase == decim->decimation)
+			{
+				phase = 0U;
+				c = i2 - decim->delays[0];
+				decim->delays[0] = i2;
+				t = c;
+				c = c - decim->delays[1];
+				decim->delays[1] = t;
+				output[outputs++] = (c >> decim->shift) << decim->leftShift;
+			}
+		}
+		break;
+
+	default:
+		while(count--)
+		{
+			i1 += *input++;
+			i2 += i1;
+			i3 += i2;
+			if(++phase == decim->decimation)
+			{
+				phase = 0U;
+				c = i3 - decim->delays[0];
+				decim->delays[0] = i3;
+				t = c;
+				c = c - decim->delays[1];
+				decim->delays[1] = t;
+				t = c;
+				c = c - decim->delays[2];
+				decim->delays[2] = t;
+				output[outputs++] = (c >> decim->shift) << decim->leftShift;
+			}
+		}
+		break;
+	}
+
+	decim->integrators[0] = i1;
+	decim->integrators[1] = i2;
+	decim->integrators[2] = i3;
+	decim->phase = phase;
+
+	return outputs;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file	adc_decim.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Oversampling and decimation for extra ADC effective bits.
+ *
+ * With white noise of about one LSB in the input, each 4 times more
+ * samples averaged give one more effective bit. The total oversampling
+ * ratio is split in two stages:
+ *
+ *   - the ADC16 hardware averaging (4, 8, 16 or 32 conversions per
+ *     result), that costs no CPU;
+ *   - a software decimator over the streamed results (e.g. the adc_stream
+ *     buffers): a sum-and-shift (CIC of order 1) or a CIC of order 2 or 3,
+ *     that rejects better the noise folded back by the decimation.
+ *
+ * AdcDecim_Plan() chooses the split for a target output rate and
+ * resolution: the hardware takes as much as possible of the ratio, and
+ * the software does the rest.
+ *
+ * The CIC uses 32 bits integer arithmetic, where the wrap around of the
+ * integrators is cancelled by the combs, so it needs
+ * inputBits + order * log2(decimation) <= 32.
+ *
+ */
+
+#ifndef ADC_DECIM_H_
+#define ADC_DECIM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "fsl_adc16.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup adc_decim
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Maximum CIC order.*/
+#define ADC_DECIM_MAX_ORDER 3U
+
+/*!
+ * @brief Hardware/software split of the oversampling.
+ */
+typedef struct{
+	adc16_hardware_average_mode_t hardwareAverage; /*!< ADC16 averaging.*/
+	uint16_t decimation;          /*!< Software decimation ratio (power of two, 1 to 4096).*/
+	uint8_t order;                /*!< CIC order: 1 (sum-and-shift), 2 or 3.*/
+	uint8_t inputBits;            /*!< ADC result width (8, 10, 12 or 16).*/
+	uint8_t outputBits;           /*!< Output width.*/
+	uint8_t effectiveBits;        /*!< Expected effective bits.*/
+	uint32_t resultRate_Hz;       /*!< ADC results rate (after the hardware averaging).*/
+	uint32_t conversionRate_Hz;   /*!< ADC conversions rate.*/
+}adcDecimPlan_t;
+
+/*!
+ * @brief Decimator state. The fields are internal.
+ */
+typedef struct{
+	uint32_t integrators[ADC_DECIM_MAX_ORDER];
+	uint32_t delays[ADC_DECIM_MAX_ORDER];
+	uint16_t decimation;
+	uint16_t phase;
+	uint8_t order;
+	uint8_t shift;     /*!< Right shift of the output.*/
+	uint8_t leftShift; /*!< Left shift of the output, if it is wider than the CIC.*/
+}adcDecim_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Splits the oversampling between the hardware and the software.
+ *
+ * @param outputRate_Hz     - the desired output rate.
+ * @param targetBits        - the desired effective bits (up to 20).
+ * @param inputBits         - the ADC result width (8, 10, 12 or 16).
+ * @param adcEffectiveBits  - the effective bits of one conversion, e.g.
+ *                            12 with the 16 bits mode.
+ * @param maxConversionRate_Hz - the ADC conversions rate limit, given by
+ *                            the ADC clock and sample time.
+ * @param plan              - where the result is stored.
+ *
+ * @return kStatus_Success if the target is reachable;
+ *         kStatus_OutOfRange if it needs more conversions than the limit
+ *         (the plan holds the required rates);
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t AdcDecim_Plan(uint32_t outputRate_Hz,
+                       uint8_t targetBits,
+                       uint8_t inputBits,
+                       uint8_t adcEffectiveBits,
+                       uint32_t maxConversionRate_Hz,
+                       adcDecimPlan_t *plan);
+
+/**
+ * @brief Writes the hardware averaging of the plan in the ADC.
+ *
+ * @param base - ADC peripheral base address.
+ * @param plan - the plan.
+ *
+ */
+static inline void AdcDecim_ApplyHardwareAverage(ADC_Type *base, const adcDecimPlan_t *plan)
+{
+	ADC16_SetHardwareAverage(base, plan->hardwareAverage);
+}
+
+/**
+ * @brief Initializes the software decimator.
+ *
+ * @param decim - the decimator state.
+ * @param plan  - the plan, from AdcDecim_Plan() or filled by the caller.
+ *
+ * @return kStatus_Success if initialized;
+ *         kStatus_InvalidArgument if the plan does not fit in 32 bits.
+ *
+ */
+status_t AdcDecim_Init(adcDecim_t *decim, const adcDecimPlan_t *plan);
+
+/**
+ * @brief Decimates a block of ADC results.
+ *
+ *        The block size does not need to be a multiple of the decimation,
+ *        the state continues in the next call.
+ *
+ * @param decim  - the decimator state.
+ * @param input  - the ADC results.
+ * @param count  - the number of results.
+ * @param output - where the outputs are stored, with room for
+ *                 count / decimation + 1 values.
+ *
+ * @return The number of outputs.
+ *
+ */
+size_t AdcDecim_Process(adcDecim_t *decim, const uint16_t *input, size_t count, uint32_t *output);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* ADC_DECIM_H_ */
@@ -0,0 +1,430 @@
+/**
+ * @file	adc_fft.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Q15 radix-2 FFT and spectrum analysis of ADC sample blocks.
+ *
+ * The butterflies compute (a + W b) / 2 and (a - W b) / 2. The complex
+ * magnitude of the values never grows, so with |x| <= 32767 at the input
+ * no saturation is needed. The first stage has W = 1 and is done without
+ * multiplications; the others loop over the twiddle factors outside, so
+ * each factor is read from the table once per stage.
+ *
+ * The tables are for 1024 points; smaller transforms use a stride in the
+ * sine table and shift the 10 bits reversed indexes.
+ *
+ */
+
+#include "adc_fft.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define ADC_FFT_TABLE_LOG2 10U                          /*!< Tables for 1024 points.*/
+#define ADC_FFT_QUARTER    (ADC_FFT_MAX_POINTS / 4U)    /*!< Index of pi/2.*/
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief sin(2 pi k / 1024) in q15, for k from 0 to 512.
+ *
+ */
+static inline q31_t Sine(uint32_t k);
+
+/**
+ * @brief cos(2 pi k / 1024) in q15, for k from 0 to 512.
+ *
+ */
+static inline q31_t Cosine(uint32_t k);
+
+/**
+ * @brief Approximates sqrt(re^2 + im^2).
+ *
+ */
+static inline uint16_t Magnitude(q31_t re, q31_t im);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*!< 32767 sin(2 pi k / 1024), from k = 0 to 256.*/
+static const q15_t s_sine[ADC_FFT_QUARTER + 1U] = {
+	0, 201, 402, 603, 804, 1005, 1206, 1407,
+	1608, 1809, 2009, 2210, 2410, 2611, 2811, 3012,
+	3212, 3412, 3612, 3811, 4011, 4210, 4410, 4609,
+	4808, 5007, 5205, 5404, 5602, 5800, 5998, 6195,
+	6393, 6590, 6786, 6983, 7179, 7375, 7571, 7767,
+	7962, 8157, 8351, 8545, 8739, 8933, 9126, 9319,
+	9512, 9704, 9896, 10087, 10278, 10469, 10659, 10849,
+	11039, 11228, 11417, 11605, 11793, 11980, 12167, 12353,
+	12539, 12725, 12910, 13094, 13279, 13462, 13645, 13828,
+	14010, 14191, 14372, 14553, 14732, 14912, 15090, 15269,
+	15446, 15623, 15800, 15976, 16151, 16325, 16499, 16673,
+	16846, 17018, 17189, 17360, 17530, 17700, 17869, 18037,
+	18204, 18371, 18537, 18703, 18868, 19032, 19195, 19357,
+	19519, 19680, 19841, 20000, 20159, 20317, 20475, 20631,
+	20787, 20942, 21096, 21250, 21403, 21554, 21705, 21856,
+	22005, 22154, 22301, 22448, 22594, 22739, 22884, 23027,
+	23170, 23311, 23452, 23592, 23731, 23870, 24007, 24143,
+	24279, 24413, 24547, 24680, 24811, 24942, 25072, 25201,
+	25329, 25456, 25582, 25708, 25832, 25955, 26077, 26198,
+	26319, 26438, 26556, 26674, 26790, 26905, 27019, 27133,
+	27245, 27356, 27466, 27575, 27683, 27790, 27896, 28001,
+	28105, 28208, 28310, 28411, 28510, 28609, 28706, 28803,
+	28898, 28992, 29085, 29177, 29268, 29358, 29447, 29534,
+	29621, 29706, 29791, 29874, 29956, 30037, 30117, 30195,
+	30273, 30349, 30424, 30498, 30571, 30643, 30714, 30783,
+	30852, 30919, 30985, 31050, 31113, 31176, 31237, 31297,
+	31356, 31414, 31470, 31526, 31580, 31633, 31685, 31736,
+	31785, 31833, 31880, 31926, 31971, 32014, 32057, 32098,
+	32137, 32176, 32213, 32250, 32285, 32318, 32351, 32382,
+	32412, 32441, 32469, 32495, 32521, 32545, 32567, 32589,
+	32609, 32628, 32646, 32663, 32678, 32692, 32705, 32717,
+	32728, 32737, 32745, 32752, 32757, 32761, 32765, 32766,
+	32767
+};
+
+/*!< 10 bits reversal of k.*/
+static const uint16_t s_bitReverse[ADC_FFT_MAX_POINTS] = {
+	0U, 512U, 256U, 768U, 128U, 640U, 384U, 896U, 64U, 576U, 320U, 832U, 192U, 704U, 448U, 960U,
+	32U, 544U, 288U, 800U, 160U, 672U, 416U, 928U, 96U, 608U, 352U, 864U, 224U, 736U, 480U, 992U,
+	16U, 528U, 272U, 784U, 144U, 656U, 400U, 912U, 80U, 592U, 336U, 848U, 208U, 720U, 464U, 976U,
+	48U, 560U, 304U, 816U, 176U, 688U, 432U, 944U, 112U, 624U, 368U, 880U, 240U, 752U, 496U, 1008U,
+	8U, 520U, 264U, 776U, 136U, 648U, 392U, 904U, 72U, 584U, 328U, 840U, 200U, 712U, 456U, 968U,
+	40U, 552U, 296U, 808U, 168U, 680U, 424U, 936U, 104U, 616U, 360U, 872U, 232U, 744U, 488U, 1000U,
+	24U, 536U, 280U, 792U, 152U, 664U, 408U, 920U, 88U, 600U, 344U, 856U, 216U, 728U, 472U, 984U,
+	56U, 568U, 312U, 824U, 184U, 696U, 440U, 952U, 120U, 632U, 376U, 888U, 248U, 760U, 504U, 1016U,
+	4U, 516U, 260U, 772U, 132U, 644U, 388U, 900U, 68U, 580U, 324U, 836U, 196U, 708U, 452U, 964U,
+	36U, 548U, 292U, 804U, 164U, 676U, 420U, 932U, 100U, 612U, 356U, 868U, 228U, 740U, 484U, 996U,
+	20U, 532U, 276U, 788U, 148U, 660U, 404U, 916U, 84U, 596U, 340U, 852U, 212U, 724U, 468U, 980U,
+	52U, 564U, 308U, 820U, 180U, 692U, 436U, 948U, 116U, 628U, 372U, 884U, 244U, 756U, 500U, 1012U,
+	12U, 524U, 268U, 780U, 140U, 652U, 396U, 908U, 76U, 588U, 332U, 844U, 204U, 716U, 460U, 972U,
+	44U, 556U, 300U, 812U, 172U, 684U, 428U, 940U, 108U, 620U, 364U, 876U, 236U, 748U, 492U, 1004U,
+	28U, 540U, 284U, 796U, 156U, 668U, 412U, 924U, 92U, 604U, 348U, 860U, 220U, 732U, 476U, 988U,
+	60U, 572U, 316U, 828U, 188U, 700U, 444U, 956U, 124U, 636U, 380U, 892U, 252U, 764U, 508U, 1020U,
+	2U, 514U, 258U, 770U, 130U, 642U, 386U, 898U, 66U, 578U, 322U, 834U, 194U, 706U, 450U, 962U,
+	34U, 546U, 290U, 802U, 162U, 674U, 418U, 930U, 98U, 610U, 354U, 866U, 226U, 738U, 482U, 994U,
+	18U, 530U, 274U, 786U, 146U, 658U, 402U, 914U, 82U, 594U, 338U, 850U, 210U, 722U, 466U, 978U,
+	50U, 562U, 306U, 818U, 178U, 690U, 434U, 946U, 114U, 626U, 370U, 882U, 242U, 754U, 498U, 1010U,
+	10U, 522U, 266U, 778U, 138U, 650U, 394U, 906U, 74U, 586U, 330U, 842U, 202U, 714U, 458U, 970U,
+	42U, 554U, 298U, 810U, 170U, 682U, 426U, 938U, 106U, 618U, 362U, 874U, 234U, 746U, 490U, 1002U,
+	26U, 538U, 282U, 794U, 154U, 666U, 410U, 922U, 90U, 602U, 346U, 858U, 218U, 730U, 474U, 986U,
+	58U, 570U, 314U, 826U, 186U, 698U, 442U, 954U, 122U, 634U, 378U, 890U, 250U, 762U, 506U, 1018U,
+	6U, 518U, 262U, 774U, 134U, 646U, 390U, 902U, 70U, 582U, 326U, 838U, 198U, 710U, 454U, 966U,
+	38U, 550U, 294U, 806U, 166U, 678U, 422U, 934U, 102U, 614U, 358U, 870U, 230U, 742U, 486U, 998U,
+	22U, 534U, 278U, 790U, 150U, 662U, 406U, 918U, 86U, 598U, 342U, 854U, 214U, 726U, 470U, 982U,
+	54U, 566U, 310U, 822U, 182U, 694U, 438U, 950U, 118U, 630U, 374U, 886U, 246U, 758U, 502U, 1014U,
+	14U, 526U, 270U, 782U, 142U, 654U, 398U, 910U, 78U, 590U, 334U, 846U, 206U, 718U, 462U, 974U,
+	46U, 558U, 302U, 814U, 174U, 686U, 430U, 942U, 110U, 622U, 366U, 878U, 238U, 750U, 494U, 1006U,
+	30U, 542U, 286U, 798U, 158U, 670U, 414U, 926U, 94U, 606U, 350U, 862U, 222U, 734U, 478U, 990U,
+	62U, 574U, 318U, 830U, 190U, 702U, 446U, 958U, 126U, 638U, 382U, 894U, 254U, 766U, 510U, 1022U,
+	1U, 513U, 257U, 769U, 129U, 641U, 385U, 897U, 65U, 577U, 321U, 833U, 193U, 705U, 449U, 961U,
+	33U, 545U, 289U, 801U, 161U, 673U, 417U, 929U, 97U, 609U, 353U, 865U, 225U, 737U, 481U, 993U,
+	17U, 529U, 273U, 785U, 145U, 657U, 401U, 913U, 81U, 593U, 337U, 849U, 209U, 721U, 465U, 977U,
+	49U, 561U, 305U, 817U, 177U, 689U, 433U, 945U, 113U, 625U, 369U, 881U, 241U, 753U, 497U, 1009U,
+	9U, 521U, 265U, 777U, 137U, 649U, 393U, 905U, 73U, 585U, 329U, 841U, 201U, 713U, 457U, 969U,
+	41U, 553U, 297U, 809U, 169U, 681U, 425U, 937U, 105U, 617U, 361U, 873U, 233U, 745U, 489U, 1001U,
+	25U, 537U, 281U, 793U, 153U, 665U, 409U, 921U, 89U, 601U, 345U, 857U, 217U, 729U, 473U, 985U,
+	57U, 569U, 313U, 825U, 185U, 697U, 441U, 953U, 121U, 633U, 377U, 889U, 249U, 761U, 505U, 1017U,
+	5U, 517U, 261U, 773U, 133U, 645U, 389U, 901U, 69U, 581U, 325U, 837U, 197U, 709U, 453U, 965U,
+	37U, 549U, 293U, 805U, 165U, 677U, 421U, 933U, 101U, 613U, 357U, 869U, 229U, 741U, 485U, 997U,
+	21U, 533U, 277U, 789U, 149U, 661U, 405U, 917U, 85U, 597U, 341U, 853U, 213U, 725U, 469U, 981U,
+	53U, 565U, 309U, 821U, 181U, 693U, 437U, 949U, 117U, 629U, 373U, 885U, 245U, 757U, 501U, 1013U,
+	13U, 525U, 269U, 781U, 141U, 653U, 397U, 909U, 77U, 589U, 333U, 845U, 205U, 717U, 461U, 973U,
+	45U, 557U, 301U, 813U, 173U, 685U, 429U, 941U, 109U, 621U, 365U, 877U, 237U, 749U, 493U, 1005U,
+	29U, 541U, 285U, 797U, 157U, 669U, 413U, 925U, 93U, 605U, 349U, 861U, 221U, 733U, 477U, 989U,
+	61U, 573U, 317U, 829U, 189U, 701U, 445U, 957U, 125U, 637U, 381U, 893U, 253U, 765U, 509U, 1021U,
+	3U, 515U, 259U, 771U, 131U, 643U, 387U, 899U, 67U, 579U, 323U, 835U, 195U, 707U, 451U, 963U,
+	35U, 547U, 291U, 803U, 163U, 675U, 419U, 931U, 99U, 611U, 355U, 867U, 227U, 739U, 483U, 995U,
+	19U, 531U, 275U, 787U, 147U, 659U, 403U, 915U, 83U, 595U, 339U, 851U, 211U, 723U, 467U, 979U,
+	51U, 563U, 307U, 819U, 179U, 691U, 435U, 947U, 115U, 627U, 371U, 883U, 243U, 755U, 499U, 1011U,
+	11U, 523U, 267U, 779U, 139U, 651U, 395U, 907U, 75U, 587U, 331U, 843U, 203U, 715U, 459U, 971U,
+	43U, 555U, 299U, 811U, 171U, 683U, 427U, 939U, 107U, 619U, 363U, 875U, 235U, 747U, 491U, 1003U,
+	27U, 539U, 283U, 795U, 155U, 667U, 411U, 923U, 91U, 603U, 347U, 859U, 219U, 731U, 475U, 987U,
+	59U, 571U, 315U, 827U, 187U, 699U, 443U, 955U, 123U, 635U, 379U, 891U, 251U, 763U, 507U, 1019U,
+	7U, 519U, 263U, 775U, 135U, 647U, 391U, 903U, 71U, 583U, 327U, 839U, 199U, 711U, 455U, 967U,
+	39U, 551U, 295U, 807U, 167U, 679U, 423U, 935U, 103U, 615U, 359U, 871U, 231U, 743U, 487U, 999U,
+	23U, 535U, 279U, 791U, 151U, 663U, 407U, 919U, 87U, 599U, 343U, 855U, 215U, 727U, 471U, 983U,
+	55U, 567U, 311U, 823U, 183U, 695U, 439U, 951U, 119U, 631U, 375U, 887U, 247U, 759U, 503U, 1015U,
+	15U, 527U, 271U, 783U, 143U, 655U, 399U, 911U, 79U, 591U, 335U, 847U, 207U, 719U, 463U, 975U,
+	47U, 559U, 303U, 815U, 175U, 687U, 431U, 943U, 111U, 623U, 367U, 879U, 239U, 751U, 495U, 1007U,
+	31U, 543U, 287U, 799U, 159U, 671U, 415U, 927U, 95U, 607U, 351U, 863U, 223U, 735U, 479U, 991U,
+	63U, 575U, 319U, 831U, 191U, 703U, 447U, 959U, 127U, 639U, 383U, 895U, 255U, 767U, 511U, 1023U
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static inline q31_t Sine(uint32_t k)
+{
+	return (k <= ADC_FFT_QUARTER) ? s_sine[k] : s_sine[2U * ADC_FFT_QUARTER - k];
+}
+
+static inline q31_t Cosine(uint32_t k)
+{
+	return (k <= ADC_FFT_QUARTER) ? s_sine[ADC_FFT_QUARTER - k] : -s_sine[k - ADC_FFT_QUARTER];
+}
+
+static inline uint16_t Magnitude(q31_t re, q31_t im)
+{
+	uint32_t max = (uint32_t)((re < 0) ? -re : re);
+	uint32_t min = (uint32_t)((im < 0) ? -im : im);
+	uint32_t estimate;
+
+	if(min > max)
+	{
+		estimate = max;
+		max = min;
+		min = estimate;
+	}
+	estimate = ((7U * max) >> 3U) + (min >> 1U);
+
+	return (uint16_t)((estimate > max) ? estimate : max);
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t AdcFft_Init(adcFft_t *fft, uint16_t points, adcFftWindow_t window, uint32_t sampleRate_Hz, q15_t *buffer)
+{
+	uint8_t log2Points = 0U;
+
+	if((fft == NULL) || (buffer == NULL) || (sampleRate_Hz == 0U) ||
+	   (points < ADC_FFT_MIN_POINTS) || (points > ADC_FFT_MAX_POINTS) || ((points & (points - 1U)) != 0U) ||
+	   (window > kAdcFft_WindowHamming))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	while((1UL << log2Points) < points)
+	{
+		log2Points++;
+	}
+
+	fft->buffer = buffer;
+	fft->points = points;
+	fft->log2Points = log2Points;
+	fft->window = window;
+	fft->sampleRate_Hz = sampleRate_Hz;
+
+	return kStatus_Success;
+}
+
+void AdcFft_Load(adcFft_t *fft, const q15_t *samples)
+{
+	const uint32_t points = fft->points;
+	const uint32_t stride = ADC_FFT_MAX_POINTS >> fft->log2Points;
+	const uint32_t shift = ADC_FFT_TABLE_LOG2 - fft->log2Points;
+	q15_t *buffer = fft->buffer;
+	uint32_t n, k, index;
+	q31_t x, c;
+
+	for(n = 0U; n < points; n++)
+	{
+		x = samples[n];
+		/* Keeps |x| <= 32767, so the butterflies never overflow. */
+		if(x == -32768)
+		{
+			x = -32767;
+		}
+
+		if(fft->window != kAdcFft_WindowNone)
+		{
+			k = n * stride;
+			if(k > ADC_FFT_MAX_POINTS / 2U)
+			{
+				k = ADC_FFT_MAX_POINTS - k;
+			}
+			c = Cosine(k);
+			if(fft->window == kAdcFft_WindowHann)
+			{
+				x = (x * (16384 - (c >> 1))) >> 15;
+			}
+			else
+			{
+				x = (x * (17695 - ((15073 * c) >> 15))) >> 15;
+			}
+		}
+
+		index = 2U * (s_bitReverse[n] >> shift);
+		buffer[index] = (q15_t)x;
+		buffer[index + 1U] = 0;
+	}
+}
+
+void AdcFft_BitReverse(adcFft_t *fft)
+{
+	const uint32_t shift = ADC_FFT_TABLE_LOG2 - fft->log2Points;
+	q15_t *buffer = fft->buffer;
+	uint32_t n, r;
+	q15_t re, im;
+
+	for(n = 1U; n < fft->points; n++)
+	{
+		r = s_bitReverse[n] >> shift;
+		if(r > n)
+		{
+			re = buffer[2U * n];
+			im = buffer[2U * n + 1U];
+			buffer[2U * n] = buffer[2U * r];
+			buffer[2U * n + 1U] = buffer[2U * r + 1U];
+			buffer[2U * r] = re;
+			buffer[2U * r + 1U] = im;
+		}
+	}
+}
+
+void AdcFft_Transform(adcFft_t *fft)
+{
+	const uint32_t points = fft->points;
+	q15_t *buffer = fft->buffer;
+	q15_t *a, *b;
+	uint32_t half, step, k, i;
+	q31_t ar, ai, tr, ti, c, s;
+
+	/* First stage: W = 1. */
+	for(i = 0U; i < points; i += 2U)
+	{
+		a = &buffer[2U * i];
+		ar = a[0];
+		ai = a[1];
+		tr = a[2];
+		ti = a[3];
+		a[0] = (q15_t)((ar + tr) >> 1);
+		a[1] = (q15_t)((ai + ti) >> 1);
+		a[2] = (q15_t)((ar - tr) >> 1);
+		a[3] = (q15_t)((ai - ti) >> 1);
+	}
+
+	for(half = 2U; half < points; half <<= 1U)
+	{
+		step = (ADC_FFT_MAX_POINTS / 2U) / half;
+		for(k = 0U; k < half; k++)
+		{
+			/* W = cos - j sin of 2 pi k / (2 half). */
+			c = Cosine(k * step);
+			s = Sine(k * step);
+			for(i = k; i < points; i += 2U * half)
+			{
+				a = &buffer[2U * i];
+				b = &buffer[2U * (i + half)];
+				tr = (b[0] * c + b[1] * s) >> 15;
+				ti = (b[1] * c - b[0] * s) >> 15;
+				ar = a[0];
+				ai = a[1];
+				a[0] = (q15_t)((ar + tr) >> 1);
+				a[1] = (q15_t)((ai + ti) >> 1);
+				b[0] = (q15_t)((ar - tr) >> 1);
+				b[1] = (q15_t)((ai - ti) >> 1);
+			}
+		}
+	}
+}
+
+void AdcFft_Magnitude(adcFft_t *fft, uint16_t *magnitude)
+{
+	const q15_t *buffer = fft->buffer;
+	uint32_t k;
+
+	/* Bin k is read from 2k and 2k + 1 before k is written. */
+	for(k = 0U; k <= fft->points / 2U; k++)
+	{
+		magnitude[k] = Magnitude(buffer[2U * k], buffer[2U * k + 1U]);
+	}
+}
+
+void AdcFft_Analyze(adcFft_t *fft,
+                    const q15_t *samples,
+                    adcFftSpectrum_t *spectrum,
+                    const adcFftBand_t *bands,
+                    uint8_t bandsCount,
+                    uint64_t *energies)
+{
+	const uint32_t last = fft->points / 2U;
+	const q15_t *buffer = fft->buffer;
+	uint32_t k, kLow, kHigh, band;
+	uint16_t magnitude, left, right;
+	int32_t den, delta = 0;
+	q31_t re, im;
+	uint64_t energy;
+
+	AdcFft_Load(fft, samples);
+	AdcFft_Transform(fft);
+
+	spectrum->dominantBin = 1U;
+	spectrum->dominantMagnitude = 0U;
+	spectrum->totalEnergy = 0U;
+	for(k = 1U; k <= last; k++)
+	{
+		re = buffer[2U * k];
+		im = buffer[2U * k + 1U];
+		spectrum->totalEnergy += (uint32_t)(re * re) + (uint32_t)(im * im);
+		magnitude = Magnitude(re, im);
+		if(magnitude > spectrum->dominantMagnitude)
+		{
+			spectrum->dominantMagnitude = magnitude;
+			spectrum->dominantBin = (uint16_t)k;
+		}
+	}
+
+	/* Parabolic interpolation between the neighbour bins, in 1/256 bin. */
+	k = spectrum->dominantBin;
+	if((k > 1U) && (k < last))
+	{
+		left = Magnitude(buffer[2U * (k - 1U)], buffer[2U * (k - 1U) + 1U]);
+		right = Magnitude(buffer[2U * (k + 1U)], buffer[2U * (k + 1U) + 1U]);
+		den = 2 * (int32_t)spectrum->dominantMagnitude - left - right;
+		if(den > 0)
+		{
+			delta = (128 * ((int32_t)right - left)) / den;
+			delta = (delta > 128) ? 128 : ((delta < -128) ? -128 : delta);
+		}
+	}
+	spectrum->dominant_mHz = (uint32_t)(((uint64_t)(int32_t)(256U * k + delta) * fft->sampleRate_Hz * 1000U) >>
+	                                    (8U + fft->log2Points));
+
+	for(band = 0U; (bands != NULL) && (band < bandsCount); band++)
+	{
+		kLow = last + 1U;
+		if(bands[band].low_Hz <= fft->sampleRate_Hz / 2U)
+		{
+			kLow = (bands[band].low_Hz * fft->points + fft->sampleRate_Hz - 1U) / fft->sampleRate_Hz;
+		}
+		kHigh = last;
+		if(bands[band].high_Hz < fft->sampleRate_Hz / 2U)
+		{
+			kHigh = (bands[band].high_Hz * fft->points) / fft->sampleRate_Hz;
+		}
+
+		energy = 0U;
+		for(k = kLow; k <= kHigh; k++)
+		{
+			re = buffer[2U * k];
+			im = buffer[2U * k + 1U];
+			energy += (uint32_t)(re * re) + (uint32_t)(im * im);
+		}
+		energies[band] = energy;
+	}
+}
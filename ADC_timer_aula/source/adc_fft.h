@@ -0,0 +1,187 @@
+/**
+ * @file	adc_fft.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Q15 radix-2 FFT and spectrum analysis of ADC sample blocks.
+ *
+ * The transform is an in-place radix-2 decimation in time over
+ * interleaved complex q15 values {re, im}, from 64 to 1024 points. Each
+ * stage scales by 1/2, so the result is the DFT divided by N and never
+ * overflows. The twiddle factors come from a quarter wave sine table and
+ * the bit reversed indexes from a table, both in flash; the only RAM is
+ * the caller's buffer of 2 * N q15_t (4 KB for 1024 points).
+ *
+ * AdcFft_Analyze() processes one block of real samples (e.g. converted
+ * by AdcFilter_FromAdc()): it applies the window while copying the samples
+ * in bit reversed order, transforms, and reports the dominant frequency
+ * (interpolated between bins) and the energy of each requested band.
+ *
+ * The magnitudes are approximated without square root by
+ * max(M, 7/8 M + 1/2 m), where M and m are the largest and smallest of
+ * |re| and |im| (error below 3 %). The energies are exact sums of
+ * re^2 + im^2.
+ *
+ */
+
+#ifndef ADC_FFT_H_
+#define ADC_FFT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "fsl_common.h"
+
+#ifndef ARM_MATH_CM0PLUS
+#define ARM_MATH_CM0PLUS
+#endif
+#include "arm_math.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup adc_fft
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define ADC_FFT_MIN_POINTS 64U
+#define ADC_FFT_MAX_POINTS 1024U
+
+/*!< Buffer size (q15_t) for a number of points.*/
+#define ADC_FFT_BUFFER_SIZE(points) (2U * (points))
+
+/*!< Window applied by AdcFft_Load().*/
+typedef enum{
+	kAdcFft_WindowNone = 0U,   /*!< Rectangular.*/
+	kAdcFft_WindowHann,        /*!< 0.5 - 0.5 cos(2 pi n / N).*/
+	kAdcFft_WindowHamming,     /*!< 0.54 - 0.46 cos(2 pi n / N).*/
+}adcFftWindow_t;
+
+/*!
+ * @brief FFT instance. The fields are internal.
+ */
+typedef struct{
+	q15_t *buffer;           /*!< ADC_FFT_BUFFER_SIZE(points) values, {re, im} pairs.*/
+	uint16_t points;
+	uint8_t log2Points;
+	adcFftWindow_t window;
+	uint32_t sampleRate_Hz;
+}adcFft_t;
+
+/*!< A frequency band, limits included.*/
+typedef struct{
+	uint32_t low_Hz;
+	uint32_t high_Hz;
+}adcFftBand_t;
+
+/*!< Spectrum summary of a block.*/
+typedef struct{
+	uint32_t dominant_mHz;      /*!< Frequency of the largest bin (DC excluded), interpolated.*/
+	uint16_t dominantBin;       /*!< Largest bin (1 to N/2).*/
+	uint16_t dominantMagnitude; /*!< Its magnitude, q15 scaled by 1/N.*/
+	uint64_t totalEnergy;       /*!< Sum of re^2 + im^2 from bin 1 to N/2.*/
+}adcFftSpectrum_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Initializes an FFT instance.
+ *
+ * @param fft           - the instance.
+ * @param points        - the number of points, a power of two from 64 to 1024.
+ * @param window        - the window applied to the samples.
+ * @param sampleRate_Hz - the sample rate, for the frequencies.
+ * @param buffer        - ADC_FFT_BUFFER_SIZE(points) values.
+ *
+ * @return kStatus_Success if initialized;
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t AdcFft_Init(adcFft_t *fft, uint16_t points, adcFftWindow_t window, uint32_t sampleRate_Hz, q15_t *buffer);
+
+/**
+ * @brief Copies a block of real samples to the buffer, windowed and in
+ *        bit reversed order, ready for AdcFft_Transform().
+ *
+ * @param fft     - the instance.
+ * @param samples - N samples.
+ *
+ */
+void AdcFft_Load(adcFft_t *fft, const q15_t *samples);
+
+/**
+ * @brief Reorders the buffer in bit reversed order, in place, for complex
+ *        values written by the caller in natural order.
+ *
+ * @param fft - the instance.
+ *
+ */
+void AdcFft_BitReverse(adcFft_t *fft);
+
+/**
+ * @brief Transforms the buffer in place. The input must be in bit reversed
+ *        order, the output is in natural order and scaled by 1/N.
+ *
+ * @param fft - the instance.
+ *
+ */
+void AdcFft_Transform(adcFft_t *fft);
+
+/**
+ * @brief Computes the approximate magnitudes of the bins 0 to N/2.
+ *
+ * @param fft       - the instance, after AdcFft_Transform().
+ * @param magnitude - N/2 + 1 values; can be the buffer itself (cast to
+ *                    uint16_t *), then the transform is overwritten.
+ *
+ */
+void AdcFft_Magnitude(adcFft_t *fft, uint16_t *magnitude);
+
+/**
+ * @brief Loads, transforms and summarizes one block of samples.
+ *
+ * @param fft        - the instance.
+ * @param samples    - N samples.
+ * @param spectrum   - where the summary is stored.
+ * @param bands      - the bands to measure, can be NULL.
+ * @param bandsCount - the number of bands.
+ * @param energies   - where the energy of each band is stored.
+ *
+ */
+void AdcFft_Analyze(adcFft_t *fft,
+                    const q15_t *samples,
+                    adcFftSpectrum_t *spectrum,
+                    const adcFftBand_t *bands,
+                    uint8_t bandsCount,
+                    uint64_t *energies);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* ADC_FFT_H_ */
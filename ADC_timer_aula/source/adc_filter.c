@@ -0,0 +1,282 @@
+/**
+ * @file	adc_filter.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Fixed point FIR and biquad IIR filters for blocks of ADC samples.
+ *
+ * The cascades are processed stage by stage over the whole block, so the
+ * coefficients and the state of a stage stay in registers for the block.
+ *
+ * The Cortex-M0+ has only 8 low registers, so the loops are unrolled
+ * just enough to remove the bookkeeping: the Direct Form I handles two
+ * samples per iteration, swapping the roles of the delayed values instead
+ * of moving them, and the FIR handles four taps per iteration.
+ *
+ * The FIR delay line is circular, but each sample is written twice, at
+ * index and index + numTaps, so the last numTaps samples are always
+ * contiguous and the inner loop needs no wrap around test.
+ *
+ */
+
+#include <string.h>
+#include "adc_filter.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define ADC_FILTER_MAX_POST_SHIFT 14U
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Rounds a Q(30 - postShift) accumulator to q15, saturating.
+ *
+ */
+static inline q15_t RoundToQ15(q31_t acc, uint32_t shift);
+
+/**
+ * @brief Filters a block with one Direct Form I stage.
+ *
+ */
+static void BiquadDf1Stage(const q15_t *coeffs, q31_t *state, uint32_t shift,
+                           const q15_t *input, q15_t *output, size_t count);
+
+/**
+ * @brief Filters a block with one Direct Form II transposed stage.
+ *
+ */
+static void BiquadDf2tStage(const q15_t *coeffs, q31_t *state, uint32_t shift,
+                            const q15_t *input, q15_t *output, size_t count);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static inline q15_t RoundToQ15(q31_t acc, uint32_t shift)
+{
+	return (q15_t)__SSAT((acc + (q31_t)(1UL << (shift - 1U))) >> shift, 16U);
+}
+
+static void BiquadDf1Stage(const q15_t *coeffs, q31_t *state, uint32_t shift,
+                           const q15_t *input, q15_t *output, size_t count)
+{
+	const q31_t b0 = coeffs[0], b1 = coeffs[1], b2 = coeffs[2];
+	const q31_t a1 = coeffs[3], a2 = coeffs[4];
+	q31_t x1 = state[0], x2 = state[1], y1 = state[2], y2 = state[3];
+	q31_t acc;
+
+	while(count >= 2U)
+	{
+		/* The oldest values (x2, y2) are used and replaced by the newest. */
+		acc = b2 * x2 + b1 * x1 + a2 * y2 + a1 * y1;
+		x2 = *input++;
+		acc += b0 * x2;
+		y2 = RoundToQ15(acc, shift);
+		*output++ = (q15_t)y2;
+
+		/* Now x1 and y1 are the oldest. */
+		acc = b2 * x1 + b1 * x2 + a2 * y1 + a1 * y2;
+		x1 = *input++;
+		acc += b0 * x1;
+		y1 = RoundToQ15(acc, shift);
+		*output++ = (q15_t)y1;
+
+		count -= 2U;
+	}
+
+	if(count != 0U)
+	{
+		acc = b2 * x2 + b1 * x1 + a2 * y2 + a1 * y1;
+		x2 = x1;
+		x1 = *input;
+		acc += b0 * x1;
+		y2 = y1;
+		y1 = RoundToQ15(acc, shift);
+		*output = (q15_t)y1;
+	}
+
+	state[0] = x1;
+	state[1] = x2;
+	state[2] = y1;
+	state[3] = y2;
+}
+
+static void BiquadDf2tStage(const q15_t *coeffs, q31_t *state, uint32_t shift,
+                            const q15_t *input, q15_t *output, size_t count)
+{
+	const q31_t b0 = coeffs[0], b1 = coeffs[1], b2 = coeffs[2];
+	const q31_t a1 = coeffs[3], a2 = coeffs[4];
+	q31_t s1 = state[0], s2 = state[1];
+	q31_t x, y;
+
+	while(count--)
+	{
+		x = *input++;
+		y = RoundToQ15(b0 * x + s1, shift);
+		s1 = b1 * x + a1 * y + s2;
+		s2 = b2 * x + a2 * y;
+		*output++ = (q15_t)y;
+	}
+
+	state[0] = s1;
+	state[1] = s2;
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t AdcFilter_BiquadInit(adcFilterBiquad_t *filter,
+                              adcFilterForm_t form,
+                              const q15_t *coeffs,
+                              uint8_t stages,
+                              uint8_t postShift,
+                              q31_t *state)
+{
+	if((filter == NULL) || (coeffs == NULL) || (state == NULL) || (stages == 0U) ||
+	   (postShift > ADC_FILTER_MAX_POST_SHIFT) ||
+	   ((form != kAdcFilter_DirectForm1) && (form != kAdcFilter_DirectForm2T)))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	filter->coeffs = coeffs;
+	filter->state = state;
+	filter->stages = stages;
+	filter->postShift = postShift;
+	filter->form = form;
+	AdcFilter_BiquadReset(filter);
+
+	return kStatus_Success;
+}
+
+void AdcFilter_BiquadReset(adcFilterBiquad_t *filter)
+{
+	memset(filter->state, 0, ADC_FILTER_BIQUAD_STATE_SIZE(filter->stages) * sizeof(q31_t));
+}
+
+void AdcFilter_Biquad(adcFilterBiquad_t *filter, const q15_t *input, q15_t *output, size_t count)
+{
+	const q15_t *coeffs = filter->coeffs;
+	q31_t *state = filter->state;
+	uint32_t shift = 15U - filter->postShift;
+	uint32_t stage;
+
+	for(stage = 0U; stage < filter->stages; stage++)
+	{
+		if(filter->form == kAdcFilter_DirectForm1)
+		{
+			BiquadDf1Stage(coeffs, state, shift, input, output, count);
+		}
+		else
+		{
+			BiquadDf2tStage(coeffs, state, shift, input, output, count);
+		}
+		/* The next stages filter the output in place. */
+		input = output;
+		coeffs += 5U;
+		state += 4U;
+	}
+}
+
+status_t AdcFilter_FirInit(adcFilterFir_t *filter,
+                           const q15_t *coeffs,
+                           uint16_t numTaps,
+                           uint8_t postShift,
+                           q15_t *state)
+{
+	if((filter == NULL) || (coeffs == NULL) || (state == NULL) || (numTaps == 0U) ||
+	   (postShift > ADC_FILTER_MAX_POST_SHIFT))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	filter->coeffs = coeffs;
+	filter->state = state;
+	filter->numTaps = numTaps;
+	filter->postShift = postShift;
+	AdcFilter_FirReset(filter);
+
+	return kStatus_Success;
+}
+
+void AdcFilter_FirReset(adcFilterFir_t *filter)
+{
+	memset(filter->state, 0, ADC_FILTER_FIR_STATE_SIZE(filter->numTaps) * sizeof(q15_t));
+	filter->index = 0U;
+}
+
+void AdcFilter_Fir(adcFilterFir_t *filter, const q15_t *input, q15_t *output, size_t count)
+{
+	const uint32_t numTaps = filter->numTaps;
+	const uint32_t shift = 15U - filter->postShift;
+	q15_t *state = filter->state;
+	uint32_t index = filter->index;
+	const q15_t *h;
+	const q15_t *px;
+	q31_t acc;
+	uint32_t k;
+
+	while(count--)
+	{
+		if(++index == numTaps)
+		{
+			index = 0U;
+		}
+		state[index] = *input;
+		state[index + numTaps] = *input++;
+
+		/* px[-k] is x[n - k]. */
+		h = filter->coeffs;
+		px = &state[index + numTaps];
+		acc = 0;
+
+		for(k = numTaps >> 2U; k != 0U; k--)
+		{
+			acc += (q31_t)h[0] * px[0];
+			acc += (q31_t)h[1] * px[-1];
+			acc += (q31_t)h[2] * px[-2];
+			acc += (q31_t)h[3] * px[-3];
+			h += 4;
+			px -= 4;
+		}
+		for(k = numTaps & 3U; k != 0U; k--)
+		{
+			acc += (q31_t)(*h++) * (*px--);
+		}
+
+		*output++ = RoundToQ15(acc, shift);
+	}
+
+	filter->index = (uint16_t)index;
+}
+
+void AdcFilter_FromAdc(const uint16_t *input, q15_t *output, size_t count, uint8_t bits)
+{
+	const uint32_t shift = 16U - bits;
+
+	while(count--)
+	{
+		*output++ = (q15_t)((int32_t)((uint32_t)*input++ << shift) - 32768);
+	}
+}
@@ -0,0 +1,213 @@
+/**
+ * @file	adc_filter.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Fixed point FIR and biquad IIR filters for blocks of ADC samples.
+ *
+ * The Cortex-M0+ has no FPU and no DSP instructions, but its single cycle
+ * 32 x 32 bits multiplier makes a q15 x q15 product cheap. So the samples
+ * and the coefficients are q15_t (CMSIS arm_math.h types), the products
+ * are accumulated in 32 bits (q31_t) and the output is rounded and
+ * saturated back to q15.
+ *
+ * The coefficients are designed offline (e.g. with scipy.signal or
+ * MATLAB) and scaled by 2^-postShift, so values up to 2^postShift fit in
+ * q15. ADC_FILTER_Q15() converts them at compile time:
+ *
+ *   static const q15_t lowpass[5] = {
+ *       ADC_FILTER_Q15(0.0675, 1), ADC_FILTER_Q15(0.1349, 1), ADC_FILTER_Q15(0.0675, 1),
+ *       ADC_FILTER_Q15(1.1430, 1), ADC_FILTER_Q15(-0.4128, 1)};
+ *
+ * Biquads: {b0, b1, b2, a1, a2} for each stage, with the feedback
+ * coefficients negated as in CMSIS:
+ *   y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2]
+ * FIR: {h0, h1, ..., hN-1}, with y[n] = sum(hk x[n-k]).
+ *
+ * The accumulator wraps around while summing, which is harmless as long
+ * as the final sum fits in 32 bits: it is guaranteed if the sum of the
+ * absolute scaled coefficients of a stage (or of the FIR) is below 2.
+ *
+ */
+
+#ifndef ADC_FILTER_H_
+#define ADC_FILTER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "fsl_common.h"
+
+#ifndef ARM_MATH_CM0PLUS
+#define ARM_MATH_CM0PLUS
+#endif
+#include "arm_math.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup adc_filter
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Converts a real coefficient to q15 scaled by 2^-postShift, rounding.
+ *   For constant initializers only.*/
+#define ADC_FILTER_Q15(x, postShift) \
+	((q15_t)((x) * (double)(1UL << (15U - (postShift))) + (((x) >= 0.0) ? 0.5 : -0.5)))
+
+/*!< State words (q31_t) of a biquad cascade.*/
+#define ADC_FILTER_BIQUAD_STATE_SIZE(stages) (4U * (stages))
+
+/*!< State samples (q15_t) of a FIR.*/
+#define ADC_FILTER_FIR_STATE_SIZE(numTaps) (2U * (numTaps))
+
+/*!< Biquad structure.*/
+typedef enum{
+	kAdcFilter_DirectForm1 = 0U, /*!< Direct Form I: no internal overflow, 4 state values per stage.*/
+	kAdcFilter_DirectForm2T,     /*!< Direct Form II transposed: the state keeps the full
+	                                  products, lower noise in low cutoff filters.*/
+}adcFilterForm_t;
+
+/*!
+ * @brief Biquad cascade instance. The fields are internal.
+ */
+typedef struct{
+	const q15_t *coeffs; /*!< 5 coefficients per stage.*/
+	q31_t *state;        /*!< ADC_FILTER_BIQUAD_STATE_SIZE(stages) words.*/
+	uint8_t stages;
+	uint8_t postShift;
+	adcFilterForm_t form;
+}adcFilterBiquad_t;
+
+/*!
+ * @brief FIR instance. The fields are internal.
+ */
+typedef struct{
+	const q15_t *coeffs; /*!< numTaps coefficients.*/
+	q15_t *state;        /*!< ADC_FILTER_FIR_STATE_SIZE(numTaps) samples.*/
+	uint16_t numTaps;
+	uint16_t index;      /*!< Position of the newest sample.*/
+	uint8_t postShift;
+}adcFilterFir_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Initializes a biquad cascade, clearing its state.
+ *
+ * @param filter    - the instance.
+ * @param form      - the biquad structure.
+ * @param coeffs    - {b0, b1, b2, a1, a2} of each stage, must stay valid.
+ * @param stages    - number of second order stages.
+ * @param postShift - coefficients scale, from 0 to 14.
+ * @param state     - ADC_FILTER_BIQUAD_STATE_SIZE(stages) words.
+ *
+ * @return kStatus_Success if initialized;
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t AdcFilter_BiquadInit(adcFilterBiquad_t *filter,
+                              adcFilterForm_t form,
+                              const q15_t *coeffs,
+                              uint8_t stages,
+                              uint8_t postShift,
+                              q31_t *state);
+
+/**
+ * @brief Clears the state of a biquad cascade.
+ *
+ * @param filter - the instance.
+ *
+ */
+void AdcFilter_BiquadReset(adcFilterBiquad_t *filter);
+
+/**
+ * @brief Filters a block with a biquad cascade.
+ *
+ * @param filter - the instance.
+ * @param input  - the input samples.
+ * @param output - the output samples, can be the same as input.
+ * @param count  - the number of samples.
+ *
+ */
+void AdcFilter_Biquad(adcFilterBiquad_t *filter, const q15_t *input, q15_t *output, size_t count);
+
+/**
+ * @brief Initializes a FIR, clearing its state.
+ *
+ * @param filter    - the instance.
+ * @param coeffs    - the coefficients, must stay valid.
+ * @param numTaps   - number of coefficients.
+ * @param postShift - coefficients scale, from 0 to 14.
+ * @param state     - ADC_FILTER_FIR_STATE_SIZE(numTaps) samples.
+ *
+ * @return kStatus_Success if initialized;
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t AdcFilter_FirInit(adcFilterFir_t *filter,
+                           const q15_t *coeffs,
+                           uint16_t numTaps,
+                           uint8_t postShift,
+                           q15_t *state);
+
+/**
+ * @brief Clears the state of a FIR.
+ *
+ * @param filter - the instance.
+ *
+ */
+void AdcFilter_FirReset(adcFilterFir_t *filter);
+
+/**
+ * @brief Filters a block with a FIR.
+ *
+ * @param filter - the instance.
+ * @param input  - the input samples.
+ * @param output - the output samples, can be the same as input.
+ * @param count  - the number of samples.
+ *
+ */
+void AdcFilter_Fir(adcFilterFir_t *filter, const q15_t *input, q15_t *output, size_t count);
+
+/**
+ * @brief Converts unsigned ADC results to q15, centered at mid scale.
+ *
+ * @param input  - the ADC results.
+ * @param output - the q15 samples, can be the same memory as input.
+ * @param count  - the number of samples.
+ * @param bits   - the ADC result width (8 to 16).
+ *
+ */
+void AdcFilter_FromAdc(const uint16_t *input, q15_t *output, size_t count, uint8_t bits);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* ADC_FILTER_H_ */
@@ -0,0 +1,291 @@
+/**
+ * @file	adc_monitor.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * ADC threshold monitor by the ADC16 hardware compare.
+ *
+ * The compare settings of both states (waiting the entry and waiting the
+ * exit) are computed by AdcMonitor_Init(), so the ISR only reads the
+ * result, swaps the CV1, CV2 and SC2 compare bits and queues the event.
+ * The SC1A channel is not written again: with the hardware trigger the
+ * ADC stays armed after each conversion.
+ *
+ */
+
+#include <string.h>
+#include "adc_monitor.h"
+#include "fsl_smc.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define ADC_MONITOR_QUEUE_MASK (ADC_MONITOR_QUEUE_SIZE - 1U)
+
+#define ADC_MONITOR_MAX_CHANNEL_NUMBER 30U
+
+#define ADC_MONITOR_COMPARE_MASK (ADC_SC2_ACFE_MASK | ADC_SC2_ACFGT_MASK | ADC_SC2_ACREN_MASK)
+
+/*!< Compare registers of one state.*/
+typedef struct{
+	uint8_t sc2; /*!< ACFE, ACFGT and ACREN.*/
+	uint16_t cv1;
+	uint16_t cv2;
+}adcMonitorCompare_t;
+
+/*!< Monitor runtime data.*/
+typedef struct{
+	ADC_Type *base;
+	uint8_t sc1;                        /*!< ADCH and AIEN.*/
+	adcMonitorCompare_t compare[2];     /*!< Entry and exit conditions.*/
+	volatile bool active;               /*!< Waiting the exit.*/
+	bool vlps;
+	adcMonitorEvent_t queue[ADC_MONITOR_QUEUE_SIZE];
+	volatile uint8_t head;
+	volatile uint8_t tail;
+	volatile uint32_t lost;
+	adcMonitorTimestamp_t timestamp;
+	adcMonitorCallback_t callback;
+	void *userData;
+}adcMonitorHandle_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Fills the compare registers of a hardware compare mode.
+ *
+ */
+static void SetCompare(adcMonitorCompare_t *compare, adc16_hardware_compare_mode_t mode, int32_t cv1, int32_t cv2);
+
+/**
+ * @brief Writes the compare registers of one state.
+ *
+ */
+static inline void LoadCompare(ADC_Type *base, const adcMonitorCompare_t *compare);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static adcMonitorHandle_t s_monitor;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void SetCompare(adcMonitorCompare_t *compare, adc16_hardware_compare_mode_t mode, int32_t cv1, int32_t cv2)
+{
+	/* The thresholds moved by the hysteresis saturate in the result range. */
+	cv1 = (cv1 < 0) ? 0 : ((cv1 > 0xFFFF) ? 0xFFFF : cv1);
+	cv2 = (cv2 < 0) ? 0 : ((cv2 > 0xFFFF) ? 0xFFFF : cv2);
+
+	compare->sc2 = ADC_SC2_ACFE_MASK;
+	if((mode == kADC16_HardwareCompareMode1) || (mode == kADC16_HardwareCompareMode3))
+	{
+		compare->sc2 |= ADC_SC2_ACFGT_MASK;
+	}
+	if((mode == kADC16_HardwareCompareMode2) || (mode == kADC16_HardwareCompareMode3))
+	{
+		compare->sc2 |= ADC_SC2_ACREN_MASK;
+	}
+	compare->cv1 = (uint16_t)cv1;
+	compare->cv2 = (uint16_t)cv2;
+}
+
+static inline void LoadCompare(ADC_Type *base, const adcMonitorCompare_t *compare)
+{
+	base->CV1 = compare->cv1;
+	base->CV2 = compare->cv2;
+	base->SC2 = (base->SC2 & ~ADC_MONITOR_COMPARE_MASK) | compare->sc2;
+}
+
+status_t AdcMonitor_Init(const adcMonitorConfig_t *config)
+{
+	int32_t low, high, hysteresis;
+
+	if((config == NULL) || (config->base == NULL) ||
+	   (config->channelNumber > ADC_MONITOR_MAX_CHANNEL_NUMBER) || (config->condition > kAdcMonitor_Outside))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	low = config->low;
+	high = config->high;
+	hysteresis = config->hysteresis;
+
+	if(((config->condition == kAdcMonitor_Inside) && (low > high)) ||
+	   ((config->condition == kAdcMonitor_Outside) && ((low + hysteresis) > (high - hysteresis))))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	DisableIRQ(ADC0_IRQn);
+
+	memset(&s_monitor, 0, sizeof(s_monitor));
+	s_monitor.base = config->base;
+	s_monitor.sc1 = ADC_SC1_ADCH(config->channelNumber) | ADC_SC1_AIEN_MASK;
+	s_monitor.timestamp = config->timestamp;
+	s_monitor.callback = config->callback;
+	s_monitor.userData = config->userData;
+	/* Without VLPS allowed, the stop mode would be the normal STOP. */
+	s_monitor.vlps = (config->sleepMode == kAdcMonitor_SleepVlps) && ((SMC->PMPROT & SMC_PMPROT_AVLP_MASK) != 0U);
+
+	switch(config->condition)
+	{
+		case kAdcMonitor_Above:
+			SetCompare(&s_monitor.compare[0], kADC16_HardwareCompareMode1, low, 0);
+			SetCompare(&s_monitor.compare[1], kADC16_HardwareCompareMode0, low - hysteresis, 0);
+			break;
+		case kAdcMonitor_Below:
+			SetCompare(&s_monitor.compare[0], kADC16_HardwareCompareMode0, low, 0);
+			SetCompare(&s_monitor.compare[1], kADC16_HardwareCompareMode1, low + hysteresis, 0);
+			break;
+		case kAdcMonitor_Inside:
+			SetCompare(&s_monitor.compare[0], kADC16_HardwareCompareMode3, low, high);
+			SetCompare(&s_monitor.compare[1], kADC16_HardwareCompareMode2, low - hysteresis, high + hysteresis);
+			break;
+		default:
+			SetCompare(&s_monitor.compare[0], kADC16_HardwareCompareMode2, low, high);
+			SetCompare(&s_monitor.compare[1], kADC16_HardwareCompareMode3, low + hysteresis, high - hysteresis);
+			break;
+	}
+
+	return kStatus_Success;
+}
+
+void AdcMonitor_Start(void)
+{
+	ADC_Type *base = s_monitor.base;
+
+	DisableIRQ(ADC0_IRQn);
+
+	/* Single conversions at each trigger. */
+	base->SC1[0] = ADC_SC1_ADCH(0x1FU);
+	base->SC3 &= ~(ADC_SC3_ADCO_MASK | ADC_SC3_CALF_MASK);
+	(void)base->R[0];
+
+	s_monitor.active = false;
+	LoadCompare(base, &s_monitor.compare[0]);
+	base->SC2 |= ADC_SC2_ADTRG_MASK;
+	base->SC1[0] = s_monitor.sc1;
+
+	EnableIRQ(ADC0_IRQn);
+}
+
+void AdcMonitor_Stop(void)
+{
+	ADC_Type *base = s_monitor.base;
+
+	DisableIRQ(ADC0_IRQn);
+	base->SC1[0] = ADC_SC1_ADCH(0x1FU);
+	base->SC2 &= ~ADC_MONITOR_COMPARE_MASK;
+	(void)base->R[0];
+}
+
+bool AdcMonitor_IsActive(void)
+{
+	return s_monitor.active;
+}
+
+bool AdcMonitor_GetEvent(adcMonitorEvent_t *event)
+{
+	uint8_t tail = s_monitor.tail;
+
+	if(tail == s_monitor.head)
+	{
+		return false;
+	}
+
+	*event = s_monitor.queue[tail & ADC_MONITOR_QUEUE_MASK];
+	s_monitor.tail = tail + 1U;
+
+	return true;
+}
+
+void AdcMonitor_WaitEvent(adcMonitorEvent_t *event)
+{
+	while(!AdcMonitor_GetEvent(event))
+	{
+		/* The queue is tested again with the interrupts masked: an event
+		 * after it leaves the interrupt pending and WFI returns at once. */
+		if(s_monitor.vlps)
+		{
+			SMC_PreEnterStopModes();
+			if(s_monitor.head == s_monitor.tail)
+			{
+				(void)SMC_SetPowerModeVlps(SMC);
+				/* Plain WFI elsewhere must keep entering Wait. */
+				SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+			}
+			SMC_PostExitStopModes();
+		}
+		else
+		{
+			SMC_PreEnterWaitModes();
+			if(s_monitor.head == s_monitor.tail)
+			{
+				(void)SMC_SetPowerModeWait(SMC);
+			}
+			SMC_PostExitWaitModes();
+		}
+	}
+}
+
+uint32_t AdcMonitor_GetLostEvents(void)
+{
+	return s_monitor.lost;
+}
+
+void AdcMonitor_IRQHandler(void)
+{
+	ADC_Type *base = s_monitor.base;
+	adcMonitorEvent_t *event;
+	uint8_t head = s_monitor.head;
+
+	if(!(base->SC1[0] & ADC_SC1_COCO_MASK))
+	{
+		return;
+	}
+
+	/* Switches to the opposite condition before the next trigger. */
+	s_monitor.active = !s_monitor.active;
+	LoadCompare(base, &s_monitor.compare[s_monitor.active ? 1U : 0U]);
+
+	if((uint8_t)(head - s_monitor.tail) >= ADC_MONITOR_QUEUE_SIZE)
+	{
+		(void)base->R[0];
+		s_monitor.lost++;
+		return;
+	}
+
+	/* Reading R clears COCO. */
+	event = &s_monitor.queue[head & ADC_MONITOR_QUEUE_MASK];
+	event->value = (uint16_t)base->R[0];
+	event->type = s_monitor.active ? kAdcMonitor_EventEnter : kAdcMonitor_EventExit;
+	event->timestamp = (s_monitor.timestamp != NULL) ? s_monitor.timestamp() : 0U;
+	s_monitor.head = head + 1U;
+
+	if(s_monitor.callback != NULL)
+	{
+		s_monitor.callback(event, s_monitor.userData);
+	}
+}
@@ -0,0 +1,207 @@
+/**
+ * @file	adc_monitor.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * ADC threshold monitor by the ADC16 hardware compare.
+ *
+ * The ADC converts at each hardware trigger, but with the compare function
+ * enabled a result only completes the conversion (COCO and interrupt) when
+ * it matches the programmed condition. So the CPU is not interrupted while
+ * the signal stays on the same side of the threshold, and can sleep.
+ *
+ * When the condition becomes true an enter event is reported, and the
+ * compare is reprogrammed with the opposite condition, moved by the
+ * hysteresis; when that one matches an exit event is reported and the
+ * original condition is programmed again:
+ *
+ *   condition             exit condition
+ *   Above:  x >= low      x < low - hysteresis
+ *   Below:  x < low       x >= low + hysteresis
+ *   Inside: low..high     x < low - hysteresis or x > high + hysteresis
+ *   Outside: not low..high  low + hysteresis..high - hysteresis
+ *
+ * The events are queued with the result and a timestamp given by the
+ * application, and AdcMonitor_WaitEvent() sleeps in Wait or VLPS until
+ * one arrives.
+ *
+ * To convert in VLPS the ADC must use its asynchronous clock (ADACK) and
+ * the trigger must run in stop modes, e.g. LPTMR0 (SIM_SOPT7 0xE) or a
+ * TPM clocked by MCGIRCLK or OSCERCLK enabled in stop. VLPS must also be
+ * allowed by SMC_SetPowerModeProtection(), else Wait is used.
+ *
+ * The ADC must be previously initialized and calibrated with the fsl_adc16
+ * driver and the trigger selected in SIM_SOPT7. The application must call
+ * AdcMonitor_IRQHandler() from ADC0_IRQHandler().
+ *
+ */
+
+#ifndef ADC_MONITOR_H_
+#define ADC_MONITOR_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "fsl_adc16.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup adc_monitor
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Event queue size (power of two).*/
+#ifndef ADC_MONITOR_QUEUE_SIZE
+#define ADC_MONITOR_QUEUE_SIZE 8U
+#endif
+
+/*!< Monitored condition.*/
+typedef enum{
+	kAdcMonitor_Above = 0U, /*!< x >= low.*/
+	kAdcMonitor_Below,      /*!< x < low.*/
+	kAdcMonitor_Inside,     /*!< low <= x <= high.*/
+	kAdcMonitor_Outside,    /*!< x < low or x > high.*/
+}adcMonitorCondition_t;
+
+/*!< Low power mode of AdcMonitor_WaitEvent().*/
+typedef enum{
+	kAdcMonitor_SleepWait = 0U, /*!< Wait: the bus clock keeps running.*/
+	kAdcMonitor_SleepVlps,      /*!< Very low power stop.*/
+}adcMonitorSleep_t;
+
+/*!< Event type.*/
+typedef enum{
+	kAdcMonitor_EventEnter = 0U, /*!< The condition became true.*/
+	kAdcMonitor_EventExit,       /*!< The condition became false, beyond the hysteresis.*/
+}adcMonitorEventType_t;
+
+/*!< A threshold crossing.*/
+typedef struct{
+	adcMonitorEventType_t type;
+	uint16_t value;     /*!< The matching result.*/
+	uint32_t timestamp; /*!< Given by the timestamp function, 0 without it.*/
+}adcMonitorEvent_t;
+
+/*!< Timestamp function, called in interrupt context.*/
+typedef uint32_t (*adcMonitorTimestamp_t)(void);
+
+/*!< Event callback, called in interrupt context. The event is queued as well.*/
+typedef void (*adcMonitorCallback_t)(const adcMonitorEvent_t *event, void *userData);
+
+/*!
+ * @brief Monitor configuration structure.
+ */
+typedef struct{
+	ADC_Type *base;                  /*!< ADC peripheral base address.*/
+	uint8_t channelNumber;           /*!< ADCH value (single ended).*/
+	adcMonitorCondition_t condition; /*!< The monitored condition.*/
+	uint16_t low;                    /*!< Threshold of Above and Below, low limit of the windows.*/
+	uint16_t high;                   /*!< High limit of the windows.*/
+	uint16_t hysteresis;             /*!< Distance of the exit thresholds, in ADC counts.*/
+	adcMonitorSleep_t sleepMode;     /*!< Mode used by AdcMonitor_WaitEvent().*/
+	adcMonitorTimestamp_t timestamp; /*!< Timestamp function, can be NULL.*/
+	adcMonitorCallback_t callback;   /*!< Event callback, can be NULL.*/
+	void *userData;                  /*!< Parameter passed to the callback.*/
+}adcMonitorConfig_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Configures the monitor. It starts with AdcMonitor_Start().
+ *
+ * @param config - the configuration.
+ *
+ * @return kStatus_Success if configured;
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t AdcMonitor_Init(const adcMonitorConfig_t *config);
+
+/**
+ * @brief Arms the ADC with the hardware trigger and the entry condition.
+ *
+ */
+void AdcMonitor_Start(void);
+
+/**
+ * @brief Stops the conversions and disables the compare function.
+ *
+ */
+void AdcMonitor_Stop(void);
+
+/**
+ * @brief Tests if the condition is currently true (entered and not exited).
+ *
+ * @return true if inside the condition.
+ *
+ */
+bool AdcMonitor_IsActive(void);
+
+/**
+ * @brief Gets the oldest queued event, without blocking.
+ *
+ * @param event - where the event is stored.
+ *
+ * @return true if there was an event.
+ *
+ */
+bool AdcMonitor_GetEvent(adcMonitorEvent_t *event);
+
+/**
+ * @brief Sleeps until an event is queued and gets it.
+ *
+ *        Must be called with the interrupts enabled, from thread mode.
+ *
+ * @param event - where the event is stored.
+ *
+ */
+void AdcMonitor_WaitEvent(adcMonitorEvent_t *event);
+
+/**
+ * @brief Gets the number of events lost because the queue was full.
+ *
+ * @return The lost events.
+ *
+ */
+uint32_t AdcMonitor_GetLostEvents(void);
+
+/**
+ * @brief The monitor interrupt routine.
+ *
+ *        Must be called from ADC0_IRQHandler().
+ *
+ */
+void AdcMonitor_IRQHandler(void);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* ADC_MONITOR_H_ */
@@ -0,0 +1,290 @@
+/**
+ * @file	adc_queue.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Block queue of ADC samples.
+ *
+ * The blocks move between two rings of block indexes: the free ring,
+ * written by the consumer and read by the producer, and the ready ring,
+ * written by the producer and read by the consumer. Each ring has a
+ * single writer and a single reader and holds at most all the blocks, so
+ * no critical section is needed: the writer stores the index before
+ * advancing its free running head.
+ *
+ */
+
+#include <string.h>
+#include "adc_queue.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Queue runtime data.*/
+typedef struct{
+	adcQueueBlock_t *blocks;
+	uint8_t mask;                 /*!< blocksCount - 1.*/
+	uint16_t samplesPerBlock;
+	uint8_t highWater;
+	volatile uint8_t freeRing[ADC_QUEUE_MAX_BLOCKS];
+	volatile uint8_t freeHead;    /*!< Written by the consumer.*/
+	volatile uint8_t freeTail;    /*!< Written by the producer.*/
+	volatile uint8_t readyRing[ADC_QUEUE_MAX_BLOCKS];
+	volatile uint8_t readyHead;   /*!< Written by the producer.*/
+	volatile uint8_t readyTail;   /*!< Written by the consumer.*/
+	adcQueueBlock_t *filling;     /*!< Block of AdcQueue_PutSample().*/
+	uint32_t sequence;            /*!< Number of the next sample.*/
+	uint32_t pendingLost;         /*!< Lost since the last block.*/
+	bool losing;
+	adcQueueStats_t stats;
+	adcQueueTimestamp_t timestamp;
+	adcQueueCallback_t callback;
+	void *userData;
+}adcQueueHandle_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Takes a free block and starts its header.
+ *
+ */
+static adcQueueBlock_t *TakeFreeBlock(void);
+
+/**
+ * @brief Moves a block to the ready ring.
+ *
+ */
+static void Publish(adcQueueBlock_t *block);
+
+/**
+ * @brief Counts lost samples, reporting the overflow once.
+ *
+ */
+static void Lose(uint32_t count);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static adcQueueHandle_t s_queue;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static adcQueueBlock_t *TakeFreeBlock(void)
+{
+	adcQueueBlock_t *block;
+	uint8_t tail = s_queue.freeTail;
+
+	if(tail == s_queue.freeHead)
+	{
+		return NULL;
+	}
+
+	block = &s_queue.blocks[s_queue.freeRing[tail & s_queue.mask]];
+	s_queue.freeTail = tail + 1U;
+
+	block->count = 0U;
+	block->timestamp = (s_queue.timestamp != NULL) ? s_queue.timestamp() : 0U;
+	block->firstSample = s_queue.sequence;
+	block->lostBefore = s_queue.pendingLost;
+	s_queue.pendingLost = 0U;
+
+	if(s_queue.losing)
+	{
+		s_queue.losing = false;
+		if(s_queue.callback != NULL)
+		{
+			s_queue.callback(kAdcQueue_EventRecovered, (uint8_t)(s_queue.readyHead - s_queue.readyTail),
+			                 s_queue.userData);
+		}
+	}
+
+	return block;
+}
+
+static void Publish(adcQueueBlock_t *block)
+{
+	uint8_t head = s_queue.readyHead;
+	uint8_t ready;
+
+	s_queue.readyRing[head & s_queue.mask] = (uint8_t)(block - s_queue.blocks);
+	s_queue.readyHead = head + 1U;
+
+	s_queue.stats.blocks++;
+	s_queue.stats.samples += block->count;
+
+	ready = (uint8_t)(head + 1U - s_queue.readyTail);
+	if((s_queue.callback != NULL) && (s_queue.highWater != 0U) && (ready == s_queue.highWater))
+	{
+		s_queue.callback(kAdcQueue_EventHighWater, ready, s_queue.userData);
+	}
+}
+
+static void Lose(uint32_t count)
+{
+	s_queue.sequence += count;
+	s_queue.pendingLost += count;
+	s_queue.stats.lostSamples += count;
+
+	if(!s_queue.losing)
+	{
+		s_queue.losing = true;
+		s_queue.stats.overflows++;
+		if(s_queue.callback != NULL)
+		{
+			s_queue.callback(kAdcQueue_EventOverflow, (uint8_t)(s_queue.readyHead - s_queue.readyTail),
+			                 s_queue.userData);
+		}
+	}
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t AdcQueue_Init(const adcQueueConfig_t *config)
+{
+	uint32_t i;
+
+	if((config == NULL) || (config->blocks == NULL) || (config->samples == NULL) ||
+	   (config->samplesPerBlock == 0U) || (config->blocksCount < 2U) ||
+	   (config->blocksCount > ADC_QUEUE_MAX_BLOCKS) || ((config->blocksCount & (config->blocksCount - 1U)) != 0U) ||
+	   (config->highWater > config->blocksCount))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	memset(&s_queue, 0, sizeof(s_queue));
+	s_queue.blocks = config->blocks;
+	s_queue.mask = config->blocksCount - 1U;
+	s_queue.samplesPerBlock = config->samplesPerBlock;
+	s_queue.highWater = config->highWater;
+	s_queue.timestamp = config->timestamp;
+	s_queue.callback = config->callback;
+	s_queue.userData = config->userData;
+
+	for(i = 0U; i < config->blocksCount; i++)
+	{
+		memset(&config->blocks[i], 0, sizeof(adcQueueBlock_t));
+		config->blocks[i].samples = &config->samples[i * config->samplesPerBlock];
+		s_queue.freeRing[i] = (uint8_t)i;
+	}
+	s_queue.freeHead = config->blocksCount;
+
+	return kStatus_Success;
+}
+
+void AdcQueue_PutSample(uint16_t value)
+{
+	adcQueueBlock_t *block = s_queue.filling;
+
+	if(block == NULL)
+	{
+		block = TakeFreeBlock();
+		if(block == NULL)
+		{
+			Lose(1U);
+			return;
+		}
+		s_queue.filling = block;
+	}
+
+	block->samples[block->count++] = value;
+	s_queue.sequence++;
+
+	if(block->count == s_queue.samplesPerBlock)
+	{
+		s_queue.filling = NULL;
+		Publish(block);
+	}
+}
+
+void AdcQueue_Flush(void)
+{
+	adcQueueBlock_t *block = s_queue.filling;
+
+	if((block != NULL) && (block->count != 0U))
+	{
+		s_queue.filling = NULL;
+		Publish(block);
+	}
+}
+
+adcQueueBlock_t *AdcQueue_AcquireBlock(void)
+{
+	return TakeFreeBlock();
+}
+
+void AdcQueue_CommitBlock(adcQueueBlock_t *block, uint16_t count)
+{
+	block->count = count;
+	s_queue.sequence += count;
+	Publish(block);
+}
+
+void AdcQueue_ReportLost(uint32_t count)
+{
+	if(count != 0U)
+	{
+		Lose(count);
+	}
+}
+
+adcQueueBlock_t *AdcQueue_GetBlock(void)
+{
+	adcQueueBlock_t *block;
+	uint8_t tail = s_queue.readyTail;
+
+	if(tail == s_queue.readyHead)
+	{
+		return NULL;
+	}
+
+	block = &s_queue.blocks[s_queue.readyRing[tail & s_queue.mask]];
+	s_queue.readyTail = tail + 1U;
+
+	return block;
+}
+
+void AdcQueue_ReleaseBlock(adcQueueBlock_t *block)
+{
+	uint8_t head = s_queue.freeHead;
+
+	s_queue.freeRing[head & s_queue.mask] = (uint8_t)(block - s_queue.blocks);
+	s_queue.freeHead = head + 1U;
+}
+
+uint32_t AdcQueue_GetReadyCount(void)
+{
+	return (uint8_t)(s_queue.readyHead - s_queue.readyTail);
+}
+
+void AdcQueue_GetStats(adcQueueStats_t *stats)
+{
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	*stats = s_queue.stats;
+	EnableGlobalIRQ(primask);
+}
@@ -0,0 +1,222 @@
+/**
+ * @file	adc_queue.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Block queue of ADC samples, from the interrupt (producer) to the main
+ * loop (consumer).
+ *
+ * The samples are written straight into fixed size blocks of a pool. A
+ * full block is published to the ready queue and the consumer works on it
+ * in place until it gives it back, so no sample is copied. A block holds
+ * the timestamp and the sequence number of its first sample, and the
+ * number of samples lost just before it.
+ *
+ * When the consumer is slower than the producer, the blocks run out and
+ * the new samples are discarded and counted, instead of overwriting the
+ * ones not read yet. The backpressure callback reports when the ready
+ * queue reaches the high water mark, when the samples start being lost
+ * and when the producer recovers.
+ *
+ * Producers: AdcQueue_PutSample() for each result (e.g. from
+ * ADC0_IRQHandler()), or AdcQueue_AcquireBlock() / AdcQueue_CommitBlock()
+ * for a block filled by the DMA. Only one producer and one consumer.
+ *
+ */
+
+#ifndef ADC_QUEUE_H_
+#define ADC_QUEUE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup adc_queue
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Maximum number of blocks (power of two).*/
+#define ADC_QUEUE_MAX_BLOCKS 32U
+
+/*!< Backpressure events.*/
+typedef enum{
+	kAdcQueue_EventHighWater = 0U, /*!< The ready blocks reached the high water mark.*/
+	kAdcQueue_EventOverflow,       /*!< No free block: the samples are being lost.*/
+	kAdcQueue_EventRecovered,      /*!< A free block again, after lost samples.*/
+}adcQueueEvent_t;
+
+/*!
+ * @brief A block of samples.
+ */
+typedef struct{
+	uint16_t *samples;    /*!< The samples.*/
+	uint16_t count;       /*!< Number of valid samples.*/
+	uint32_t timestamp;   /*!< Timestamp of the first sample, 0 without the function.*/
+	uint32_t firstSample; /*!< Sequence number of the first sample, counting the lost ones.*/
+	uint32_t lostBefore;  /*!< Samples lost just before this block.*/
+}adcQueueBlock_t;
+
+/*!< Timestamp function, called in the producer context.*/
+typedef uint32_t (*adcQueueTimestamp_t)(void);
+
+/*!< Backpressure callback, called in the producer context. ready is the
+ *   number of blocks waiting the consumer.*/
+typedef void (*adcQueueCallback_t)(adcQueueEvent_t event, uint32_t ready, void *userData);
+
+/*!
+ * @brief Queue configuration structure.
+ */
+typedef struct{
+	adcQueueBlock_t *blocks;       /*!< Block headers (blocksCount).*/
+	uint8_t blocksCount;           /*!< Number of blocks, power of two from 2 to ADC_QUEUE_MAX_BLOCKS.*/
+	uint16_t *samples;             /*!< Memory of the samples (blocksCount * samplesPerBlock).*/
+	uint16_t samplesPerBlock;      /*!< Samples in each block.*/
+	uint8_t highWater;             /*!< Ready blocks of the high water event, 0 to disable.*/
+	adcQueueTimestamp_t timestamp; /*!< Timestamp function, can be NULL.*/
+	adcQueueCallback_t callback;   /*!< Backpressure callback, can be NULL.*/
+	void *userData;                /*!< Parameter passed to the callback.*/
+}adcQueueConfig_t;
+
+/*!< Queue counters.*/
+typedef struct{
+	uint32_t blocks;      /*!< Blocks published.*/
+	uint32_t samples;     /*!< Samples published.*/
+	uint32_t lostSamples; /*!< Samples lost for lack of free blocks.*/
+	uint32_t overflows;   /*!< Times the samples started being lost.*/
+}adcQueueStats_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Initializes the queue, with all the blocks free.
+ *
+ * @param config - the configuration.
+ *
+ * @return kStatus_Success if initialized;
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t AdcQueue_Init(const adcQueueConfig_t *config);
+
+/**
+ * @brief Adds one sample, publishing the block when it is full.
+ *
+ *        Producer side, usually called from the ADC interrupt.
+ *
+ * @param value - the sample.
+ *
+ */
+void AdcQueue_PutSample(uint16_t value);
+
+/**
+ * @brief Publishes the partial block being filled by AdcQueue_PutSample().
+ *
+ *        Producer side.
+ *
+ */
+void AdcQueue_Flush(void);
+
+/**
+ * @brief Takes a free block to be filled by the producer (e.g. by DMA).
+ *        Its timestamp is taken now.
+ *
+ *        Producer side.
+ *
+ * @return The block, or NULL if there is none: the producer must then
+ *         report the samples it discards with AdcQueue_ReportLost().
+ *
+ */
+adcQueueBlock_t *AdcQueue_AcquireBlock(void);
+
+/**
+ * @brief Publishes a block taken by AdcQueue_AcquireBlock().
+ *
+ *        Producer side.
+ *
+ * @param block - the block.
+ * @param count - the number of samples written.
+ *
+ */
+void AdcQueue_CommitBlock(adcQueueBlock_t *block, uint16_t count);
+
+/**
+ * @brief Counts samples discarded by a block producer.
+ *
+ *        Producer side.
+ *
+ * @param count - the number of samples.
+ *
+ */
+void AdcQueue_ReportLost(uint32_t count);
+
+/**
+ * @brief Gets the oldest ready block, without blocking.
+ *
+ *        Consumer side.
+ *
+ * @return The block, to be given back with AdcQueue_ReleaseBlock(), or
+ *         NULL if there is none.
+ *
+ */
+adcQueueBlock_t *AdcQueue_GetBlock(void);
+
+/**
+ * @brief Gives a block back to the pool.
+ *
+ *        Consumer side.
+ *
+ * @param block - a block got by AdcQueue_GetBlock().
+ *
+ */
+void AdcQueue_ReleaseBlock(adcQueueBlock_t *block);
+
+/**
+ * @brief Gets the number of blocks waiting the consumer.
+ *
+ * @return The ready blocks.
+ *
+ */
+uint32_t AdcQueue_GetReadyCount(void);
+
+/**
+ * @brief Copies the queue counters.
+ *
+ * @param stats - where the counters will be copied.
+ *
+ */
+void AdcQueue_GetStats(adcQueueStats_t *stats);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* ADC_QUEUE_H_ */
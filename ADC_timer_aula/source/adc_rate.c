@@ -0,0 +1,337 @@
+/**
+ * @file	adc_rate.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * ADC sample rate service: chooses and programs the hardware trigger.
+ *
+ * For each timer and prescaler the count is the rounded clock / (divider
+ * * rate), which is the best one for that divider; the search is then
+ * only over the prescalers (8 for the TPM, 17 for each LPTMR clock).
+ * PIT0 and PIT1, as well as the three TPMs, share the same clock, so only
+ * the first allowed of each group is evaluated.
+ *
+ * The PIT and LPTMR are programmed at register level, since their SDK
+ * drivers are not part of the project.
+ *
+ */
+
+#include "adc_rate.h"
+#include "fsl_clock.h"
+#include "fsl_tpm.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define ADC_RATE_TPM_MAX_COUNT   0x10000UL
+#define ADC_RATE_TPM_MAX_LOG2    7U        /*!< Prescaler up to 128.*/
+#define ADC_RATE_LPTMR_MAX_COUNT 0x10000UL
+#define ADC_RATE_LPTMR_MAX_LOG2  16U       /*!< Prescaler up to 65536.*/
+#define ADC_RATE_PIT_MAX_COUNT   0xFFFFFFFFULL
+
+/*!< LPTMR PSR PCS values.*/
+#define ADC_RATE_LPTMR_MCGIRCLK 0U
+#define ADC_RATE_LPTMR_LPO      1U
+#define ADC_RATE_LPTMR_OSCERCLK 3U
+
+/*!< Best setting found by the planner.*/
+typedef struct{
+	adcRatePlan_t plan;
+	uint64_t error_mHz;
+	bool found;
+}adcRateSearch_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Evaluates the best count for a clock and divider, keeping it if
+ *        its error is smaller than the best one.
+ *
+ */
+static void Evaluate(adcRateSearch_t *search, uint32_t rate_Hz, adcRateTrigger_t trigger, uint32_t clock_Hz,
+                     uint32_t divider, uint32_t minCount, uint64_t maxCount, uint8_t clockSelect);
+
+/**
+ * @brief Gets the TPM counter clock, selected by SIM_SOPT2 TPMSRC.
+ *
+ */
+static uint32_t GetTpmClock(void);
+
+/**
+ * @brief Gets log2 of a power of two.
+ *
+ */
+static inline uint32_t Log2(uint32_t value);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static TPM_Type *const s_tpmBases[] = TPM_BASE_PTRS;
+
+static adcRateTrigger_t s_trigger;
+static bool s_running = false;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void Evaluate(adcRateSearch_t *search, uint32_t rate_Hz, adcRateTrigger_t trigger, uint32_t clock_Hz,
+                     uint32_t divider, uint32_t minCount, uint64_t maxCount, uint8_t clockSelect)
+{
+	uint64_t denominator = (uint64_t)divider * rate_Hz;
+	uint64_t count = ((uint64_t)clock_Hz + denominator / 2U) / denominator;
+	uint64_t period, target_mHz, achieved_mHz, error_mHz;
+
+	if(count < minCount)
+	{
+		count = minCount;
+	}
+	if(count > maxCount)
+	{
+		return;
+	}
+
+	/* In 64 bits: with short periods the achieved rate can pass 32 bits. */
+	period = (uint64_t)divider * count;
+	target_mHz = (uint64_t)rate_Hz * 1000U;
+	achieved_mHz = ((uint64_t)clock_Hz * 1000U + period / 2U) / period;
+	if(achieved_mHz > UINT32_MAX)
+	{
+		/* Can not be reported in the plan. */
+		return;
+	}
+	error_mHz = (achieved_mHz > target_mHz) ? (achieved_mHz - target_mHz) : (target_mHz - achieved_mHz);
+
+	/* Strictly smaller: on a tie the finer resolution, evaluated first, stays. */
+	if(!search->found || (error_mHz < search->error_mHz))
+	{
+		search->found = true;
+		search->error_mHz = error_mHz;
+		search->plan.trigger = trigger;
+		search->plan.achieved_mHz = (uint32_t)achieved_mHz;
+		search->plan.clock_Hz = clock_Hz;
+		search->plan.divider = divider;
+		search->plan.count = (uint32_t)count;
+		search->plan.clockSelect = clockSelect;
+	}
+}
+
+static uint32_t GetTpmClock(void)
+{
+	switch((SIM->SOPT2 & SIM_SOPT2_TPMSRC_MASK) >> SIM_SOPT2_TPMSRC_SHIFT)
+	{
+		case 1U:
+			return CLOCK_GetFreq(kCLOCK_PllFllSelClk);
+		case 2U:
+			return CLOCK_GetFreq(kCLOCK_Osc0ErClk);
+		case 3U:
+			return CLOCK_GetFreq(kCLOCK_McgInternalRefClk);
+		default:
+			return 0U;
+	}
+}
+
+static inline uint32_t Log2(uint32_t value)
+{
+	uint32_t log2 = 0U;
+
+	while(value > 1U)
+	{
+		value >>= 1U;
+		log2++;
+	}
+
+	return log2;
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t AdcRate_Plan(uint32_t rate_Hz, uint32_t allowed, adcRatePlan_t *plan)
+{
+	static const uint8_t lptmrClocks[] = {ADC_RATE_LPTMR_MCGIRCLK, ADC_RATE_LPTMR_OSCERCLK, ADC_RATE_LPTMR_LPO};
+	static const clock_name_t lptmrClockNames[] = {kCLOCK_McgInternalRefClk, kCLOCK_Osc0ErClk, kCLOCK_LpoClk};
+	adcRateSearch_t search;
+	adcRateTrigger_t trigger;
+	uint32_t clock_Hz, i, log2;
+
+	/* The rate in mHz must fit in 32 bits. */
+	if((plan == NULL) || (rate_Hz == 0U) || (rate_Hz > (UINT32_MAX / 1000U)) || ((allowed & kAdcRate_AllowAll) == 0U))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	search.found = false;
+	search.error_mHz = UINT64_MAX;
+
+	if(allowed & (kAdcRate_AllowPit0 | kAdcRate_AllowPit1))
+	{
+		trigger = (allowed & kAdcRate_AllowPit0) ? kAdcRate_TriggerPit0 : kAdcRate_TriggerPit1;
+		clock_Hz = CLOCK_GetFreq(kCLOCK_BusClk);
+		if(clock_Hz != 0U)
+		{
+			Evaluate(&search, rate_Hz, trigger, clock_Hz, 1U, 1U, ADC_RATE_PIT_MAX_COUNT, 0U);
+		}
+	}
+
+	if(allowed & (kAdcRate_AllowTpm0 | kAdcRate_AllowTpm1 | kAdcRate_AllowTpm2))
+	{
+		trigger = (allowed & kAdcRate_AllowTpm0) ? kAdcRate_TriggerTpm0 :
+		          ((allowed & kAdcRate_AllowTpm1) ? kAdcRate_TriggerTpm1 : kAdcRate_TriggerTpm2);
+		clock_Hz = GetTpmClock();
+		for(log2 = 0U; (clock_Hz != 0U) && (log2 <= ADC_RATE_TPM_MAX_LOG2); log2++)
+		{
+			Evaluate(&search, rate_Hz, trigger, clock_Hz, 1UL << log2, 1U, ADC_RATE_TPM_MAX_COUNT, 0U);
+		}
+	}
+
+	if(allowed & kAdcRate_AllowLptmr0)
+	{
+		for(i = 0U; i < ARRAY_SIZE(lptmrClocks); i++)
+		{
+			clock_Hz = CLOCK_GetFreq(lptmrClockNames[i]);
+			/* CMR = 0 would keep the trigger asserted: at least 2 counts. */
+			for(log2 = 0U; (clock_Hz != 0U) && (log2 <= ADC_RATE_LPTMR_MAX_LOG2); log2++)
+			{
+				Evaluate(&search, rate_Hz, kAdcRate_TriggerLptmr0, clock_Hz, 1UL << log2, 2U,
+				         ADC_RATE_LPTMR_MAX_COUNT, lptmrClocks[i]);
+			}
+		}
+	}
+
+	if(!search.found)
+	{
+		return kStatus_OutOfRange;
+	}
+
+	*plan = search.plan;
+
+	return kStatus_Success;
+}
+
+void AdcRate_Apply(const adcRatePlan_t *plan)
+{
+	tpm_config_t tpmConfig;
+	TPM_Type *tpm;
+	uint32_t channel;
+
+	AdcRate_Stop();
+
+	switch(plan->trigger)
+	{
+		case kAdcRate_TriggerPit0:
+		case kAdcRate_TriggerPit1:
+			channel = (uint32_t)plan->trigger - (uint32_t)kAdcRate_TriggerPit0;
+			CLOCK_EnableClock(kCLOCK_Pit0);
+			PIT->MCR &= ~PIT_MCR_MDIS_MASK;
+			PIT->CHANNEL[channel].TCTRL = 0U;
+			PIT->CHANNEL[channel].LDVAL = plan->count - 1U;
+			PIT->CHANNEL[channel].TFLG = PIT_TFLG_TIF_MASK;
+			PIT->CHANNEL[channel].TCTRL = PIT_TCTRL_TEN_MASK;
+			break;
+
+		case kAdcRate_TriggerTpm0:
+		case kAdcRate_TriggerTpm1:
+		case kAdcRate_TriggerTpm2:
+			tpm = s_tpmBases[(uint32_t)plan->trigger - (uint32_t)kAdcRate_TriggerTpm0];
+			TPM_GetDefaultConfig(&tpmConfig);
+			tpmConfig.prescale = (tpm_clock_prescale_t)Log2(plan->divider);
+			TPM_Init(tpm, &tpmConfig);
+			TPM_SetTimerPeriod(tpm, plan->count - 1U);
+			tpm->CNT = 0U;
+			TPM_StartTimer(tpm, kTPM_SystemClock);
+			break;
+
+		default:
+			CLOCK_EnableClock(kCLOCK_Lptmr0);
+			LPTMR0->CSR = 0U;
+			LPTMR0->PSR = LPTMR_PSR_PCS(plan->clockSelect) |
+			              ((plan->divider == 1U) ? LPTMR_PSR_PBYP_MASK : LPTMR_PSR_PRESCALE(Log2(plan->divider) - 1U));
+			LPTMR0->CMR = plan->count - 1U;
+			LPTMR0->CSR = LPTMR_CSR_TEN_MASK | LPTMR_CSR_TIE_MASK | LPTMR_CSR_TCF_MASK;
+			EnableIRQ(LPTMR0_IRQn);
+			break;
+	}
+
+	SIM->SOPT7 = (SIM->SOPT7 & ~(SIM_SOPT7_ADC0TRGSEL_MASK | SIM_SOPT7_ADC0PRETRGSEL_MASK)) |
+	             SIM_SOPT7_ADC0ALTTRGEN_MASK | SIM_SOPT7_ADC0TRGSEL(plan->trigger);
+
+	s_trigger = plan->trigger;
+	s_running = true;
+}
+
+status_t AdcRate_SetSampleRate(uint32_t rate_Hz, uint32_t allowed, uint32_t *achieved_mHz)
+{
+	adcRatePlan_t plan;
+	status_t status;
+
+	status = AdcRate_Plan(rate_Hz, allowed, &plan);
+	if(status != kStatus_Success)
+	{
+		return status;
+	}
+
+	AdcRate_Apply(&plan);
+	if(achieved_mHz != NULL)
+	{
+		*achieved_mHz = plan.achieved_mHz;
+	}
+
+	return kStatus_Success;
+}
+
+void AdcRate_Stop(void)
+{
+	if(!s_running)
+	{
+		return;
+	}
+
+	switch(s_trigger)
+	{
+		case kAdcRate_TriggerPit0:
+		case kAdcRate_TriggerPit1:
+			PIT->CHANNEL[(uint32_t)s_trigger - (uint32_t)kAdcRate_TriggerPit0].TCTRL = 0U;
+			break;
+
+		case kAdcRate_TriggerTpm0:
+		case kAdcRate_TriggerTpm1:
+		case kAdcRate_TriggerTpm2:
+			TPM_StopTimer(s_tpmBases[(uint32_t)s_trigger - (uint32_t)kAdcRate_TriggerTpm0]);
+			break;
+
+		default:
+			DisableIRQ(LPTMR0_IRQn);
+			LPTMR0->CSR = LPTMR_CSR_TCF_MASK;
+			break;
+	}
+
+	s_running = false;
+}
+
+void AdcRate_IRQHandler(void)
+{
+	/* TCF is write 1 to clear; its clear ends the trigger pulse. */
+	LPTMR0->CSR |= LPTMR_CSR_TCF_MASK;
+}
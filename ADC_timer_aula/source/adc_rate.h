@@ -0,0 +1,159 @@
+/**
+ * @file	adc_rate.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * ADC sample rate service: chooses and programs the hardware trigger.
+ *
+ * The ADC0 alternate triggers (SIM_SOPT7) that give a periodic rate are:
+ *
+ *   0x4, 0x5  PIT channel 0 or 1: bus clock, 32 bits, no prescaler;
+ *   0x8-0xA   TPM0, TPM1 or TPM2 overflow: TPM clock (SIM_SOPT2 TPMSRC),
+ *             prescaler 1 to 128, 16 bits;
+ *   0xE       LPTMR0 compare: LPO, MCGIRCLK or OSCERCLK, prescaler 1 to
+ *             65536, 16 bits. It also runs in the stop modes.
+ *
+ * AdcRate_Plan() computes, for each allowed timer, the divider and count
+ * closest to the requested rate, and takes the one with the smallest
+ * error. On a tie the finest resolution wins, in the order PIT, TPM,
+ * LPTMR, since the PIT and TPM triggers need no CPU and are clocked by
+ * the PLL, while the LPO has a large jitter. The rate achieved is reported
+ * in mHz.
+ *
+ * The LPTMR trigger is its compare flag, which must be cleared at every
+ * period: AdcRate_IRQHandler() does it and must be called from
+ * LPTMR0_IRQHandler(). The other timers run without interrupts.
+ *
+ */
+
+#ifndef ADC_RATE_H_
+#define ADC_RATE_H_
+
+#include <stdint.h>
+#include "fsl_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup adc_rate
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Trigger sources, with their SIM_SOPT7 ADC0TRGSEL values.*/
+typedef enum{
+	kAdcRate_TriggerPit0 = 0x4U,
+	kAdcRate_TriggerPit1 = 0x5U,
+	kAdcRate_TriggerTpm0 = 0x8U,
+	kAdcRate_TriggerTpm1 = 0x9U,
+	kAdcRate_TriggerTpm2 = 0xAU,
+	kAdcRate_TriggerLptmr0 = 0xEU,
+}adcRateTrigger_t;
+
+/*!< Timers that can be used (bit mask), to leave out the ones in use.*/
+enum _adc_rate_allow{
+	kAdcRate_AllowPit0 = (1U << 0),
+	kAdcRate_AllowPit1 = (1U << 1),
+	kAdcRate_AllowTpm0 = (1U << 2),
+	kAdcRate_AllowTpm1 = (1U << 3),
+	kAdcRate_AllowTpm2 = (1U << 4),
+	kAdcRate_AllowLptmr0 = (1U << 5),
+	kAdcRate_AllowAll = 0x3FU,
+};
+
+/*!
+ * @brief A trigger setting.
+ */
+typedef struct{
+	adcRateTrigger_t trigger;
+	uint32_t achieved_mHz; /*!< Rate achieved, in mHz.*/
+	uint32_t clock_Hz;     /*!< Timer clock.*/
+	uint32_t divider;      /*!< Prescaler division, 1 for the PIT.*/
+	uint32_t count;        /*!< Prescaled clocks per sample (the modulus plus one).*/
+	uint8_t clockSelect;   /*!< LPTMR PSR PCS value.*/
+}adcRatePlan_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Computes the best trigger setting for a sample rate, with the
+ *        current clock configuration.
+ *
+ * @param rate_Hz - the requested rate.
+ * @param allowed - the timers that can be used (_adc_rate_allow mask).
+ * @param plan    - where the setting is stored.
+ *
+ * @return kStatus_Success if a setting was found;
+ *         kStatus_OutOfRange if no allowed timer reaches the rate;
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t AdcRate_Plan(uint32_t rate_Hz, uint32_t allowed, adcRatePlan_t *plan);
+
+/**
+ * @brief Programs and starts the timer of a plan and selects it as the
+ *        ADC0 trigger. The previous trigger timer is stopped.
+ *
+ *        The ADC hardware trigger (ADTRG) is enabled by the ADC user.
+ *
+ * @param plan - the setting, from AdcRate_Plan().
+ *
+ */
+void AdcRate_Apply(const adcRatePlan_t *plan);
+
+/**
+ * @brief Plans and applies a sample rate.
+ *
+ * @param rate_Hz      - the requested rate.
+ * @param allowed      - the timers that can be used (_adc_rate_allow mask).
+ * @param achieved_mHz - where the rate achieved is stored, can be NULL.
+ *
+ * @return The AdcRate_Plan() status. The trigger is not changed on error.
+ *
+ */
+status_t AdcRate_SetSampleRate(uint32_t rate_Hz, uint32_t allowed, uint32_t *achieved_mHz);
+
+/**
+ * @brief Stops the trigger timer.
+ *
+ */
+void AdcRate_Stop(void);
+
+/**
+ * @brief Clears the LPTMR compare flag.
+ *
+ *        Must be called from LPTMR0_IRQHandler() when the LPTMR is used.
+ *
+ */
+void AdcRate_IRQHandler(void);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* ADC_RATE_H_ */
@@ -0,0 +1,240 @@
+/**
+ * @file	adc_stream.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Continuous ADC sampling into ping-pong buffers by DMA.
+ *
+ * The KL25Z DMA has no half transfer interrupt nor descriptor chaining,
+ * so one channel fills one buffer and, when its byte count is exhausted,
+ * the DMA done interrupt points it to the other buffer. The channel
+ * request is disabled by the hardware at the end of the buffer (D_REQ),
+ * so a conversion completed before the reload waits in the ADC result
+ * register (COCO set) and is moved as soon as the request is enabled
+ * again: no sample is lost if the interrupt latency is shorter than one
+ * sample period.
+ *
+ */
+
+#include "adc_stream.h"
+#include "fsl_dmamux.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define ADC_STREAM_MAX_BCR 0xFFFFFU /*!< 20 bits byte count.*/
+
+/*!< Buffer ownership.*/
+typedef enum{
+	kAdcStream_BufferFree = 0U, /*!< Can be filled.*/
+	kAdcStream_BufferFilling,   /*!< Being filled by the DMA.*/
+	kAdcStream_BufferReady,     /*!< Full, not got by the application yet.*/
+	kAdcStream_BufferInUse,     /*!< Full, being used by the application.*/
+}adcStreamBufferState_t;
+
+/*!< Stream runtime data.*/
+typedef struct{
+	ADC_Type *base;
+	uint8_t sc1;                 /*!< ADCH and DIFF, without AIEN.*/
+	bool hardwareTrigger;
+	uint16_t *buffers[2];
+	uint16_t samples;
+	volatile adcStreamBufferState_t states[2];
+	uint8_t filling;             /*!< Buffer being filled.*/
+	dma_handle_t dma;
+	adcStreamCallback_t callback;
+	void *userData;
+	adcStreamStats_t stats;
+}adcStreamHandle_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief DMA done: switches to the other buffer and delivers the full one.
+ *
+ */
+static void DmaCallback(dma_handle_t *handle, void *userData);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static adcStreamHandle_t s_stream;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+status_t AdcStream_Init(const adcStreamConfig_t *config)
+{
+	dma_transfer_config_t transferConfig;
+
+	if((config == NULL) || (config->base == NULL) || (config->buffer == NULL) ||
+	   (config->samplesPerBuffer == 0U) ||
+	   ((config->samplesPerBuffer * sizeof(uint16_t)) > ADC_STREAM_MAX_BCR) ||
+	   (config->dmaChannel >= FSL_FEATURE_DMA_MODULE_CHANNEL))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	memset(&s_stream, 0, sizeof(s_stream));
+	s_stream.base = config->base;
+	s_stream.sc1 = ADC_SC1_ADCH(config->channelNumber) | ADC_SC1_DIFF(config->enableDifferential ? 1U : 0U);
+	s_stream.hardwareTrigger = config->enableHardwareTrigger;
+	s_stream.buffers[0] = config->buffer;
+	s_stream.buffers[1] = config->buffer + config->samplesPerBuffer;
+	s_stream.samples = config->samplesPerBuffer;
+	s_stream.callback = config->callback;
+	s_stream.userData = config->userData;
+
+	DMAMUX_Init(DMAMUX0);
+	DMA_Init(DMA0);
+
+	DMAMUX_DisableChannel(DMAMUX0, config->dmaChannel);
+	DMAMUX_SetSource(DMAMUX0, config->dmaChannel, kDmaRequestMux0ADC0 & 0xFFU);
+	DMAMUX_EnableChannel(DMAMUX0, config->dmaChannel);
+
+	DMA_CreateHandle(&s_stream.dma, DMA0, config->dmaChannel);
+	DMA_SetCallback(&s_stream.dma, DmaCallback, &s_stream);
+	DMA_PrepareTransfer(&transferConfig, (void *)&config->base->R[0], sizeof(uint16_t),
+	                    s_stream.buffers[0], sizeof(uint16_t),
+	                    config->samplesPerBuffer * sizeof(uint16_t), kDMA_PeripheralToMemory);
+	/* Cycle steal and request disabled at the end of each buffer (D_REQ). */
+	DMA_SubmitTransfer(&s_stream.dma, &transferConfig, kDMA_EnableInterrupt);
+
+	return kStatus_Success;
+}
+
+void AdcStream_Start(void)
+{
+	ADC_Type *base = s_stream.base;
+
+	DMA_DisableChannelRequest(DMA0, s_stream.dma.channel);
+	DMA_ClearChannelStatusFlags(DMA0, s_stream.dma.channel, kDMA_TransactionsDoneFlag);
+	DMA_SetDestinationAddress(DMA0, s_stream.dma.channel, (uint32_t)s_stream.buffers[0]);
+	DMA_SetTransferSize(DMA0, s_stream.dma.channel, s_stream.samples * sizeof(uint16_t));
+	s_stream.states[0] = kAdcStream_BufferFilling;
+	s_stream.states[1] = kAdcStream_BufferFree;
+	s_stream.filling = 0U;
+
+	/* A stale result would be the first sample. */
+	(void)base->R[0];
+	DMA_EnableChannelRequest(DMA0, s_stream.dma.channel);
+	base->SC2 |= ADC_SC2_DMAEN_MASK;
+
+	if(s_stream.hardwareTrigger)
+	{
+		base->SC3 &= ~(ADC_SC3_ADCO_MASK | ADC_SC3_CALF_MASK);
+		base->SC2 |= ADC_SC2_ADTRG_MASK;
+	}
+	else
+	{
+		base->SC2 &= ~ADC_SC2_ADTRG_MASK;
+		base->SC3 = (base->SC3 & ~ADC_SC3_CALF_MASK) | ADC_SC3_ADCO_MASK;
+	}
+	/* Starts the continuous conversions, or arms the hardware trigger. */
+	base->SC1[0] = s_stream.sc1;
+}
+
+void AdcStream_Stop(void)
+{
+	ADC_Type *base = s_stream.base;
+
+	/* ADCH = 0x1F stops the conversions. */
+	base->SC1[0] = ADC_SC1_ADCH_MASK;
+	base->SC2 &= ~ADC_SC2_DMAEN_MASK;
+	base->SC3 &= ~(ADC_SC3_ADCO_MASK | ADC_SC3_CALF_MASK);
+	DMA_AbortTransfer(&s_stream.dma);
+}
+
+uint16_t *AdcStream_GetBuffer(uint16_t *count)
+{
+	uint16_t *samples = NULL;
+	uint32_t primask = DisableGlobalIRQ();
+	uint8_t ready = s_stream.filling ^ 1U;
+
+	/* Only the buffer not being filled can be ready. */
+	if(s_stream.states[ready] == kAdcStream_BufferReady)
+	{
+		s_stream.states[ready] = kAdcStream_BufferInUse;
+		samples = s_stream.buffers[ready];
+	}
+	EnableGlobalIRQ(primask);
+
+	if(count != NULL)
+	{
+		*count = s_stream.samples;
+	}
+
+	return samples;
+}
+
+void AdcStream_ReleaseBuffer(uint16_t *samples)
+{
+	uint32_t primask = DisableGlobalIRQ();
+	uint8_t index = (samples == s_stream.buffers[0]) ? 0U : 1U;
+
+	/* After an overrun the DMA may already be filling it again. */
+	if(s_stream.states[index] != kAdcStream_BufferFilling)
+	{
+		s_stream.states[index] = kAdcStream_BufferFree;
+	}
+	EnableGlobalIRQ(primask);
+}
+
+void AdcStream_GetStats(adcStreamStats_t *stats)
+{
+	uint32_t primask = DisableGlobalIRQ();
+
+	*stats = s_stream.stats;
+	EnableGlobalIRQ(primask);
+}
+
+static void DmaCallback(dma_handle_t *handle, void *userData)
+{
+	adcStreamHandle_t *stream = (adcStreamHandle_t *)userData;
+	uint8_t full = stream->filling;
+	uint8_t next = full ^ 1U;
+	uint32_t events = kAdcStream_EventBufferFull;
+
+	/* First the DMA, to keep the latency short: DONE was cleared by
+	 * DMA_HandleIRQ() and the request was disabled at the end of the buffer. */
+	DMA_SetDestinationAddress(handle->base, handle->channel, (uint32_t)stream->buffers[next]);
+	DMA_SetTransferSize(handle->base, handle->channel, stream->samples * sizeof(uint16_t));
+	DMA_EnableChannelRequest(handle->base, handle->channel);
+
+	if(stream->states[next] != kAdcStream_BufferFree)
+	{
+		/* The application is late: its buffer is being overwritten. */
+		stream->stats.overruns++;
+		events |= kAdcStream_EventOverrun;
+	}
+	stream->states[next] = kAdcStream_BufferFilling;
+	stream->states[full] = kAdcStream_BufferReady;
+	stream->filling = next;
+	stream->stats.buffers++;
+
+	if(stream->callback != NULL)
+	{
+		stream->callback(stream->buffers[full], stream->samples, events, stream->userData);
+	}
+}
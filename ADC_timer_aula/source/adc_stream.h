@@ -0,0 +1,154 @@
+/**
+ * @file	adc_stream.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Continuous ADC sampling into two alternate (ping-pong) buffers by DMA.
+ *
+ * Each conversion result is moved by the DMA, so the CPU is interrupted
+ * only once per buffer of N samples, when the DMA switches to the other
+ * buffer. The full buffer is then delivered to the application, through
+ * the callback or AdcStream_GetBuffer(), and must be given back with
+ * AdcStream_ReleaseBuffer(). If the DMA has to fill a buffer not given
+ * back yet, the samples are overwritten and an overrun is reported.
+ *
+ * The conversions are started by the hardware trigger (selected in
+ * SIM_SOPT7) or run continuously (ADCO) at the rate given by the ADC
+ * clock and sample time.
+ *
+ * The ADC must be previously initialized and calibrated with the fsl_adc16
+ * driver. The DMA interrupt is handled by the fsl_dma driver.
+ *
+ */
+
+#ifndef ADC_STREAM_H_
+#define ADC_STREAM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "fsl_adc16.h"
+#include "fsl_dma.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup adc_stream
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Events reported to the callback (bit mask).*/
+enum _adc_stream_events{
+	kAdcStream_EventBufferFull = (1U << 0), /*!< A buffer is ready.*/
+	kAdcStream_EventOverrun = (1U << 1),    /*!< The ready buffer overwrote one not released.*/
+};
+
+/*!< Buffer ready callback, called in interrupt context. samples is the
+ *   full buffer, to be released with AdcStream_ReleaseBuffer().*/
+typedef void (*adcStreamCallback_t)(uint16_t *samples, uint16_t count, uint32_t events, void *userData);
+
+/*!
+ * @brief Stream configuration structure.
+ */
+typedef struct{
+	ADC_Type *base;              /*!< ADC peripheral base address.*/
+	uint8_t channelNumber;       /*!< ADCH value.*/
+	bool enableDifferential;     /*!< Differential conversion.*/
+	bool enableHardwareTrigger;  /*!< Conversions started by the hardware trigger,
+	                                  else continuous conversions.*/
+	uint8_t dmaChannel;          /*!< DMA channel used.*/
+	uint16_t *buffer;            /*!< Memory for the two buffers (2 * samplesPerBuffer).*/
+	uint16_t samplesPerBuffer;   /*!< Samples in each buffer.*/
+	adcStreamCallback_t callback; /*!< Buffer ready callback, can be NULL.*/
+	void *userData;              /*!< Parameter passed to the callback.*/
+}adcStreamConfig_t;
+
+/*!< Stream counters.*/
+typedef struct{
+	uint32_t buffers;  /*!< Buffers filled.*/
+	uint32_t overruns; /*!< Buffers overwritten before being released.*/
+}adcStreamStats_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Configures the stream. The sampling starts with AdcStream_Start().
+ *
+ * @param config - the configuration.
+ *
+ * @return kStatus_Success if configured;
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t AdcStream_Init(const adcStreamConfig_t *config);
+
+/**
+ * @brief Starts the sampling, filling the first buffer.
+ *
+ */
+void AdcStream_Start(void);
+
+/**
+ * @brief Stops the sampling. The buffer being filled is discarded.
+ *
+ */
+void AdcStream_Stop(void);
+
+/**
+ * @brief Gets the oldest full buffer not got yet, without blocking.
+ *
+ * @param count - where the number of samples is stored, can be NULL.
+ *
+ * @return The buffer, to be released with AdcStream_ReleaseBuffer(),
+ *         or NULL if there is none.
+ *
+ */
+uint16_t *AdcStream_GetBuffer(uint16_t *count);
+
+/**
+ * @brief Gives a buffer back, so the DMA can fill it again.
+ *
+ * @param samples - a buffer delivered by the callback or AdcStream_GetBuffer().
+ *
+ */
+void AdcStream_ReleaseBuffer(uint16_t *samples);
+
+/**
+ * @brief Copies the stream counters.
+ *
+ * @param stats - where the counters will be copied.
+ *
+ */
+void AdcStream_GetStats(adcStreamStats_t *stats);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* ADC_STREAM_H_ */
@@ -43,17 +43,22 @@
 #include "fsl_tpm.h"
 #include "fsl_adc16.h"
 #include "stdbool.h"
+#include "adc_cal.h"
+#include "adc_rate.h"
+#include "adc_queue.h"
 
 /* TODO: insert other definitions and declarations here. */
 #define MY_ADC_GROUP 0U
 #define MY_ADC_CHANNEL 0U /*PTE20, ADC0_SE0 */
+#define MY_ADC_SAMPLE_RATE_HZ 6U /* Taxa de amostragem do ADC. */
+#define MY_ADC_QUEUE_BLOCKS 4U /* Blocos da fila (potência de 2). */
+#define MY_ADC_BLOCK_SAMPLES 4U /* Amostras por bloco. */
 
 /*******************************************************************************
  * Variables
  ******************************************************************************/
-volatile bool g_AdcConversionDoneFlag = false;
-volatile uint32_t g_AdcConversionValue;
-volatile uint32_t g_AdcInterruptCounter;
+adcQueueBlock_t g_AdcBlocks[MY_ADC_QUEUE_BLOCKS];
+uint16_t g_AdcSamples[MY_ADC_QUEUE_BLOCKS * MY_ADC_BLOCK_SAMPLES];
 
 /*******************************************************************************
  * Code
@@ -62,30 +67,13 @@ volatile uint32_t g_AdcInterruptCounter;
 void ADC0_IRQHandler(void)
 {
     /* Read conversion result to clear the conversion completed flag. */
-    g_AdcConversionValue = ADC16_GetChannelConversionValue(ADC0, MY_ADC_GROUP);
-    if((++g_AdcInterruptCounter)%4 == 0)
-    {
-    	g_AdcConversionDoneFlag = true;
-    }
+    AdcQueue_PutSample((uint16_t)ADC16_GetChannelConversionValue(ADC0, MY_ADC_GROUP));
 }
 
-/*
- * ADC0 trigger select
-Selects the ADC0 trigger source when alternative triggers are functional in stop and VLPS modes. .
-0x0 External trigger pin input (EXTRG_IN)
-0x1 CMP0 output
-0x4 PIT trigger 0
-0x5 PIT trigger 1
-0x8 TPM0 overflow
-0x9 TPM1 overflow
-0xA TPM2 overflow
-0xC RTC alarm
-0xD RTC seconds
-0xE LPTMR0 trigger*/
-void BOARD_ConfigADCTriggerSource(uint8_t hwTrigger)
+void LPTMR0_IRQHandler(void)
 {
-    /* Configure SIM for ADC hw trigger source selection */
-    SIM->SOPT7 |= (0x00000080U | hwTrigger);
+    /* Usado somente se o LPTMR for o gatilho do ADC. */
+    AdcRate_IRQHandler();
 }
 
 /*
@@ -96,40 +84,46 @@ int main(void) {
     adc16_config_t adc16ConfigStruct;
     adc16_channel_config_t adc16ChannelConfigStruct;
 
-    tpm_config_t tpm0_config;
+    adcCalSource_t calSource;
+    uint32_t achievedRate_mHz;
+
+    adcQueueConfig_t queueConfig = {0};
+    adcQueueBlock_t *block;
+    uint32_t i;
 
   	/* Init board hardware. */
     BOARD_InitBootPins();
     BOARD_InitBootClocks();
     BOARD_InitBootPeripherals();
-    BOARD_ConfigADCTriggerSource(0x8); // Selecionado TPM0 como fonte de gatilho do ADC
   	/* Init FSL debug console. */
     BOARD_InitDebugConsole();
 
     /* Resultados da conversão serão impressos em console de depuração. */
     PRINTF("\r\nADC16 timer Example.\r\n");
 
+    /* Fila de blocos de amostras, preenchida pela interrupção do ADC. */
+    queueConfig.blocks = g_AdcBlocks;
+    queueConfig.blocksCount = MY_ADC_QUEUE_BLOCKS;
+    queueConfig.samples = g_AdcSamples;
+    queueConfig.samplesPerBlock = MY_ADC_BLOCK_SAMPLES;
+    AdcQueue_Init(&queueConfig);
+
     EnableIRQ(ADC0_IRQn); /* Habilita interrupção pelo NVIC. */
 
-    TPM_GetDefaultConfig(&tpm0_config);
-    tpm0_config.prescale = kTPM_Prescale_Divide_128;
-    TPM_Init(TPM0, &tpm0_config);
     CLOCK_SetTpmClock(1);
-    TPM_SetTimerPeriod(TPM0, 0xFFFFU);
-    TPM_EnableInterrupts(TPM0, kTPM_TimeOverflowInterruptEnable);
 
     ADC16_GetDefaultConfig(&adc16ConfigStruct);
     ADC16_Init(ADC0, &adc16ConfigStruct);
     ADC16_EnableHardwareTrigger(ADC0, true); /* Garante que o disparo de hardware está sendo utilizado. */
 
-    /* Realiza a calibração do do ADC. */
-    if (kStatus_Success == ADC16_DoAutoCalibration(ADC0))
+    /* Realiza a calibração do do ADC, ou a recupera da flash. */
+    if (kStatus_Success == AdcCal_Restore(ADC0, NULL, NULL, &calSource))
     {
-        PRINTF("ADC16_DoAutoCalibration() Done.\r\n");
+        PRINTF("ADC16 calibration %s.\r\n", (calSource == kAdcCal_FromFlash) ? "loaded" : "done");
     }
     else
     {
-        PRINTF("ADC16_DoAutoCalibration() Failed.\r\n");
+        PRINTF("ADC16 calibration Failed.\r\n");
     }
 
     adc16ChannelConfigStruct.channelNumber = MY_ADC_CHANNEL;
@@ -137,19 +131,32 @@ int main(void) {
     adc16ChannelConfigStruct.enableDifferentialConversion = false;
     ADC16_SetChannelConfig(ADC0, MY_ADC_GROUP, &adc16ChannelConfigStruct);
 
-    TPM_StartTimer(TPM0, kTPM_SystemClock);
+    /* Escolhe o temporizador (PIT, TPM ou LPTMR) que gera a taxa com menor erro. */
+    if (kStatus_Success == AdcRate_SetSampleRate(MY_ADC_SAMPLE_RATE_HZ, kAdcRate_AllowAll, &achievedRate_mHz))
+    {
+        PRINTF("ADC sample rate: %u.%03u Hz.\r\n", achievedRate_mHz / 1000U, achievedRate_mHz % 1000U);
+    }
 
     while(true)
     {
-    	/* Espere pelo fim da conversão quando "ADC0_IRQHandler" irá
-    	   setar g_AdcConversionDoneFlag*/
-    	while (!g_AdcConversionDoneFlag)
+    	/* Espere por um bloco completo, publicado por "ADC0_IRQHandler". */
+    	while ((block = AdcQueue_GetBlock()) == NULL)
     	{
     	}
-        g_AdcConversionDoneFlag = false;
 
-        PRINTF("ADC Value: %d\t\t", g_AdcConversionValue);
-        PRINTF("ADC Interrupt Count: %d\r\n", g_AdcInterruptCounter);
+        PRINTF("ADC Sample %u:", block->firstSample);
+        for (i = 0U; i < block->count; i++)
+        {
+            PRINTF("\t%u", block->samples[i]);
+        }
+        if (block->lostBefore != 0U)
+        {
+            PRINTF("\t(%u lost)", block->lostBefore);
+        }
+        PRINTF("\r\n");
+
+        /* Devolve o bloco para a fila. */
+        AdcQueue_ReleaseBlock(block);
     }
 
     return 0 ;
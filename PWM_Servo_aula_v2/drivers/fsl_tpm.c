@@ -412,6 +412,29 @@ void TPM_UpdatePwmDutycycle(TPM_Type *base,
 #endif
 }
 
+void TPM_GetPwmTiming(TPM_Type *base, uint32_t srcClock_Hz, tpm_pwm_timing_t *timing)
+{
+    assert(timing);
+    assert(srcClock_Hz);
+
+    uint32_t tpmClock = (srcClock_Hz / (1U << (base->SC & TPM_SC_PS_MASK)));
+    uint32_t mod = base->MOD;
+
+    if (base->SC & TPM_SC_CPWMS_MASK)
+    {
+        /* Center aligned: the counter passes CnV twice per period, a pulse is 2 * CnV counts */
+        timing->cnvPerUsQ16 = (uint32_t)((((uint64_t)tpmClock << 16U) + 1000000U) / 2000000U);
+        timing->dutyScale = mod;
+    }
+    else
+    {
+        timing->cnvPerUsQ16 = (uint32_t)((((uint64_t)tpmClock << 16U) + 500000U) / 1000000U);
+        timing->dutyScale = mod + 1U;
+    }
+    /* CnV above MOD gives the 100% duty cycle */
+    timing->maxValue = (mod < 0xFFFFU) ? (uint16_t)(mod + 1U) : 0xFFFFU;
+}
+
 void TPM_UpdateChnlEdgeLevelSelect(TPM_Type *base, tpm_chnl_t chnlNumber, uint8_t level)
 {
     assert(chnlNumber < FSL_FEATURE_TPM_CHANNEL_COUNTn(base));
@@ -200,6 +200,19 @@ typedef struct _tpm_phase_param
 } tpm_phase_params_t;
 #endif
 
+/*!
+ * @brief PWM timing of a timer, read once by TPM_GetPwmTiming()
+ *
+ * Holds the factors that convert pulse widths and duty cycles to CnV values, so the conversions
+ * need only a multiplication and a shift.
+ */
+typedef struct _tpm_pwm_timing
+{
+    uint32_t cnvPerUsQ16; /*!< CnV counts per microsecond, Q16 */
+    uint32_t dutyScale;   /*!< CnV value of a 100% duty cycle: MOD + 1 (edge aligned) or MOD (center aligned) */
+    uint16_t maxValue;    /*!< Largest CnV value written, active signal during the whole period */
+} tpm_pwm_timing_t;
+
 /*! @brief TPM clock source selection*/
 typedef enum _tpm_clock_source
 {
@@ -382,6 +395,72 @@ void TPM_UpdatePwmDutycycle(TPM_Type *base,
                             tpm_pwm_mode_t currentPwmMode,
                             uint16_t dutyCyclePercent);
 
+/*!
+ * @brief Reads the PWM timing of a timer already configured by TPM_SetupPwm()
+ *
+ * The divisions are done here, so call it again only when the prescaler, MOD, the PWM mode or the
+ * clock change.
+ *
+ * @param base        TPM peripheral base address
+ * @param srcClock_Hz TPM counter clock in Hz, the same given to TPM_SetupPwm()
+ * @param timing      Pointer to the timing to be filled
+ */
+void TPM_GetPwmTiming(TPM_Type *base, uint32_t srcClock_Hz, tpm_pwm_timing_t *timing);
+
+/*!
+ * @brief Converts a pulse width to a CnV value
+ *
+ * @param timing   The timing read by TPM_GetPwmTiming()
+ * @param pulse_us Pulse width in microseconds
+ *
+ * @return The CnV value, limited to an active signal during the whole period
+ */
+static inline uint16_t TPM_PwmUsToTicks(const tpm_pwm_timing_t *timing, uint32_t pulse_us)
+{
+    uint64_t ticks = (((uint64_t)pulse_us * timing->cnvPerUsQ16) + 0x8000U) >> 16U;
+
+    return (ticks > timing->maxValue) ? timing->maxValue : (uint16_t)ticks;
+}
+
+/*!
+ * @brief Converts a duty cycle in Q16 to a CnV value
+ *
+ * @param timing  The timing read by TPM_GetPwmTiming()
+ * @param dutyQ16 Duty cycle, 0 (0%) to 65536 (100%)
+ *
+ * @return The CnV value
+ */
+static inline uint16_t TPM_PwmDutyToTicks(const tpm_pwm_timing_t *timing, uint32_t dutyQ16)
+{
+    uint32_t ticks;
+
+    if (dutyQ16 >= 0x10000U)
+    {
+        return timing->maxValue;
+    }
+    ticks = ((dutyQ16 * timing->dutyScale) + 0x8000U) >> 16U;
+
+    return (ticks > timing->maxValue) ? timing->maxValue : (uint16_t)ticks;
+}
+
+/*!
+ * @brief Writes the CnV value of an active PWM signal
+ *
+ * In the PWM modes the CnV writes are buffered by the TPM and take effect when the counter wraps
+ * from MOD to zero, so the new pulse starts in the next period and no period is cut short. To change
+ * several channels in the same period, write them from the overflow interrupt.
+ *
+ * @param base       TPM peripheral base address
+ * @param chnlNumber The channel number
+ * @param ticks      The CnV value, from TPM_PwmUsToTicks() or TPM_PwmDutyToTicks()
+ */
+static inline void TPM_UpdatePwmTicks(TPM_Type *base, tpm_chnl_t chnlNumber, uint16_t ticks)
+{
+    assert(chnlNumber < FSL_FEATURE_TPM_CHANNEL_COUNTn(base));
+
+    base->CONTROLS[chnlNumber].CnV = ticks;
+}
+
 /*!
  * @brief Update the edge level selection for a channel
  *
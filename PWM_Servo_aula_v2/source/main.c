@@ -40,15 +40,41 @@
 #include "MKL25Z4.h"
 #include "fsl_debug_console.h"
 #include "fsl_tpm.h"
-#include "delay.h"
+#include "servo_motion.h"
 /* TODO: insert other include files here. */
 //#define SET_TO_ZERO_DEGREE
 
 
 /* TODO: insert other definitions and declarations here. */
+#define SERVO_MIN_PULSE_US  500U  /* -90 graus */
+#define SERVO_MAX_PULSE_US  2400U /* +90 graus */
+
+#ifdef SET_TO_ZERO_DEGREE
+#define SERVO_INITIAL_ANGLE 0
+#else
+#define SERVO_INITIAL_ANGLE (-9000)
+#endif
+
 tpm_config_t tpm0_config;
 tpm_chnl_pwm_signal_param_t chnl_1_param = {kTPM_Chnl_1, kTPM_HighTrue, 0};
 
+/* Servo no canal 0 do TPM2, ângulos em centésimos de grau. */
+static const servoMotionServo_t g_servos[] = {
+    {TPM2, kTPM_Chnl_0, -9000, 9000, SERVO_MIN_PULSE_US, SERVO_MAX_PULSE_US, SERVO_INITIAL_ANGLE},
+};
+
+/* Vai e volta: até +90 graus em trapézio, de volta a -90 graus em curva S. */
+static const servoMotionMove_t g_moves[] = {
+    {9000, 180, 360, kServoMotion_Trapezoid},
+    {-9000, 180, 360, kServoMotion_SCurve},
+};
+
+void TPM2_IRQHandler(void)
+{
+    /* A cada período de 20 ms calcula o próximo pulso de cada servo. */
+    ServoMotion_IRQHandler();
+}
+
 /*
  * @brief   Application entry point.
  */
@@ -58,17 +84,14 @@ int main(void) {
 	tpm_chnl_pwm_signal_param_t chnl_0_param  =	{.chnlNumber 		= kTPM_Chnl_0,
 												 .level 	 		= kTPM_HighTrue,
 												 .dutyCyclePercent 	= 0};
-	/* Valor inicial para ser enviado ao servo.
-	 * Angulo de -90 graus == 2,5% de 65535*/
-	uint16_t currentDutyCycle = 1638;
+	servoMotionConfig_t motionConfig;
+	uint32_t nextMove = 0;
 
   	/* Init board hardware. */
     BOARD_InitBootPins();
     BOARD_InitBootClocks();
     BOARD_InitBootPeripherals();
 
-    Delay_Init();
-
     TPM_GetDefaultConfig(&tpm2_config);
     tpm2_config.prescale = kTPM_Prescale_Divide_128;
 
@@ -76,7 +99,7 @@ int main(void) {
     CLOCK_SetTpmClock(1);
 
     /* Frequência do PWM para o servo == 50 Hz.
-     * Período de contagem de 20 ms corresponde à 65535 (limite máximo do registrador contador).
+     * Período de 20 ms corresponde à 7500 contagens (48 MHz / 128 / 50 Hz).
      * Pulsos variam entre 0,5 ms (-90 graus, 2,5% de 20 ms) e 2,4 ms (+90 graus, 12% de 20 ms).
      * */
     TPM_SetupPwm(TPM2,
@@ -86,38 +109,28 @@ int main(void) {
      		    50,
      		    CLOCK_GetPllFllSelClkFreq());
 
+    /* O estouro do TPM2 executa o gerador de trajetórias. */
+    motionConfig.frameBase = TPM2;
+    motionConfig.srcClock_Hz = CLOCK_GetPllFllSelClkFreq();
+    motionConfig.servos = g_servos;
+    motionConfig.servosCount = ARRAY_SIZE(g_servos);
+    motionConfig.callback = NULL;
+    motionConfig.userData = NULL;
+    ServoMotion_Init(&motionConfig);
+
     TPM_StartTimer(TPM2, kTPM_SystemClock);
 
-#ifdef SET_TO_ZERO_DEGREE
-    TPM_UpdatePwmDutycycle(TPM2, kTPM_Chnl_0, kTPM_EdgeAlignedPwm, currentDutyCycle);
-#endif
     for(;;)
     {
 #ifndef SET_TO_ZERO_DEGREE
-    	/* Servo irá iniciar no ângulo mínimo de -90 graus.
-    	 * Ciclo de trabalho irá aumentar aos poucos à cada iteração.
-    	 * Irá sair do laço quando alcançar ângulo máximo:
-    	 * +90 graus == 12% de 65535 == 7864.*/
-    	while(currentDutyCycle < 7864)
+    	/* Enfileira os movimentos enquanto houver espaço; a interrupção
+    	 * os executa um após o outro, sem ocupar a CPU. */
+    	while(kStatus_Success == ServoMotion_MoveTo(0, &g_moves[nextMove]))
     	{
-    		currentDutyCycle += 100;
-    		TPM_UpdatePwmDutycycle(TPM2, kTPM_Chnl_0, kTPM_EdgeAlignedPwm, currentDutyCycle);
-    		Delay_Waitms(20);
+    		nextMove = (nextMove + 1) % ARRAY_SIZE(g_moves);
     	}
-
-    	/* Servo irá iniciar no ângulo máximo de +90 graus.
-    	 * Ciclo de trabalho irá diminuir aos poucos à cada iteração.
-    	 * Irá sair do laço quando alcançar ângulo mínimo:
-    	 * -90 graus == 2,5% de 65535 == 1638.*/
-    	while(currentDutyCycle > 1638)
-    	{
-    		currentDutyCycle -= 100;
-     		TPM_UpdatePwmDutycycle(TPM2, kTPM_Chnl_0, kTPM_EdgeAlignedPwm, currentDutyCycle);
-     		Delay_Waitms(20);
-        }
-#else
-
 #endif
+    	__WFI();
     }
 
     return 0;
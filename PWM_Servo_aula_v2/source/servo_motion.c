@@ -0,0 +1,421 @@
+/**
+ * @file	servo_motion.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Servo motion engine, run by the PWM period interrupt.
+ *
+ * The positions are offsets from the servo minimum angle, so they are
+ * never negative. The velocity and the acceleration of a move are
+ * converted to position units per frame by ServoMotion_MoveTo(), so the
+ * interrupt only adds, compares and multiplies: the braking test is
+ *
+ *   v * (v - a) <= 2 * a * (distance - v)
+ *
+ * the distance run while braking from v, by steps of a, being below the
+ * distance left after the current frame.
+ *
+ */
+
+#include <string.h>
+#include "servo_motion.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define SERVO_MOTION_QUEUE_MASK (SERVO_MOTION_QUEUE_SIZE - 1U)
+#define SERVO_MOTION_SCURVE_MASK (SERVO_MOTION_SCURVE_FRAMES - 1U)
+
+/*!< A move in position units per frame.*/
+typedef struct{
+	int32_t target;
+	int32_t velocity;
+	int32_t acceleration;
+	bool sCurve;
+}servoMotionPlan_t;
+
+/*!< Servo runtime data.*/
+typedef struct{
+	TPM_Type *base;
+	tpm_chnl_t channel;
+	int16_t minAngle_cdeg;
+	int32_t range;                  /*!< Position of the maximum angle.*/
+	uint16_t minTicks;              /*!< CnV of the minimum angle.*/
+	uint32_t slope;                 /*!< CnV per position unit, Q32.*/
+	servoMotionPlan_t queue[SERVO_MOTION_QUEUE_SIZE];
+	volatile uint8_t head;          /*!< Written by ServoMotion_MoveTo().*/
+	volatile uint8_t tail;          /*!< Written by the interrupt.*/
+	volatile bool moving;
+	servoMotionPlan_t move;         /*!< Current move.*/
+	int32_t position;               /*!< Trapezoid position.*/
+	int32_t velocity;               /*!< Trapezoid velocity, signed.*/
+	int32_t history[SERVO_MOTION_SCURVE_FRAMES];
+	int32_t historySum;
+	uint8_t historyIndex;
+	uint8_t settled;                /*!< Frames at the target.*/
+	volatile int32_t output;        /*!< Position of the last pulse.*/
+}servoMotionChannel_t;
+
+/*!< Engine runtime data.*/
+typedef struct{
+	TPM_Type *frameBase;
+	uint32_t frame_us;
+	servoMotionChannel_t servos[SERVO_MOTION_MAX_SERVOS];
+	uint8_t count;
+	servoMotionCallback_t callback;
+	void *userData;
+}servoMotionHandle_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Computes the next trapezoid position.
+ *
+ * @return true if at the target and stopped.
+ *
+ */
+static bool StepTrapezoid(servoMotionChannel_t *servo);
+
+/**
+ * @brief Computes and writes the next frame of a servo.
+ *
+ * @return true if its move ended.
+ *
+ */
+static bool StepServo(servoMotionChannel_t *servo);
+
+/**
+ * @brief Fills the moving average with the current position.
+ *
+ */
+static void ResetHistory(servoMotionChannel_t *servo);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static servoMotionHandle_t s_motion;
+
+static TPM_Type *const s_tpmBases[] = TPM_BASE_PTRS;
+static const IRQn_Type s_tpmIrqs[] = TPM_IRQS;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static bool StepTrapezoid(servoMotionChannel_t *servo)
+{
+	int32_t distance = servo->move.target - servo->position;
+	int32_t velocity = servo->velocity;
+	int32_t a = servo->move.acceleration;
+	int32_t next;
+	bool negative = (distance < 0) || ((distance == 0) && (velocity < 0));
+
+	/* Works on the direction of the target. */
+	if(negative)
+	{
+		distance = -distance;
+		velocity = -velocity;
+	}
+
+	if((distance == 0) && (velocity <= a))
+	{
+		servo->velocity = 0;
+		return true;
+	}
+
+	if(velocity < 0)
+	{
+		/* Moving away: brakes first. */
+		next = velocity + a;
+	}
+	else
+	{
+		/* Accelerates, else cruises, else brakes, as long as it can still
+		 * stop before the target. */
+		next = velocity + a;
+		if(next > servo->move.velocity)
+		{
+			next = servo->move.velocity;
+		}
+		if((next > distance) ||
+		   ((int64_t)next * (next - a) > 2 * (int64_t)a * (distance - next)))
+		{
+			next = velocity;
+			if((next > distance) ||
+			   ((int64_t)next * (next - a) > 2 * (int64_t)a * (distance - next)))
+			{
+				next = velocity - a;
+			}
+		}
+		/* The last step lands on the target. */
+		if(next < 0)
+		{
+			next = 0;
+		}
+		if((next > distance) || ((next == 0) && (distance <= a)))
+		{
+			next = distance;
+		}
+	}
+
+	servo->velocity = negative ? -next : next;
+	servo->position += servo->velocity;
+
+	return false;
+}
+
+static bool StepServo(servoMotionChannel_t *servo)
+{
+	uint8_t index = servo->historyIndex;
+	int32_t output;
+	bool ended = false;
+
+	if(StepTrapezoid(servo))
+	{
+		servo->settled++;
+	}
+
+	if(servo->move.sCurve)
+	{
+		servo->historySum += servo->position - servo->history[index];
+		servo->history[index] = servo->position;
+		servo->historyIndex = (index + 1U) & SERVO_MOTION_SCURVE_MASK;
+		output = (servo->historySum + (int32_t)(SERVO_MOTION_SCURVE_FRAMES / 2U)) >> SERVO_MOTION_SCURVE_SHIFT;
+		/* The average reaches the target once it holds only the target. */
+		ended = (servo->settled >= SERVO_MOTION_SCURVE_FRAMES);
+	}
+	else
+	{
+		output = servo->position;
+		ended = (servo->settled != 0U);
+	}
+
+	servo->output = output;
+	TPM_UpdatePwmTicks(servo->base, servo->channel,
+	                   servo->minTicks + (uint16_t)(((uint64_t)(uint32_t)output * servo->slope) >> 32U));
+
+	return ended;
+}
+
+static void ResetHistory(servoMotionChannel_t *servo)
+{
+	uint32_t i;
+
+	for(i = 0U; i < SERVO_MOTION_SCURVE_FRAMES; i++)
+	{
+		servo->history[i] = servo->position;
+	}
+	servo->historySum = servo->position * (int32_t)SERVO_MOTION_SCURVE_FRAMES;
+	servo->historyIndex = 0U;
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t ServoMotion_Init(const servoMotionConfig_t *config)
+{
+	tpm_pwm_timing_t timing;
+	uint32_t i, tpmClock, periodCounts, maxTicks;
+	uint32_t frameIndex = ARRAY_SIZE(s_tpmBases);
+
+	if((config == NULL) || (config->frameBase == NULL) || (config->servos == NULL) ||
+	   (config->srcClock_Hz == 0U) || (config->servosCount == 0U) ||
+	   (config->servosCount > SERVO_MOTION_MAX_SERVOS))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	for(i = 0U; i < ARRAY_SIZE(s_tpmBases); i++)
+	{
+		if(s_tpmBases[i] == config->frameBase)
+		{
+			frameIndex = i;
+		}
+	}
+	if(frameIndex == ARRAY_SIZE(s_tpmBases))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	for(i = 0U; i < config->servosCount; i++)
+	{
+		const servoMotionServo_t *servo = &config->servos[i];
+
+		if((servo->base == NULL) || (servo->minAngle_cdeg >= servo->maxAngle_cdeg) ||
+		   (servo->minPulse_us >= servo->maxPulse_us) ||
+		   (servo->initialAngle_cdeg < servo->minAngle_cdeg) || (servo->initialAngle_cdeg > servo->maxAngle_cdeg))
+		{
+			return kStatus_InvalidArgument;
+		}
+	}
+
+	DisableIRQ(s_tpmIrqs[frameIndex]);
+
+	memset(&s_motion, 0, sizeof(s_motion));
+	s_motion.frameBase = config->frameBase;
+	s_motion.count = config->servosCount;
+	s_motion.callback = config->callback;
+	s_motion.userData = config->userData;
+
+	tpmClock = config->srcClock_Hz >> (config->frameBase->SC & TPM_SC_PS_MASK);
+	periodCounts = (config->frameBase->SC & TPM_SC_CPWMS_MASK) ?
+	               (2U * config->frameBase->MOD) : (config->frameBase->MOD + 1U);
+	s_motion.frame_us = (uint32_t)(((uint64_t)periodCounts * 1000000U) / tpmClock);
+
+	for(i = 0U; i < config->servosCount; i++)
+	{
+		const servoMotionServo_t *servo = &config->servos[i];
+		servoMotionChannel_t *channel = &s_motion.servos[i];
+
+		TPM_GetPwmTiming(servo->base, config->srcClock_Hz, &timing);
+
+		channel->base = servo->base;
+		channel->channel = servo->channel;
+		channel->minAngle_cdeg = servo->minAngle_cdeg;
+		channel->range = (int32_t)(servo->maxAngle_cdeg - servo->minAngle_cdeg) << SERVO_MOTION_FRACTION_BITS;
+		channel->minTicks = TPM_PwmUsToTicks(&timing, servo->minPulse_us);
+		maxTicks = TPM_PwmUsToTicks(&timing, servo->maxPulse_us);
+		channel->slope = (uint32_t)(((uint64_t)(maxTicks - channel->minTicks) << 32U) / (uint32_t)channel->range);
+		channel->position = (int32_t)(servo->initialAngle_cdeg - servo->minAngle_cdeg) << SERVO_MOTION_FRACTION_BITS;
+		channel->move.target = channel->position;
+		ResetHistory(channel);
+
+		/* Writes the initial pulse. */
+		channel->settled = 1U;
+		(void)StepServo(channel);
+	}
+
+	TPM_ClearStatusFlags(config->frameBase, kTPM_TimeOverflowFlag);
+	TPM_EnableInterrupts(config->frameBase, kTPM_TimeOverflowInterruptEnable);
+	EnableIRQ(s_tpmIrqs[frameIndex]);
+
+	return kStatus_Success;
+}
+
+status_t ServoMotion_MoveTo(uint8_t servo, const servoMotionMove_t *move)
+{
+	servoMotionChannel_t *channel;
+	servoMotionPlan_t *plan;
+	uint64_t frame_us;
+	int32_t target;
+	uint8_t head;
+
+	if((servo >= s_motion.count) || (move == NULL) || (move->velocity_dps == 0U) ||
+	   (move->acceleration_dps2 == 0U))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	channel = &s_motion.servos[servo];
+	head = channel->head;
+	if((uint8_t)(head - channel->tail) >= SERVO_MOTION_QUEUE_SIZE)
+	{
+		return kStatus_ServoMotion_QueueFull;
+	}
+
+	target = ((int32_t)move->target_cdeg - channel->minAngle_cdeg) << SERVO_MOTION_FRACTION_BITS;
+	target = (target < 0) ? 0 : ((target > channel->range) ? channel->range : target);
+
+	/* deg/s * 100 cdeg * frame: cdeg per frame; deg/s^2 * 100 cdeg * frame^2: cdeg per frame^2. */
+	frame_us = s_motion.frame_us;
+	plan = &channel->queue[head & SERVO_MOTION_QUEUE_MASK];
+	plan->target = target;
+	plan->velocity = (int32_t)((((uint64_t)move->velocity_dps * frame_us) << SERVO_MOTION_FRACTION_BITS) / 10000U);
+	plan->acceleration = (int32_t)((((uint64_t)move->acceleration_dps2 * frame_us * frame_us) <<
+	                                SERVO_MOTION_FRACTION_BITS) / 10000000000ULL);
+	plan->velocity = (plan->velocity > 0) ? plan->velocity : 1;
+	plan->acceleration = (plan->acceleration > 0) ? plan->acceleration : 1;
+	plan->sCurve = (move->profile == kServoMotion_SCurve);
+
+	channel->head = head + 1U;
+
+	return kStatus_Success;
+}
+
+bool ServoMotion_IsIdle(uint8_t servo)
+{
+	servoMotionChannel_t *channel;
+
+	if(servo >= s_motion.count)
+	{
+		return true;
+	}
+
+	channel = &s_motion.servos[servo];
+
+	return !channel->moving && (channel->head == channel->tail);
+}
+
+int16_t ServoMotion_GetAngle(uint8_t servo)
+{
+	servoMotionChannel_t *channel;
+
+	if(servo >= s_motion.count)
+	{
+		return INT16_MIN;
+	}
+
+	channel = &s_motion.servos[servo];
+
+	return (int16_t)(channel->minAngle_cdeg +
+	                 ((channel->output + (1 << (SERVO_MOTION_FRACTION_BITS - 1U))) >> SERVO_MOTION_FRACTION_BITS));
+}
+
+void ServoMotion_IRQHandler(void)
+{
+	servoMotionChannel_t *servo;
+	uint8_t i, tail;
+
+	TPM_ClearStatusFlags(s_motion.frameBase, kTPM_TimeOverflowFlag);
+
+	for(i = 0U; i < s_motion.count; i++)
+	{
+		servo = &s_motion.servos[i];
+
+		if(!servo->moving)
+		{
+			tail = servo->tail;
+			if(tail == servo->head)
+			{
+				continue;
+			}
+			/* The previous move ended settled, so the average holds only
+			 * the current position. */
+			servo->move = servo->queue[tail & SERVO_MOTION_QUEUE_MASK];
+			servo->tail = tail + 1U;
+			servo->settled = 0U;
+			servo->moving = true;
+			ResetHistory(servo);
+		}
+
+		if(StepServo(servo))
+		{
+			servo->moving = false;
+			if(s_motion.callback != NULL)
+			{
+				s_motion.callback(i, s_motion.userData);
+			}
+		}
+	}
+}
@@ -0,0 +1,200 @@
+/**
+ * @file	servo_motion.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Motion engine for up to SERVO_MOTION_MAX_SERVOS hobby servos, on any
+ * channels of TPM0, TPM1 and TPM2.
+ *
+ * The trajectories are computed in the overflow interrupt of one of the
+ * TPMs (the frame timer), once per PWM period (20 ms for 50 Hz servos),
+ * and the new pulse of each servo is written to its CnV, which the TPM
+ * applies at its next period.
+ *
+ * A move goes to a target angle limited by a maximum velocity and an
+ * acceleration:
+ *
+ *   - trapezoid: accelerates, cruises and brakes, deciding at each frame
+ *     if it can still brake before the target;
+ *   - S-curve: the trapezoid positions pass through a moving average of
+ *     SERVO_MOTION_SCURVE_FRAMES frames, which limits the jerk to the
+ *     acceleration divided by that length and ends exactly at the target.
+ *
+ * The moves are queued by ServoMotion_MoveTo() at any time, up to
+ * SERVO_MOTION_QUEUE_SIZE per servo, and are started one after the other
+ * by the interrupt.
+ *
+ * The angles are given in centidegrees. The positions are computed in
+ * fixed point, with SERVO_MOTION_FRACTION_BITS fractional bits.
+ *
+ */
+
+#ifndef SERVO_MOTION_H_
+#define SERVO_MOTION_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "fsl_tpm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup servo_motion
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Maximum number of servos.*/
+#define SERVO_MOTION_MAX_SERVOS 6U
+
+/*!< Moves queued per servo (power of two).*/
+#define SERVO_MOTION_QUEUE_SIZE 4U
+
+/*!< Moving average length of the S-curve, as a power of two.*/
+#define SERVO_MOTION_SCURVE_SHIFT 3U
+#define SERVO_MOTION_SCURVE_FRAMES (1U << SERVO_MOTION_SCURVE_SHIFT)
+
+/*!< Fractional bits of the positions.*/
+#define SERVO_MOTION_FRACTION_BITS 12U
+
+/*!< Status codes.*/
+enum _servo_motion_status{
+	kStatus_ServoMotion_QueueFull = MAKE_STATUS(kStatusGroup_ApplicationRangeStart, 0), /*!< No room for the move.*/
+};
+
+/*!< Velocity profiles.*/
+typedef enum{
+	kServoMotion_Trapezoid = 0U, /*!< Limited acceleration.*/
+	kServoMotion_SCurve,         /*!< Limited acceleration and jerk.*/
+}servoMotionProfile_t;
+
+/*!
+ * @brief A servo output.
+ *
+ *        The TPM must be configured by TPM_SetupPwm() before
+ *        ServoMotion_Init().
+ */
+typedef struct{
+	TPM_Type *base;          /*!< TPM of the servo.*/
+	tpm_chnl_t channel;      /*!< TPM channel.*/
+	int16_t minAngle_cdeg;   /*!< Angle of the shortest pulse.*/
+	int16_t maxAngle_cdeg;   /*!< Angle of the longest pulse.*/
+	uint16_t minPulse_us;    /*!< Pulse width at minAngle_cdeg.*/
+	uint16_t maxPulse_us;    /*!< Pulse width at maxAngle_cdeg.*/
+	int16_t initialAngle_cdeg; /*!< Angle written by ServoMotion_Init().*/
+}servoMotionServo_t;
+
+/*!
+ * @brief A move.
+ */
+typedef struct{
+	int16_t target_cdeg;        /*!< Target angle, limited to the servo range.*/
+	uint16_t velocity_dps;      /*!< Maximum velocity, in degrees per second.*/
+	uint16_t acceleration_dps2; /*!< Acceleration, in degrees per second squared.*/
+	servoMotionProfile_t profile;
+}servoMotionMove_t;
+
+/*!< Move complete callback, called in interrupt context.*/
+typedef void (*servoMotionCallback_t)(uint8_t servo, void *userData);
+
+/*!
+ * @brief Engine configuration structure.
+ */
+typedef struct{
+	TPM_Type *frameBase;              /*!< TPM whose overflow runs the engine.*/
+	uint32_t srcClock_Hz;             /*!< TPM counter clock, the one given to TPM_SetupPwm().*/
+	const servoMotionServo_t *servos; /*!< Servo list, the index is the servo number.*/
+	uint8_t servosCount;              /*!< Number of servos (1 to SERVO_MOTION_MAX_SERVOS).*/
+	servoMotionCallback_t callback;   /*!< Move complete callback, can be NULL.*/
+	void *userData;                   /*!< Parameter passed to the callback.*/
+}servoMotionConfig_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Configures the engine, writes the initial angles and enables
+ *        the frame timer overflow interrupt.
+ *
+ * @param config - the configuration.
+ *
+ * @return kStatus_Success if configured;
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t ServoMotion_Init(const servoMotionConfig_t *config);
+
+/**
+ * @brief Queues a move, started when the previous ones end.
+ *
+ * @param servo - the servo number.
+ * @param move  - the move.
+ *
+ * @return kStatus_Success if queued;
+ *         kStatus_ServoMotion_QueueFull if the servo queue is full;
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t ServoMotion_MoveTo(uint8_t servo, const servoMotionMove_t *move);
+
+/**
+ * @brief Tests if a servo has ended all its moves.
+ *
+ * @param servo - the servo number.
+ *
+ * @return true if stopped with no queued move, or if the servo number is
+ *         invalid.
+ *
+ */
+bool ServoMotion_IsIdle(uint8_t servo);
+
+/**
+ * @brief Gets the angle of the last pulse written.
+ *
+ * @param servo - the servo number.
+ *
+ * @return The angle, in centidegrees; INT16_MIN if the servo number is
+ *         invalid.
+ *
+ */
+int16_t ServoMotion_GetAngle(uint8_t servo);
+
+/**
+ * @brief The engine interrupt routine: computes the next frame.
+ *
+ *        Must be called from the frame timer interrupt handler
+ *        (TPMn_IRQHandler()).
+ *
+ */
+void ServoMotion_IRQHandler(void);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* SERVO_MOTION_H_ */
@@ -40,11 +40,27 @@
 #include "MKL25Z4.h"
 #include "fsl_debug_console.h"
 #include "fsl_tpm.h"
+#include "fsl_port.h"
 /* TODO: insert other include files here. */
 #include "delay.h"
+#include "soft_pwm.h"
 
 /* TODO: insert other definitions and declarations here. */
 
+/* LEDs vermelho e azul em PWM por software: são pinos GPIO comuns, sem
+ * canal de TPM. Os LEDs da placa acendem em nível baixo. */
+static const softPwmChannel_t g_softPwmChannels[] = {
+	{BOARD_LED_RED_GPIO, 1U << BOARD_LED_RED_GPIO_PIN, true},   // PTB18
+	{BOARD_LED_BLUE_GPIO, 1U << BOARD_LED_BLUE_GPIO_PIN, true}, // PTD1
+};
+
+void TPM0_IRQHandler(void)
+{
+	/* A cada interrupção do canal de comparação, o motor liga ou desliga
+	 * todos os pinos daquele instante e programa o próximo.*/
+	SoftPwm_IRQHandler();
+}
+
 /*
  * @brief   Application entry point.
  */
@@ -54,6 +70,9 @@ int main(void) {
 	tpm_chnl_pwm_signal_param_t chnl_1_param  = {.chnlNumber 		 = kTPM_Chnl_1,
 												 .level 	 		 = kTPM_LowTrue,
 												 .dutyCyclePercent = 0};
+	tpm_config_t tpm0_config;
+	softPwmConfig_t soft_pwm_config;
+	gpio_pin_config_t led_config = {kGPIO_DigitalOutput, 1};
 	uint8_t updatedDutycycle = 0;
 	bool brightnessUp = true;
 
@@ -79,6 +98,30 @@ int main(void) {
 
     TPM_StartTimer(TPM2, kTPM_SystemClock);
 
+    /* Pinos dos LEDs vermelho e azul como GPIO de saída, desligados. */
+    CLOCK_EnableClock(kCLOCK_PortD);
+    PORT_SetPinMux(BOARD_LED_RED_GPIO_PORT, BOARD_LED_RED_GPIO_PIN, kPORT_MuxAsGpio);
+    PORT_SetPinMux(BOARD_LED_BLUE_GPIO_PORT, BOARD_LED_BLUE_GPIO_PIN, kPORT_MuxAsGpio);
+    GPIO_PinInit(BOARD_LED_RED_GPIO, BOARD_LED_RED_GPIO_PIN, &led_config);
+    GPIO_PinInit(BOARD_LED_BLUE_GPIO, BOARD_LED_BLUE_GPIO_PIN, &led_config);
+
+    /* O TPM0 conta o período do PWM por software (6 MHz, 200 Hz com
+     * 100 níveis) e seu canal 0, sem pino, gera as interrupções. */
+    TPM_GetDefaultConfig(&tpm0_config);
+    tpm0_config.prescale = kTPM_Prescale_Divide_8;
+    TPM_Init(TPM0, &tpm0_config);
+
+    SoftPwm_GetDefaultConfig(&soft_pwm_config);
+    soft_pwm_config.base = TPM0;
+    soft_pwm_config.channel = kTPM_Chnl_0;
+    soft_pwm_config.counterClock_Hz = CLOCK_GetPllFllSelClkFreq() / 8U;
+    soft_pwm_config.levels = 100U;
+    soft_pwm_config.channels = g_softPwmChannels;
+    soft_pwm_config.channelsCount = ARRAY_SIZE(g_softPwmChannels);
+    SoftPwm_Init(&soft_pwm_config);
+
+    TPM_StartTimer(TPM0, kTPM_SystemClock);
+
     for(;;)
     {
         /* Delays to see the change of LED brightness. */
@@ -101,6 +144,12 @@ int main(void) {
         }
         /* Starts PWM mode with an updated duty cycle. */
         TPM_UpdatePwmDutycycle(TPM2, kTPM_Chnl_1, kTPM_EdgeAlignedPwm, updatedDutycycle);
+
+        /* Vermelho acompanha o verde e azul faz o contrário: o novo
+         * escalonamento entra no início do próximo período. */
+        SoftPwm_SetDuty(0, updatedDutycycle);
+        SoftPwm_SetDuty(1, 100U - updatedDutycycle);
+        SoftPwm_Update();
     }
 
     return 0 ;
@@ -0,0 +1,379 @@
+/**
+ * @file	soft_pwm.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Software PWM engine.
+ *
+ * A schedule is a list of events sorted by time; the first one, at time
+ * 0, is the period start. Each event has the set and clear masks of each
+ * port used. The compare value is always the time of the next event; after
+ * the last one it is 0, matched after the counter wraps.
+ *
+ * The interrupt swaps the schedules only at the period start, when the
+ * pending flag is set. SoftPwm_Update() clears the flag before writing the
+ * free schedule, so a half built schedule is never taken.
+ *
+ */
+
+#include <string.h>
+#include "soft_pwm.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< An edge time.*/
+typedef struct{
+	uint16_t time;
+	uint32_t set[SOFT_PWM_MAX_PORTS];
+	uint32_t clear[SOFT_PWM_MAX_PORTS];
+}softPwmEvent_t;
+
+/*!< A schedule: the period start and an event per distinct duty cycle.*/
+typedef struct{
+	softPwmEvent_t events[SOFT_PWM_MAX_CHANNELS + 1U];
+	uint8_t count;
+}softPwmSchedule_t;
+
+/*!< Engine runtime data.*/
+typedef struct{
+	TPM_Type *base;
+	tpm_chnl_t channel;
+	uint32_t period;           /*!< Period in ticks (MOD + 1).*/
+	uint16_t step;             /*!< Ticks per duty cycle level.*/
+	uint16_t levels;
+	uint32_t minInterval;      /*!< In ticks.*/
+	GPIO_Type *ports[SOFT_PWM_MAX_PORTS];
+	uint8_t portsCount;
+	uint8_t channelPort[SOFT_PWM_MAX_CHANNELS];
+	uint32_t channelMask[SOFT_PWM_MAX_CHANNELS];
+	bool channelActiveLow[SOFT_PWM_MAX_CHANNELS];
+	uint8_t channelsCount;
+	uint16_t duties[SOFT_PWM_MAX_CHANNELS];
+	bool dirty;
+	softPwmSchedule_t schedules[2];
+	volatile uint8_t active;   /*!< Schedule in use.*/
+	volatile bool pending;     /*!< The other schedule waits the period start.*/
+	uint8_t next;              /*!< Next event of the schedule in use.*/
+	softPwmStats_t stats;
+}softPwmHandle_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Adds the on or off action of a channel to an event.
+ *
+ */
+static void AddAction(softPwmEvent_t *event, uint8_t channel, bool on);
+
+/**
+ * @brief Builds the schedule of the current duty cycles.
+ *
+ */
+static void Build(softPwmSchedule_t *schedule);
+
+/**
+ * @brief Writes the masks of an event to the ports.
+ *
+ */
+static inline void Execute(const softPwmEvent_t *event);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static softPwmHandle_t s_softPwm;
+
+static TPM_Type *const s_tpmBases[] = TPM_BASE_PTRS;
+static const IRQn_Type s_tpmIrqs[] = TPM_IRQS;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void AddAction(softPwmEvent_t *event, uint8_t channel, bool on)
+{
+	uint8_t port = s_softPwm.channelPort[channel];
+
+	if(on != s_softPwm.channelActiveLow[channel])
+	{
+		event->set[port] |= s_softPwm.channelMask[channel];
+	}
+	else
+	{
+		event->clear[port] |= s_softPwm.channelMask[channel];
+	}
+}
+
+static void Build(softPwmSchedule_t *schedule)
+{
+	uint8_t order[SOFT_PWM_MAX_CHANNELS];
+	uint8_t i, j, ends, channel;
+	uint16_t time;
+	softPwmEvent_t *event;
+
+	memset(schedule, 0, sizeof(softPwmSchedule_t));
+
+	/* Period start: on the channels with a duty cycle, off the others. */
+	ends = 0U;
+	for(i = 0U; i < s_softPwm.channelsCount; i++)
+	{
+		AddAction(&schedule->events[0], i, s_softPwm.duties[i] != 0U);
+
+		/* Insertion sort of the channels that turn off in the period. */
+		if((s_softPwm.duties[i] != 0U) && (s_softPwm.duties[i] < s_softPwm.levels))
+		{
+			for(j = ends; (j > 0U) && (s_softPwm.duties[order[j - 1U]] > s_softPwm.duties[i]); j--)
+			{
+				order[j] = order[j - 1U];
+			}
+			order[j] = i;
+			ends++;
+		}
+	}
+	schedule->count = 1U;
+
+	/* One event per distinct time, with the pins of each port merged. */
+	event = &schedule->events[0];
+	for(i = 0U; i < ends; i++)
+	{
+		channel = order[i];
+		time = s_softPwm.duties[channel] * s_softPwm.step;
+		if((schedule->count == 1U) || (event->time != time))
+		{
+			event = &schedule->events[schedule->count++];
+			event->time = time;
+		}
+		AddAction(event, channel, false);
+	}
+}
+
+static inline void Execute(const softPwmEvent_t *event)
+{
+	uint8_t i;
+
+	for(i = 0U; i < s_softPwm.portsCount; i++)
+	{
+		if(event->set[i] != 0U)
+		{
+			GPIO_SetPinsOutput(s_softPwm.ports[i], event->set[i]);
+		}
+		if(event->clear[i] != 0U)
+		{
+			GPIO_ClearPinsOutput(s_softPwm.ports[i], event->clear[i]);
+		}
+	}
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+void SoftPwm_GetDefaultConfig(softPwmConfig_t *config)
+{
+	memset(config, 0, sizeof(softPwmConfig_t));
+	config->frequency_Hz = 200U;
+	config->levels = 256U;
+	config->minInterval_us = 4U;
+}
+
+status_t SoftPwm_Init(const softPwmConfig_t *config)
+{
+	uint32_t instance, period, step, primask;
+	uint8_t i, port;
+
+	if((config == NULL) || (config->base == NULL) || (config->channels == NULL) ||
+	   (config->frequency_Hz == 0U) || (config->levels == 0U) ||
+	   (config->channelsCount == 0U) || (config->channelsCount > SOFT_PWM_MAX_CHANNELS))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	for(instance = 0U; instance < ARRAY_SIZE(s_tpmBases); instance++)
+	{
+		if(s_tpmBases[instance] == config->base)
+		{
+			break;
+		}
+	}
+	if(instance == ARRAY_SIZE(s_tpmBases))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	/* The period is a whole number of levels. */
+	period = config->counterClock_Hz / config->frequency_Hz;
+	step = period / config->levels;
+	period = step * config->levels;
+	if((step == 0U) || (period > 0x10000U))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	DisableIRQ(s_tpmIrqs[instance]);
+	TPM_DisableInterrupts(config->base, 1U << config->channel);
+
+	memset(&s_softPwm, 0, sizeof(s_softPwm));
+	s_softPwm.base = config->base;
+	s_softPwm.channel = config->channel;
+	s_softPwm.period = period;
+	s_softPwm.step = (uint16_t)step;
+	s_softPwm.levels = config->levels;
+	s_softPwm.minInterval = (uint32_t)(((uint64_t)config->minInterval_us * config->counterClock_Hz) / 1000000U);
+	s_softPwm.channelsCount = config->channelsCount;
+
+	/* Groups the channels by port. */
+	for(i = 0U; i < config->channelsCount; i++)
+	{
+		for(port = 0U; (port < s_softPwm.portsCount) && (s_softPwm.ports[port] != config->channels[i].gpio); port++)
+		{
+		}
+		if(port == s_softPwm.portsCount)
+		{
+			if(port == SOFT_PWM_MAX_PORTS)
+			{
+				return kStatus_InvalidArgument;
+			}
+			s_softPwm.ports[s_softPwm.portsCount++] = config->channels[i].gpio;
+		}
+		s_softPwm.channelPort[i] = port;
+		s_softPwm.channelMask[i] = config->channels[i].pinMask;
+		s_softPwm.channelActiveLow[i] = config->channels[i].activeLow;
+	}
+
+	/* All off: the period start of the first schedule turns them off. */
+	Build(&s_softPwm.schedules[0]);
+	s_softPwm.stats.edges = s_softPwm.schedules[0].count;
+	primask = DisableGlobalIRQ();
+	Execute(&s_softPwm.schedules[0].events[0]);
+	EnableGlobalIRQ(primask);
+
+	TPM_SetTimerPeriod(config->base, period - 1U);
+	TPM_SetupOutputCompare(config->base, config->channel, kTPM_NoOutputSignal, 0U);
+	TPM_ClearStatusFlags(config->base, 1U << config->channel);
+	TPM_EnableInterrupts(config->base, 1U << config->channel);
+	EnableIRQ(s_tpmIrqs[instance]);
+
+	return kStatus_Success;
+}
+
+void SoftPwm_SetDuty(uint8_t channel, uint16_t duty)
+{
+	if(duty > s_softPwm.levels)
+	{
+		duty = s_softPwm.levels;
+	}
+
+	if(s_softPwm.duties[channel] != duty)
+	{
+		s_softPwm.duties[channel] = duty;
+		s_softPwm.dirty = true;
+	}
+}
+
+void SoftPwm_Update(void)
+{
+	if(!s_softPwm.dirty)
+	{
+		return;
+	}
+	s_softPwm.dirty = false;
+
+	/* The free schedule is not taken while it is written. */
+	s_softPwm.pending = false;
+	Build(&s_softPwm.schedules[s_softPwm.active ^ 1U]);
+	s_softPwm.pending = true;
+}
+
+bool SoftPwm_IsUpdatePending(void)
+{
+	return s_softPwm.pending;
+}
+
+void SoftPwm_GetStats(softPwmStats_t *stats)
+{
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	*stats = s_softPwm.stats;
+	EnableGlobalIRQ(primask);
+}
+
+void SoftPwm_IRQHandler(void)
+{
+	TPM_Type *base = s_softPwm.base;
+	uint32_t mask = 1U << s_softPwm.channel;
+	const softPwmSchedule_t *schedule;
+	uint32_t done, target, count;
+
+	if(!(base->STATUS & mask))
+	{
+		return;
+	}
+	base->STATUS = mask;
+	s_softPwm.stats.interrupts++;
+
+	while(true)
+	{
+		if(s_softPwm.next == 0U)
+		{
+			if(s_softPwm.pending)
+			{
+				s_softPwm.active ^= 1U;
+				s_softPwm.pending = false;
+				s_softPwm.stats.edges = s_softPwm.schedules[s_softPwm.active].count;
+			}
+			s_softPwm.stats.periods++;
+		}
+
+		schedule = &s_softPwm.schedules[s_softPwm.active];
+		Execute(&schedule->events[s_softPwm.next]);
+		s_softPwm.stats.events++;
+		done = schedule->events[s_softPwm.next].time;
+
+		s_softPwm.next = (s_softPwm.next + 1U < schedule->count) ? (s_softPwm.next + 1U) : 0U;
+		base->CONTROLS[s_softPwm.channel].CnV = schedule->events[s_softPwm.next].time;
+
+		/* The next event in the period time line: the start is at the end. */
+		target = (s_softPwm.next == 0U) ? s_softPwm.period : schedule->events[s_softPwm.next].time;
+		count = base->CNT & 0xFFFFU;
+		if(count < done)
+		{
+			count += s_softPwm.period;
+		}
+		if((count < target) && ((target - count) > s_softPwm.minInterval))
+		{
+			break;
+		}
+
+		/* Too close for another interrupt: waits it here. */
+		while(count < target)
+		{
+			count = base->CNT & 0xFFFFU;
+			if(count < done)
+			{
+				count += s_softPwm.period;
+			}
+		}
+		base->STATUS = mask;
+	}
+}
@@ -0,0 +1,186 @@
+/**
+ * @file	soft_pwm.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Software PWM of up to SOFT_PWM_MAX_CHANNELS GPIO pins, driven by the
+ * compare interrupt of one TPM channel.
+ *
+ * The TPM period is the PWM period. At the period start all the pins with
+ * a duty cycle are turned on, and each following interrupt turns off the
+ * pins whose duty cycle ends at that time. The pins are grouped by port,
+ * so pins switched at the same time take one PSOR or PCOR write per port,
+ * and the interrupts per period are the distinct duty cycles plus one,
+ * not the number of pins.
+ *
+ * The edges are kept in a schedule sorted by time, built by
+ * SoftPwm_Update() only when the duty cycles change. There are two
+ * schedules: the new one is built while the other is in use, and is
+ * taken by the interrupt at the next period start, so a period never
+ * mixes old and new duty cycles.
+ *
+ * Edges closer than minInterval_us to the previous one are done in the
+ * same interrupt, by waiting the counter, instead of a new interrupt.
+ *
+ * The TPM must be previously initialized by TPM_Init() and started by
+ * TPM_StartTimer(); its period is set by SoftPwm_Init(), so its other
+ * channels can only make PWM of the same period. The pins must be GPIO
+ * outputs. The application must call SoftPwm_IRQHandler() from the TPM
+ * interrupt handler.
+ *
+ */
+
+#ifndef SOFT_PWM_H_
+#define SOFT_PWM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "fsl_gpio.h"
+#include "fsl_tpm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup soft_pwm
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Maximum number of channels (pins).*/
+#ifndef SOFT_PWM_MAX_CHANNELS
+#define SOFT_PWM_MAX_CHANNELS 32U
+#endif
+
+/*!< Maximum number of GPIO ports used by the channels.*/
+#ifndef SOFT_PWM_MAX_PORTS
+#define SOFT_PWM_MAX_PORTS 5U
+#endif
+
+/*!
+ * @brief A channel (pin).
+ */
+typedef struct{
+	GPIO_Type *gpio;  /*!< GPIO of the pin.*/
+	uint32_t pinMask; /*!< Pin mask.*/
+	bool activeLow;   /*!< The pin is on at low level (as the board LEDs).*/
+}softPwmChannel_t;
+
+/*!
+ * @brief Engine configuration structure.
+ */
+typedef struct{
+	TPM_Type *base;                   /*!< TPM of the compare channel.*/
+	tpm_chnl_t channel;               /*!< Compare channel, with no pin.*/
+	uint32_t counterClock_Hz;         /*!< TPM counter clock (after the prescaler).*/
+	uint32_t frequency_Hz;            /*!< PWM frequency.*/
+	uint16_t levels;                  /*!< Duty cycle steps (duty cycle 0 to levels).*/
+	uint32_t minInterval_us;          /*!< Shortest time between interrupts.*/
+	const softPwmChannel_t *channels; /*!< Channel list, the index is the channel number.*/
+	uint8_t channelsCount;            /*!< Number of channels.*/
+}softPwmConfig_t;
+
+/*!
+ * @brief Engine statistics.
+ */
+typedef struct{
+	uint32_t interrupts; /*!< Interrupts taken.*/
+	uint32_t events;     /*!< Edge times done (interrupts plus merged ones).*/
+	uint32_t periods;    /*!< PWM periods.*/
+	uint8_t edges;       /*!< Edge times per period, in the current schedule.*/
+}softPwmStats_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Gets the default configuration: 200 Hz, 256 levels and 4 us
+ *        between interrupts.
+ *
+ * @param config - the configuration to be filled.
+ *
+ */
+void SoftPwm_GetDefaultConfig(softPwmConfig_t *config);
+
+/**
+ * @brief Sets the TPM period, turns the pins off and enables the compare
+ *        interrupt.
+ *
+ * @param config - the configuration.
+ *
+ * @return kStatus_Success if configured;
+ *         kStatus_InvalidArgument if any parameter is invalid, the period
+ *         does not fit in the counter or is shorter than the levels.
+ *
+ */
+status_t SoftPwm_Init(const softPwmConfig_t *config);
+
+/**
+ * @brief Sets the duty cycle of a channel, applied by SoftPwm_Update().
+ *
+ * @param channel - the channel number.
+ * @param duty    - duty cycle, from 0 (off) to levels (on).
+ *
+ */
+void SoftPwm_SetDuty(uint8_t channel, uint16_t duty);
+
+/**
+ * @brief Builds the schedule of the new duty cycles, used from the next
+ *        period on. Does nothing if no duty cycle changed.
+ *
+ */
+void SoftPwm_Update(void);
+
+/**
+ * @brief Tells if the last schedule built is not in use yet.
+ *
+ * @return true if the schedule waits the period start.
+ *
+ */
+bool SoftPwm_IsUpdatePending(void);
+
+/**
+ * @brief Gets the engine statistics.
+ *
+ * @param stats - where the statistics are copied.
+ *
+ */
+void SoftPwm_GetStats(softPwmStats_t *stats);
+
+/**
+ * @brief The engine interrupt routine.
+ *
+ *        Must be called from the TPM interrupt handler (TPMn_IRQHandler()).
+ *
+ */
+void SoftPwm_IRQHandler(void);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* SOFT_PWM_H_ */
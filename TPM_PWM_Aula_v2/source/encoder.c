@@ -0,0 +1,296 @@
+/**
+ * @file	encoder.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Quadrature decoding by capture and M/T velocity.
+ *
+ * The tpm_capture callback only keeps the latest edge time of the
+ * snapshot; the decoding is done after TpmCapture_IRQHandler() returns,
+ * once per interrupt. An edge that happens between the snapshot and the
+ * pin reading is decoded in this interrupt; its flag, in the next one,
+ * finds no level change and counts nothing.
+ *
+ * The interrupt updates the position and the time of its last change.
+ * Encoder_Update() copies both in a short critical section and does the
+ * single division of the estimate out of it.
+ *
+ */
+
+#include <string.h>
+#include "encoder.h"
+#include "tpm_capture.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Phase state bits.*/
+#define ENCODER_STATE_A 2U
+#define ENCODER_STATE_B 1U
+
+/*!< Invalid transition (both phases changed).*/
+#define ENCODER_JUMP 2
+
+/*!< Encoder runtime data.*/
+typedef struct{
+	TPM_Type *base;
+	uint32_t clock_Hz;
+	tpm_chnl_t channelA;
+	tpm_chnl_t channelB;
+	GPIO_Type *gpioA;
+	uint32_t pinMaskA;
+	GPIO_Type *gpioB;
+	uint32_t pinMaskB;
+	uint32_t stopTimeout;      /*!< In ticks.*/
+	uint8_t state;             /*!< Last phase levels.*/
+	int8_t direction;          /*!< Last step, +1 or -1.*/
+	bool edge;                 /*!< Snapshot with phase edges.*/
+	uint32_t edgeTime;         /*!< Latest edge time of the snapshot.*/
+	volatile int32_t position;
+	volatile uint32_t changeTime; /*!< Time of the last position change.*/
+	volatile uint32_t errors;
+	int32_t lastPosition;      /*!< Position of the last update.*/
+	uint32_t lastChangeTime;   /*!< Change time of the last update.*/
+	int32_t velocity;
+	bool moving;               /*!< The last update had a velocity.*/
+}encoderHandle_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Reads the phase levels.
+ *
+ */
+static inline uint8_t ReadState(void);
+
+/**
+ * @brief Keeps the latest phase edge time of the snapshot.
+ *
+ */
+static bool EdgeCallback(TPM_Type *base, const tpmCaptureEdge_t *edge, void *userData);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static encoderHandle_t s_encoder;
+
+/*!< Step of each transition, indexed by (previous state << 2) | state.*/
+static const int8_t s_steps[16] = {
+	 0, -1,  1, ENCODER_JUMP,
+	 1,  0, ENCODER_JUMP, -1,
+	-1, ENCODER_JUMP,  0,  1,
+	ENCODER_JUMP,  1, -1,  0,
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static inline uint8_t ReadState(void)
+{
+	uint8_t state = 0U;
+
+	if(s_encoder.gpioA->PDIR & s_encoder.pinMaskA)
+	{
+		state |= ENCODER_STATE_A;
+	}
+	if(s_encoder.gpioB->PDIR & s_encoder.pinMaskB)
+	{
+		state |= ENCODER_STATE_B;
+	}
+
+	return state;
+}
+
+static bool EdgeCallback(TPM_Type *base, const tpmCaptureEdge_t *edge, void *userData)
+{
+	(void)base;
+	(void)userData;
+
+	if((edge->channel == s_encoder.channelA) || (edge->channel == s_encoder.channelB))
+	{
+		if(!s_encoder.edge || ((int32_t)(edge->timestamp - s_encoder.edgeTime) > 0))
+		{
+			s_encoder.edgeTime = edge->timestamp;
+		}
+		s_encoder.edge = true;
+	}
+
+	return false;
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+void Encoder_GetDefaultConfig(encoderConfig_t *config)
+{
+	memset(config, 0, sizeof(encoderConfig_t));
+	config->channelA = kTPM_Chnl_0;
+	config->channelB = kTPM_Chnl_1;
+	config->stopTimeout_us = 500000U;
+}
+
+status_t Encoder_Init(const encoderConfig_t *config)
+{
+	uint64_t stopTimeout;
+	status_t status;
+
+	if((config == NULL) || (config->gpioA == NULL) || (config->gpioB == NULL) ||
+	   (config->counterClock_Hz == 0U) || (config->channelA == config->channelB))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	/* The timeout must fit in half of the timestamp range. */
+	stopTimeout = ((uint64_t)config->stopTimeout_us * config->counterClock_Hz) / 1000000U;
+	if((stopTimeout == 0U) || (stopTimeout > 0x7FFFFFFFU))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	status = TpmCapture_Init(config->base, EdgeCallback, NULL);
+	if(status != kStatus_Success)
+	{
+		return status;
+	}
+
+	memset(&s_encoder, 0, sizeof(s_encoder));
+	s_encoder.base = config->base;
+	s_encoder.clock_Hz = config->counterClock_Hz;
+	s_encoder.channelA = config->channelA;
+	s_encoder.channelB = config->channelB;
+	s_encoder.gpioA = config->gpioA;
+	s_encoder.pinMaskA = config->pinMaskA;
+	s_encoder.gpioB = config->gpioB;
+	s_encoder.pinMaskB = config->pinMaskB;
+	s_encoder.stopTimeout = (uint32_t)stopTimeout;
+	s_encoder.direction = 1;
+	s_encoder.state = ReadState();
+	s_encoder.changeTime = TpmCapture_GetTime(config->base);
+	s_encoder.lastChangeTime = s_encoder.changeTime;
+
+	TpmCapture_EnableChannel(config->base, config->channelA, kTPM_RiseAndFallEdge);
+	TpmCapture_EnableChannel(config->base, config->channelB, kTPM_RiseAndFallEdge);
+
+	return kStatus_Success;
+}
+
+void Encoder_SetPosition(int32_t position)
+{
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	s_encoder.lastPosition += position - s_encoder.position;
+	s_encoder.position = position;
+	EnableGlobalIRQ(primask);
+}
+
+int32_t Encoder_Update(void)
+{
+	uint32_t primask, changeTime, now, elapsed;
+	int32_t position, counts;
+	int64_t velocity;
+
+	primask = DisableGlobalIRQ();
+	position = s_encoder.position;
+	changeTime = s_encoder.changeTime;
+	now = TpmCapture_GetTime(s_encoder.base);
+	EnableGlobalIRQ(primask);
+
+	counts = position - s_encoder.lastPosition;
+
+	if((counts != 0) && (changeTime != s_encoder.lastChangeTime))
+	{
+		/* M counts in the time between the last changes of two updates. */
+		velocity = ((int64_t)counts * s_encoder.clock_Hz * 256) / (uint32_t)(changeTime - s_encoder.lastChangeTime);
+		s_encoder.velocity = (int32_t)velocity;
+		s_encoder.moving = true;
+		s_encoder.lastPosition = position;
+		s_encoder.lastChangeTime = changeTime;
+	}
+	else
+	{
+		/* No count: the next one is at least this time away. */
+		elapsed = now - s_encoder.lastChangeTime;
+		if(!s_encoder.moving || (elapsed >= s_encoder.stopTimeout))
+		{
+			s_encoder.velocity = 0;
+			s_encoder.moving = false;
+		}
+		else
+		{
+			velocity = ((int64_t)s_encoder.clock_Hz * 256) / elapsed;
+			if(velocity < ((s_encoder.velocity < 0) ? -(int64_t)s_encoder.velocity : (int64_t)s_encoder.velocity))
+			{
+				s_encoder.velocity = (s_encoder.velocity < 0) ? -(int32_t)velocity : (int32_t)velocity;
+			}
+		}
+	}
+
+	return s_encoder.velocity;
+}
+
+void Encoder_GetReading(encoderReading_t *reading)
+{
+	reading->position = s_encoder.position;
+	reading->velocity = s_encoder.velocity;
+	reading->errors = s_encoder.errors;
+}
+
+void Encoder_IRQHandler(void)
+{
+	uint8_t state;
+	int8_t step;
+
+	s_encoder.edge = false;
+	TpmCapture_IRQHandler(s_encoder.base);
+
+	if(!s_encoder.edge)
+	{
+		return;
+	}
+
+	state = ReadState();
+	step = s_steps[(s_encoder.state << 2U) | state];
+	s_encoder.state = state;
+
+	if(step == 0)
+	{
+		return;
+	}
+
+	if(step == ENCODER_JUMP)
+	{
+		/* A count was lost: both phases changed, in the last direction. */
+		s_encoder.errors++;
+		step = 2 * s_encoder.direction;
+	}
+	else
+	{
+		s_encoder.direction = step;
+	}
+
+	s_encoder.position += step;
+	s_encoder.changeTime = s_encoder.edgeTime;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file	encoder.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Quadrature encoder position and velocity.
+ *
+ * The KL25 TPM has no quadrature decoder mode (no QDCTRL register), so
+ * TPM_SetupQuadDecode() is not available. The phases A and B go to two
+ * capture channels of one TPM instead, capturing both edges with
+ * tpm_capture, and are decoded by interrupt with all the 4 edges counted
+ * (x4). The position is a 32 bit count, up when A leads B.
+ *
+ * The decoding uses the pin levels, read from the GPIO input register at
+ * each interrupt (it is valid with the pins in the TPM function too), so
+ * a bounce on one phase counts forward and back and cancels out. A jump
+ * on both phases at once is an error: it is counted as two steps in the
+ * last direction.
+ *
+ * The velocity is estimated by Encoder_Update() with the M/T method: the
+ * counts (M) over the exact time between the last edges of two updates
+ * (T), both taken from the captures. At high speeds M is large and the
+ * estimate is as good as a count over a fixed time; at low speeds the
+ * time of one count is measured with the TPM clock resolution. Without
+ * counts, the velocity is bounded by the time since the last edge and
+ * goes to zero after stopTimeout_us.
+ *
+ * The TPM must be previously initialized by TPM_Init() and started by
+ * TPM_StartTimer(). The application must call Encoder_IRQHandler() from
+ * the TPM interrupt handler, and Encoder_Update() periodically, not from
+ * an interrupt of higher priority than the TPM one.
+ *
+ */
+
+#ifndef ENCODER_H_
+#define ENCODER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "fsl_gpio.h"
+#include "fsl_tpm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup encoder
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!
+ * @brief A reading.
+ */
+typedef struct{
+	int32_t position;     /*!< Counts (4 per encoder line).*/
+	int32_t velocity;     /*!< Counts per second, Q8, of the last Encoder_Update().*/
+	uint32_t errors;      /*!< Jumps on both phases.*/
+}encoderReading_t;
+
+/*!
+ * @brief Encoder configuration structure.
+ */
+typedef struct{
+	TPM_Type *base;           /*!< TPM of the capture channels.*/
+	uint32_t counterClock_Hz; /*!< TPM counter clock (after the prescaler).*/
+	tpm_chnl_t channelA;      /*!< Capture channel of the phase A.*/
+	tpm_chnl_t channelB;      /*!< Capture channel of the phase B.*/
+	GPIO_Type *gpioA;         /*!< GPIO of the phase A pin.*/
+	uint32_t pinMaskA;        /*!< Phase A pin mask.*/
+	GPIO_Type *gpioB;         /*!< GPIO of the phase B pin.*/
+	uint32_t pinMaskB;        /*!< Phase B pin mask.*/
+	uint32_t stopTimeout_us;  /*!< Time without counts for zero velocity.*/
+}encoderConfig_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Gets the default configuration: channels 0 (A) and 1 (B) and
+ *        500 ms stop timeout.
+ *
+ * @param config - the configuration to be filled.
+ *
+ */
+void Encoder_GetDefaultConfig(encoderConfig_t *config);
+
+/**
+ * @brief Configures the capture channels and zeroes the position.
+ *
+ * @param config - the configuration.
+ *
+ * @return kStatus_Success if configured;
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t Encoder_Init(const encoderConfig_t *config);
+
+/**
+ * @brief Sets the position.
+ *
+ * @param position - the new position, in counts.
+ *
+ */
+void Encoder_SetPosition(int32_t position);
+
+/**
+ * @brief Estimates the velocity since the last update.
+ *
+ *        Called periodically, as by a control loop; the period does not
+ *        need to be exact.
+ *
+ * @return The velocity, in counts per second, Q8.
+ *
+ */
+int32_t Encoder_Update(void);
+
+/**
+ * @brief Gets the position and the last velocity.
+ *
+ * @param reading - where the reading is written.
+ *
+ */
+void Encoder_GetReading(encoderReading_t *reading);
+
+/**
+ * @brief The encoder interrupt routine, which also serves tpm_capture.
+ *
+ *        Must be called from the TPM interrupt handler (TPMn_IRQHandler()).
+ *
+ */
+void Encoder_IRQHandler(void);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* ENCODER_H_ */
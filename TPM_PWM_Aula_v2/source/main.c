@@ -40,11 +40,55 @@
 #include "MKL25Z4.h"
 #include "fsl_debug_console.h"
 #include "fsl_tpm.h"
+#include "fsl_port.h"
 /* TODO: insert other include files here. */
 #include "delay.h"
+#include "encoder.h"
+#include "ws2812.h"
 
 /* TODO: insert other definitions and declarations here. */
 
+/* Fita de LEDs WS2812 no PTC1 (TPM0_CH0). */
+#define STRIP_LEDS 60U
+
+ws2812Pixel_t strip[STRIP_LEDS];
+
+/* Cor de uma posição do círculo de cores (0 a 255). */
+static ws2812Pixel_t Wheel(uint8_t position)
+{
+	ws2812Pixel_t pixel;
+
+	if(position < 85U)
+	{
+		pixel.red = 255U - position * 3U;
+		pixel.green = position * 3U;
+		pixel.blue = 0U;
+	}
+	else if(position < 170U)
+	{
+		position -= 85U;
+		pixel.red = 0U;
+		pixel.green = 255U - position * 3U;
+		pixel.blue = position * 3U;
+	}
+	else
+	{
+		position -= 170U;
+		pixel.red = position * 3U;
+		pixel.green = 0U;
+		pixel.blue = 255U - position * 3U;
+	}
+
+	return pixel;
+}
+
+void TPM1_IRQHandler(void)
+{
+	/* As bordas das fases A e B do encoder são capturadas pelos canais
+	 * 0 e 1 do TPM1 e decodificadas aqui.*/
+	Encoder_IRQHandler();
+}
+
 /*
  * @brief   Application entry point.
  */
@@ -54,7 +98,14 @@ int main(void) {
 	tpm_chnl_pwm_signal_param_t chnl_1_param  = {.chnlNumber 		 = kTPM_Chnl_1,
 												 .level 	 		 = kTPM_LowTrue,
 												 .dutyCycle = 0};
+	tpm_config_t tpm1_config;
+	tpm_config_t tpm0_config;
+	encoderConfig_t encoder_config;
+	ws2812Config_t strip_config;
+	uint32_t i;
+	encoderReading_t reading;
 	uint16_t updatedDutycycle = 0;
+	uint16_t steps = 0;
 	bool brightnessUp = true;
 
   	/* Init board hardware. */
@@ -82,8 +133,69 @@ int main(void) {
 
     TPM_StartTimer(TPM2, kTPM_SystemClock);
 
+    /* Encoder: fase A no PTA12 (TPM1_CH0) e fase B no PTA13 (TPM1_CH1).
+     * Os níveis das fases são lidos pelo GPIOA, mesmo com os pinos no TPM. */
+    PORT_SetPinMux(PORTA, 12U, kPORT_MuxAlt3);
+    PORT_SetPinMux(PORTA, 13U, kPORT_MuxAlt3);
+
+    /* Sem prescaler: a velocidade baixa é medida pelo tempo entre as
+     * bordas, com 21 ns de resolução. */
+    TPM_GetDefaultConfig(&tpm1_config);
+    tpm1_config.prescale = kTPM_Prescale_Divide_1;
+    TPM_Init(TPM1, &tpm1_config);
+
+    Encoder_GetDefaultConfig(&encoder_config);
+    encoder_config.base = TPM1;
+    encoder_config.counterClock_Hz = CLOCK_GetPllFllSelClkFreq();
+    encoder_config.gpioA = GPIOA;
+    encoder_config.pinMaskA = 1U << 12U;
+    encoder_config.gpioB = GPIOA;
+    encoder_config.pinMaskB = 1U << 13U;
+    Encoder_Init(&encoder_config);
+
+    TPM_StartTimer(TPM1, kTPM_SystemClock);
+
+    /* Fita de LEDs: cada bit é um período do PWM de 800 kHz do TPM0,
+     * com a largura escrita pelo DMA. Sem prescaler, para 21 ns de
+     * resolução nos tempos dos bits. */
+    CLOCK_EnableClock(kCLOCK_PortC);
+    PORT_SetPinMux(PORTC, 1U, kPORT_MuxAlt4);
+
+    TPM_GetDefaultConfig(&tpm0_config);
+    tpm0_config.prescale = kTPM_Prescale_Divide_1;
+    TPM_Init(TPM0, &tpm0_config);
+
+    Ws2812_GetDefaultConfig(&strip_config);
+    strip_config.base = TPM0;
+    strip_config.channel = kTPM_Chnl_0;
+    strip_config.counterClock_Hz = CLOCK_GetPllFllSelClkFreq();
+    strip_config.dmaChannel = 0U;
+    strip_config.brightness = WS2812_BRIGHTNESS_MAX / 4U;
+    if(Ws2812_Init(&strip_config) != kStatus_Success)
+    {
+    	for(;;);
+    }
+
+    /* A troca dos buffers da fita não pode esperar a interrupção do encoder. */
+    NVIC_SetPriority(DMA0_IRQn, 0U);
+    NVIC_SetPriority(TPM1_IRQn, 1U);
+
+    TPM_StartTimer(TPM0, kTPM_SystemClock);
+
     for(;;)
     {
+        /* Um novo quadro assim que o anterior termina: o arco-íris gira
+         * com a posição do encoder. */
+        if(!Ws2812_IsBusy())
+        {
+        	Encoder_GetReading(&reading);
+        	for(i = 0; i < STRIP_LEDS; i++)
+        	{
+        		strip[i] = Wheel((uint8_t)((i * 256U) / STRIP_LEDS + (uint32_t)reading.position));
+        	}
+        	Ws2812_Show(strip, STRIP_LEDS);
+        }
+
         /* Delays to see the change of LED brightness. */
         Delay_Waitus(50);
         if (brightnessUp)
@@ -104,6 +216,17 @@ int main(void) {
         }
         /* Starts PWM mode with an updated duty cycle. */
         TPM_UpdatePwmDutycycle(TPM2, kTPM_Chnl_1, kTPM_EdgeAlignedPwm, updatedDutycycle);
+
+        /* A cada 100 ms (2000 passos de 50 us), estima a velocidade e
+         * imprime a posição. */
+        if(++steps == 2000U)
+        {
+        	steps = 0;
+        	Encoder_Update();
+        	Encoder_GetReading(&reading);
+        	PRINTF("Position: %d counts, velocity: %d counts/s, errors: %u\n",
+        		   reading.position, reading.velocity / 256, reading.errors);
+        }
     }
 
     return 0 ;
@@ -0,0 +1,175 @@
+/**
+ * @file	tpm_capture.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * TPM input capture with 32 bit timestamps.
+ *
+ * The TPM counter runs free (MOD = 0xFFFF) and its overflows are counted
+ * by the overflow interrupt, giving the 16 upper bits of the time. So
+ * the pulses may be longer than one counter period, and the prescaler
+ * can be 1 (21 ns with the 48 MHz clock) with a range of 89 s.
+ *
+ * When a capture and an overflow are pending in the same interrupt, the
+ * captured value tells their order: a value in the lower half of the
+ * counter was taken after the overflow, one in the upper half before it.
+ * This holds while the interrupt latency is below half a counter period.
+ *
+ * The edges of all the enabled channels are put in a queue, with their
+ * channel and time, and are also passed to an optional callback. The
+ * pulse width or period is the unsigned difference of two timestamps,
+ * correct across the wrap of the 32 bits.
+ *
+ * The TPM must be previously initialized by TPM_Init() and started by
+ * TPM_StartTimer(). The application must call TpmCapture_IRQHandler()
+ * from the TPM interrupt handler.
+ *
+ */
+
+#ifndef TPM_CAPTURE_H_
+#define TPM_CAPTURE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "fsl_tpm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup tpm_capture
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Edges queued per TPM (power of two).*/
+#ifndef TPM_CAPTURE_QUEUE_SIZE
+#define TPM_CAPTURE_QUEUE_SIZE 16U
+#endif
+
+/*!
+ * @brief A captured edge.
+ */
+typedef struct{
+	uint32_t timestamp; /*!< Counter value extended to 32 bits.*/
+	tpm_chnl_t channel; /*!< Channel of the edge.*/
+}tpmCaptureEdge_t;
+
+/*!< Edge callback, called in interrupt context. Returns true to also put
+ *   the edge in the queue.*/
+typedef bool (*tpmCaptureCallback_t)(TPM_Type *base, const tpmCaptureEdge_t *edge, void *userData);
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Sets the counter to run free, clears the overflow count and the
+ *        queue, and enables the overflow interrupt.
+ *
+ * @param base     - TPM peripheral base address.
+ * @param callback - edge callback, can be NULL.
+ * @param userData - parameter passed to the callback.
+ *
+ * @return kStatus_Success if initialized;
+ *         kStatus_InvalidArgument if base is not a TPM.
+ *
+ */
+status_t TpmCapture_Init(TPM_Type *base, tpmCaptureCallback_t callback, void *userData);
+
+/**
+ * @brief Configures a channel for input capture and enables its interrupt.
+ *
+ * @param base    - TPM peripheral base address.
+ * @param channel - the channel.
+ * @param edge    - the edges captured.
+ *
+ */
+void TpmCapture_EnableChannel(TPM_Type *base, tpm_chnl_t channel, tpm_input_capture_edge_t edge);
+
+/**
+ * @brief Disables the capture of a channel.
+ *
+ * @param base    - TPM peripheral base address.
+ * @param channel - the channel.
+ *
+ */
+void TpmCapture_DisableChannel(TPM_Type *base, tpm_chnl_t channel);
+
+/**
+ * @brief Reads the current time, in the timestamp base.
+ *
+ * @param base - TPM peripheral base address.
+ *
+ * @return The counter value extended to 32 bits.
+ *
+ */
+uint32_t TpmCapture_GetTime(TPM_Type *base);
+
+/**
+ * @brief Gets the oldest queued edge.
+ *
+ * @param base - TPM peripheral base address.
+ * @param edge - where the edge is copied.
+ *
+ * @return true if an edge was copied, false if the queue is empty.
+ *
+ */
+bool TpmCapture_GetEdge(TPM_Type *base, tpmCaptureEdge_t *edge);
+
+/**
+ * @brief Discards all the queued edges.
+ *
+ * @param base - TPM peripheral base address.
+ *
+ */
+void TpmCapture_Flush(TPM_Type *base);
+
+/**
+ * @brief Gets the number of edges lost because the queue was full.
+ *
+ * @param base - TPM peripheral base address.
+ *
+ * @return The lost edges.
+ *
+ */
+uint32_t TpmCapture_GetLostEdges(TPM_Type *base);
+
+/**
+ * @brief The capture interrupt routine.
+ *
+ *        Must be called from the TPM interrupt handler (TPMn_IRQHandler()).
+ *
+ * @param base - TPM peripheral base address.
+ *
+ */
+void TpmCapture_IRQHandler(TPM_Type *base);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* TPM_CAPTURE_H_ */
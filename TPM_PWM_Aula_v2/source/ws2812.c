@@ -0,0 +1,381 @@
+/**
+ * @file	ws2812.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * WS2812 driver.
+ *
+ * The compare value is buffered and latched at the overflow, so the value
+ * moved by the DMA at an overflow is the high time of the period after
+ * the next one. Each word is a 32 bit access to CnV.
+ *
+ * The KL25 DMA has no descriptor chaining, so the DMA done interrupt must
+ * point the channel to the other buffer before the next bit. Each chunk
+ * ends with a 0 word, a bit period all low: a switch made after it only
+ * stretches this low time, which the LEDs take as part of the last bit
+ * while it is shorter than their reset time (some microseconds). The DMA
+ * interrupt must be served within this time, so it should have the
+ * highest priority.
+ *
+ * After the last LED, chunks of 0 words make the reset time, and the
+ * frame ends when the last one is moved.
+ *
+ */
+
+#include <string.h>
+#include "ws2812.h"
+#include "fsl_dmamux.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Bits per LED.*/
+#define WS2812_LED_BITS 24U
+
+/*!< Words of a chunk: the LED bits and the pause.*/
+#define WS2812_CHUNK_WORDS (WS2812_CHUNK_LEDS * WS2812_LED_BITS + 1U)
+
+/*!< Driver runtime data.*/
+typedef struct{
+	TPM_Type *base;
+	tpm_chnl_t channel;
+	uint32_t t0;                 /*!< Compare value of a 0 bit.*/
+	uint32_t t1;                 /*!< Compare value of a 1 bit.*/
+	uint32_t resetBits;          /*!< Reset time, in bit periods.*/
+	bool gammaCorrection;
+	volatile uint16_t brightness;
+	dma_handle_t dma;
+	uint32_t lengths[2];         /*!< Words of each buffer, 0 if none.*/
+	uint8_t playing;             /*!< Buffer being moved.*/
+	const ws2812Pixel_t *pixels;
+	uint16_t count;
+	uint16_t next;               /*!< Next LED to encode.*/
+	uint32_t resetLeft;          /*!< Reset bit periods to encode.*/
+	uint16_t frameBrightness;
+	volatile bool busy;
+	ws2812Callback_t callback;
+	void *userData;
+	ws2812Stats_t stats;
+}ws2812Handle_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Sets the channel to edge aligned PWM, high true, with CnV = 0.
+ *
+ */
+static void SetupPwm(TPM_Type *base, tpm_chnl_t channel);
+
+/**
+ * @brief Encodes a color, corrected and scaled, as 8 compare values,
+ *        the most significant bit first.
+ *
+ */
+static inline uint32_t *Encode(uint32_t *words, uint8_t color);
+
+/**
+ * @brief Encodes the next chunk of the frame into a buffer.
+ *
+ */
+static void Fill(uint8_t buffer);
+
+/**
+ * @brief DMA done: switches the buffers, or ends the frame.
+ *
+ */
+static void DmaCallback(dma_handle_t *handle, void *userData);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static ws2812Handle_t s_ws2812;
+
+/*!< The two chunk buffers.*/
+static uint32_t s_buffers[2][WS2812_CHUNK_WORDS];
+
+static TPM_Type *const s_tpmBases[] = TPM_BASE_PTRS;
+
+/*!< DMA request sources of the TPM overflows.*/
+static const dma_request_source_t s_overflowRequests[] = {
+	kDmaRequestMux0TPM0Overflow, kDmaRequestMux0TPM1Overflow, kDmaRequestMux0TPM2Overflow};
+
+/*!< Gamma 2.8: round(255 * (i / 255) ^ 2.8).*/
+static const uint8_t s_gamma[256] = {
+	  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+	  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,
+	  1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+	  2,   3,   3,   3,   3,   3,   3,   3,   4,   4,   4,   4,   4,   5,   5,   5,
+	  5,   6,   6,   6,   6,   7,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,
+	 10,  10,  11,  11,  11,  12,  12,  13,  13,  13,  14,  14,  15,  15,  16,  16,
+	 17,  17,  18,  18,  19,  19,  20,  20,  21,  21,  22,  22,  23,  24,  24,  25,
+	 25,  26,  27,  27,  28,  29,  29,  30,  31,  32,  32,  33,  34,  35,  35,  36,
+	 37,  38,  39,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  50,
+	 51,  52,  54,  55,  56,  57,  58,  59,  60,  61,  62,  63,  64,  66,  67,  68,
+	 69,  70,  72,  73,  74,  75,  77,  78,  79,  81,  82,  83,  85,  86,  87,  89,
+	 90,  92,  93,  95,  96,  98,  99, 101, 102, 104, 105, 107, 109, 110, 112, 114,
+	115, 117, 119, 120, 122, 124, 126, 127, 129, 131, 133, 135, 137, 138, 140, 142,
+	144, 146, 148, 150, 152, 154, 156, 158, 160, 162, 164, 167, 169, 171, 173, 175,
+	177, 180, 182, 184, 186, 189, 191, 193, 196, 198, 200, 203, 205, 208, 210, 213,
+	215, 218, 220, 223, 225, 228, 231, 233, 236, 239, 241, 244, 247, 249, 252, 255,
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void SetupPwm(TPM_Type *base, tpm_chnl_t channel)
+{
+	uint32_t modeMask = TPM_CnSC_MSA_MASK | TPM_CnSC_MSB_MASK | TPM_CnSC_ELSA_MASK | TPM_CnSC_ELSB_MASK;
+
+	/* As TPM_SetupPwm(): the mode change is acknowledged. */
+	base->CONTROLS[channel].CnSC &= ~modeMask;
+	while(base->CONTROLS[channel].CnSC & modeMask)
+	{
+	}
+	base->CONTROLS[channel].CnSC |= TPM_CnSC_MSB_MASK | TPM_CnSC_ELSB_MASK;
+	base->CONTROLS[channel].CnV = 0U;
+	while(!(base->CONTROLS[channel].CnSC & modeMask))
+	{
+	}
+}
+
+static inline uint32_t *Encode(uint32_t *words, uint8_t color)
+{
+	uint32_t value, mask;
+
+	value = s_ws2812.gammaCorrection ? s_gamma[color] : color;
+	value = (value * s_ws2812.frameBrightness) >> 8U;
+
+	for(mask = 0x80U; mask != 0U; mask >>= 1U)
+	{
+		*words++ = (value & mask) ? s_ws2812.t1 : s_ws2812.t0;
+	}
+
+	return words;
+}
+
+static void Fill(uint8_t buffer)
+{
+	uint32_t *words = s_buffers[buffer];
+	const ws2812Pixel_t *pixel;
+	uint16_t leds;
+
+	if(s_ws2812.next < s_ws2812.count)
+	{
+		leds = s_ws2812.count - s_ws2812.next;
+		if(leds > WS2812_CHUNK_LEDS)
+		{
+			leds = WS2812_CHUNK_LEDS;
+		}
+
+		/* Strip order: green, red, blue. */
+		for(pixel = &s_ws2812.pixels[s_ws2812.next]; pixel < &s_ws2812.pixels[s_ws2812.next + leds]; pixel++)
+		{
+			words = Encode(words, pixel->green);
+			words = Encode(words, pixel->red);
+			words = Encode(words, pixel->blue);
+		}
+		*words++ = 0U;
+		s_ws2812.next += leds;
+		s_ws2812.lengths[buffer] = words - s_buffers[buffer];
+	}
+	else if(s_ws2812.resetLeft != 0U)
+	{
+		s_ws2812.lengths[buffer] = (s_ws2812.resetLeft < WS2812_CHUNK_WORDS) ? s_ws2812.resetLeft : WS2812_CHUNK_WORDS;
+		memset(words, 0, s_ws2812.lengths[buffer] * sizeof(uint32_t));
+		s_ws2812.resetLeft -= s_ws2812.lengths[buffer];
+	}
+	else
+	{
+		s_ws2812.lengths[buffer] = 0U;
+	}
+}
+
+static void DmaCallback(dma_handle_t *handle, void *userData)
+{
+	uint8_t done = s_ws2812.playing;
+	uint8_t other = done ^ 1U;
+
+	(void)userData;
+
+	/* DONE was cleared by DMA_HandleIRQ() and the request disabled (D_REQ). */
+	if(s_ws2812.lengths[other] != 0U)
+	{
+		/* First the DMA: the pause bit is playing. */
+		DMA_SetSourceAddress(handle->base, handle->channel, (uint32_t)s_buffers[other]);
+		DMA_SetTransferSize(handle->base, handle->channel, s_ws2812.lengths[other] * sizeof(uint32_t));
+		DMA_EnableChannelRequest(handle->base, handle->channel);
+		s_ws2812.playing = other;
+		s_ws2812.stats.chunks++;
+
+		Fill(done);
+		return;
+	}
+
+	/* The last reset word was moved: the pin stays low. */
+	s_ws2812.base->SC &= ~(TPM_SC_TOF_MASK | TPM_SC_DMA_MASK);
+	s_ws2812.busy = false;
+	s_ws2812.stats.frames++;
+
+	if(s_ws2812.callback != NULL)
+	{
+		s_ws2812.callback(s_ws2812.userData);
+	}
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+void Ws2812_GetDefaultConfig(ws2812Config_t *config)
+{
+	memset(config, 0, sizeof(ws2812Config_t));
+	config->channel = kTPM_Chnl_0;
+	config->bitRate_Hz = 800000U;
+	config->t0h_ns = 350U;
+	config->t1h_ns = 800U;
+	config->reset_us = 300U;
+	config->gammaCorrection = true;
+	config->brightness = WS2812_BRIGHTNESS_MAX;
+}
+
+status_t Ws2812_Init(const ws2812Config_t *config)
+{
+	dma_transfer_config_t transferConfig;
+	uint32_t instance, period, t0, t1;
+
+	if((config == NULL) || (config->base == NULL) || (config->bitRate_Hz == 0U) ||
+	   (config->reset_us == 0U) || (config->brightness > WS2812_BRIGHTNESS_MAX) ||
+	   (config->dmaChannel >= FSL_FEATURE_DMA_MODULE_CHANNEL))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	for(instance = 0U; instance < ARRAY_SIZE(s_tpmBases); instance++)
+	{
+		if(s_tpmBases[instance] == config->base)
+		{
+			break;
+		}
+	}
+	if((instance == ARRAY_SIZE(s_tpmBases)) ||
+	   ((uint32_t)config->channel >= (uint32_t)FSL_FEATURE_TPM_CHANNEL_COUNTn(config->base)))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	/* Rounded ticks: the bits must be told apart by whole counts. */
+	period = (config->counterClock_Hz + config->bitRate_Hz / 2U) / config->bitRate_Hz;
+	t0 = (uint32_t)(((uint64_t)config->counterClock_Hz * config->t0h_ns + 500000000U) / 1000000000U);
+	t1 = (uint32_t)(((uint64_t)config->counterClock_Hz * config->t1h_ns + 500000000U) / 1000000000U);
+	if((t0 == 0U) || (t1 <= t0) || (t1 >= period) || (period > 0x10000U))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	memset(&s_ws2812, 0, sizeof(s_ws2812));
+	s_ws2812.base = config->base;
+	s_ws2812.channel = config->channel;
+	s_ws2812.t0 = t0;
+	s_ws2812.t1 = t1;
+	s_ws2812.resetBits = (uint32_t)(((uint64_t)config->reset_us * config->bitRate_Hz + 999999U) / 1000000U);
+	s_ws2812.gammaCorrection = config->gammaCorrection;
+	s_ws2812.brightness = config->brightness;
+	s_ws2812.callback = config->callback;
+	s_ws2812.userData = config->userData;
+
+	TPM_SetTimerPeriod(config->base, period - 1U);
+	SetupPwm(config->base, config->channel);
+
+	DMAMUX_Init(DMAMUX0);
+	DMA_Init(DMA0);
+
+	DMAMUX_DisableChannel(DMAMUX0, config->dmaChannel);
+	DMAMUX_SetSource(DMAMUX0, config->dmaChannel, s_overflowRequests[instance] & 0xFFU);
+	DMAMUX_EnableChannel(DMAMUX0, config->dmaChannel);
+
+	DMA_CreateHandle(&s_ws2812.dma, DMA0, config->dmaChannel);
+	DMA_SetCallback(&s_ws2812.dma, DmaCallback, &s_ws2812);
+	DMA_PrepareTransfer(&transferConfig, s_buffers[0], sizeof(uint32_t),
+	                    (void *)&config->base->CONTROLS[config->channel].CnV, sizeof(uint32_t),
+	                    sizeof(uint32_t), kDMA_MemoryToPeripheral);
+	/* Cycle steal and request disabled at the end of each chunk (D_REQ). */
+	DMA_SubmitTransfer(&s_ws2812.dma, &transferConfig, kDMA_EnableInterrupt);
+
+	return kStatus_Success;
+}
+
+void Ws2812_SetBrightness(uint16_t brightness)
+{
+	s_ws2812.brightness = (brightness > WS2812_BRIGHTNESS_MAX) ? WS2812_BRIGHTNESS_MAX : brightness;
+}
+
+status_t Ws2812_Show(const ws2812Pixel_t *pixels, uint16_t count)
+{
+	TPM_Type *base = s_ws2812.base;
+
+	if((pixels == NULL) || (count == 0U))
+	{
+		return kStatus_InvalidArgument;
+	}
+	if(s_ws2812.busy)
+	{
+		return kStatus_Ws2812_Busy;
+	}
+
+	s_ws2812.pixels = pixels;
+	s_ws2812.count = count;
+	s_ws2812.next = 0U;
+	s_ws2812.resetLeft = s_ws2812.resetBits;
+	s_ws2812.frameBrightness = s_ws2812.brightness;
+
+	/* Both buffers ready: the second is needed one chunk later. */
+	Fill(0U);
+	Fill(1U);
+	s_ws2812.playing = 0U;
+	s_ws2812.busy = true;
+
+	DMA_SetSourceAddress(DMA0, s_ws2812.dma.channel, (uint32_t)s_buffers[0]);
+	DMA_SetTransferSize(DMA0, s_ws2812.dma.channel, s_ws2812.lengths[0] * sizeof(uint32_t));
+	DMA_EnableChannelRequest(DMA0, s_ws2812.dma.channel);
+
+	/* The first word is moved at the next overflow, so the first bit
+	 * starts after a whole low period. */
+	TPM_ClearStatusFlags(base, kTPM_TimeOverflowFlag);
+	base->SC = (base->SC & ~TPM_SC_TOF_MASK) | TPM_SC_DMA_MASK;
+
+	return kStatus_Success;
+}
+
+bool Ws2812_IsBusy(void)
+{
+	return s_ws2812.busy;
+}
+
+void Ws2812_GetStats(ws2812Stats_t *stats)
+{
+	uint32_t primask = DisableGlobalIRQ();
+
+	*stats = s_ws2812.stats;
+	EnableGlobalIRQ(primask);
+}
@@ -0,0 +1,190 @@
+/**
+ * @file	ws2812.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * WS2812 (NeoPixel) LED strip driver by TPM PWM and DMA.
+ *
+ * Each data bit is one PWM period of 1.25 us (800 kHz) with a short (0)
+ * or long (1) high time. The DMA writes the compare value of each bit at
+ * each TPM overflow, so the bit timing is exact with the interrupts
+ * enabled, and the CPU only encodes the bits.
+ *
+ * The bits are not kept for the whole strip: the pixels are encoded, a
+ * few LEDs at a time (WS2812_CHUNK_LEDS), into two small buffers that the
+ * DMA plays alternately. The DMA done interrupt switches the buffers and
+ * encodes the next LEDs into the free one. The encoding applies the gamma
+ * correction and the brightness scale to each color, and sends them in
+ * the strip order (green, red, blue).
+ *
+ * Ws2812_Show() starts a frame and returns at once; the frame ends with
+ * the reset time (low level) that latches the colors, and then the
+ * callback is called. The pixels must not be changed until then. With
+ * 48 MHz counter clock, 300 LEDs take 9.3 ms per frame (100 fps).
+ *
+ * The TPM must be previously initialized by TPM_Init() without prescaler
+ * (a counter clock of 8 MHz or more) and started by TPM_StartTimer(); its
+ * period is set to the bit period, so the other channels of the TPM can
+ * only share it. The DMA interrupt is handled by the fsl_dma driver and
+ * must be served within a few microseconds (see ws2812.c), so it should
+ * have the highest priority.
+ *
+ */
+
+#ifndef WS2812_H_
+#define WS2812_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "fsl_tpm.h"
+#include "fsl_dma.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup ws2812
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< LEDs encoded at a time in each buffer (24 words + 1 per LED).*/
+#define WS2812_CHUNK_LEDS 8U
+
+/*!< Full brightness (Q8).*/
+#define WS2812_BRIGHTNESS_MAX 256U
+
+/*!< Status codes.*/
+enum _ws2812_status{
+	kStatus_Ws2812_Busy = MAKE_STATUS(kStatusGroup_ApplicationRangeStart, 0), /*!< A frame is being sent.*/
+};
+
+/*!
+ * @brief A pixel color.
+ */
+typedef struct{
+	uint8_t red;
+	uint8_t green;
+	uint8_t blue;
+}ws2812Pixel_t;
+
+/*!< Frame done callback, called in interrupt context after the reset time.*/
+typedef void (*ws2812Callback_t)(void *userData);
+
+/*!
+ * @brief Driver configuration structure.
+ */
+typedef struct{
+	TPM_Type *base;           /*!< TPM of the data pin.*/
+	tpm_chnl_t channel;       /*!< Data channel.*/
+	uint32_t counterClock_Hz; /*!< TPM counter clock (after the prescaler).*/
+	uint8_t dmaChannel;       /*!< DMA channel used.*/
+	uint32_t bitRate_Hz;      /*!< Bit rate (800 kHz).*/
+	uint16_t t0h_ns;          /*!< High time of a 0 bit.*/
+	uint16_t t1h_ns;          /*!< High time of a 1 bit.*/
+	uint16_t reset_us;        /*!< Low time that latches the frame.*/
+	bool gammaCorrection;     /*!< Gamma 2.8 correction of the colors.*/
+	uint16_t brightness;      /*!< Brightness, Q8 (0 to WS2812_BRIGHTNESS_MAX).*/
+	ws2812Callback_t callback; /*!< Frame done callback, can be NULL.*/
+	void *userData;           /*!< Parameter passed to the callback.*/
+}ws2812Config_t;
+
+/*!< Driver counters.*/
+typedef struct{
+	uint32_t frames; /*!< Frames sent.*/
+	uint32_t chunks; /*!< Buffer switches.*/
+}ws2812Stats_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Gets the default configuration: channel 0, DMA channel 0,
+ *        800 kHz, 350/800 ns high times (WS2812 and WS2812B), 300 us
+ *        reset, gamma correction and full brightness.
+ *
+ * @param config - the configuration to be filled.
+ *
+ */
+void Ws2812_GetDefaultConfig(ws2812Config_t *config);
+
+/**
+ * @brief Configures the TPM period, the channel and the DMA. The data pin
+ *        is kept low.
+ *
+ * @param config - the configuration.
+ *
+ * @return kStatus_Success if configured;
+ *         kStatus_InvalidArgument if any parameter is invalid, or if the
+ *         counter clock is too slow for the bit times.
+ *
+ */
+status_t Ws2812_Init(const ws2812Config_t *config);
+
+/**
+ * @brief Sets the brightness of the next frames.
+ *
+ * @param brightness - Q8, 0 to WS2812_BRIGHTNESS_MAX.
+ *
+ */
+void Ws2812_SetBrightness(uint16_t brightness);
+
+/**
+ * @brief Starts sending a frame, without blocking.
+ *
+ * @param pixels - the colors, from the first LED; must be kept until the
+ *                 callback (or until Ws2812_IsBusy() returns false).
+ * @param count  - number of LEDs.
+ *
+ * @return kStatus_Success if started;
+ *         kStatus_Ws2812_Busy if a frame is being sent;
+ *         kStatus_InvalidArgument if there are no pixels.
+ *
+ */
+status_t Ws2812_Show(const ws2812Pixel_t *pixels, uint16_t count);
+
+/**
+ * @brief Tells if a frame is being sent.
+ *
+ * @return True until the end of the reset time.
+ *
+ */
+bool Ws2812_IsBusy(void);
+
+/**
+ * @brief Copies the driver counters.
+ *
+ * @param stats - where the counters will be copied.
+ *
+ */
+void Ws2812_GetStats(ws2812Stats_t *stats);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* WS2812_H_ */
@@ -40,11 +40,56 @@
 #include "MKL25Z4.h"
 #include "fsl_debug_console.h"
 #include "fsl_tpm.h"
+#include "fsl_port.h"
 /* TODO: insert other include files here. */
+#include "tpm_plan.h"
+#include "waveform.h"
 
 /* TODO: insert other definitions and declarations here. */
-tpm_config_t tpm0_config;
-const gpio_pin_config_t ptb19_config = {kGPIO_DigitalOutput, 1};
+
+/* Frequência da onda quadrada do LED verde (PTB19, TPM2_CH1). */
+#define LED_HZ 4U
+
+/* Rampa de passos de motor de passo em PTC1 (TPM0_CH0): acelera de
+ * STEP_MIN_HZ a STEP_MAX_HZ e desacelera, em RAMP_STEPS passos cada. */
+#define STEP_MIN_HZ 100U
+#define STEP_MAX_HZ 2000U
+#define STEP_PULSE_US 10U
+#define RAMP_STEPS 64U
+
+tpm_config_t tpm_config;
+tpmPlanRequest_t tpm_request;
+tpmPlan_t tpm2_plan;
+tpmPlan_t tpm0_plan;
+waveformConfig_t step_config;
+uint32_t step_clock;
+
+/* As tabelas são convertidas no lugar: são preenchidas de novo a cada envio. */
+uint32_t ramps[2][RAMP_STEPS];
+volatile uint32_t *free_ramp;
+
+/* Preenche uma tabela com os períodos da aceleração ou da desaceleração. */
+static void FillRamp(uint32_t *ramp, bool up)
+{
+    uint32_t i, f;
+
+    for(i = 0; i < RAMP_STEPS; i++)
+    {
+    	f = STEP_MIN_HZ + ((STEP_MAX_HZ - STEP_MIN_HZ) * i) / (RAMP_STEPS - 1U);
+    	ramp[up ? i : (RAMP_STEPS - 1U - i)] = step_clock / f;
+    }
+}
+
+/* Chamada pela interrupção do DMA ao fim de cada tabela. */
+static void StepCallback(uint32_t *table, uint32_t events, void *userData)
+{
+	(void)userData;
+
+	if(events & kWaveform_EventTableDone)
+	{
+		free_ramp = table;
+	}
+}
 
 /*
  * @brief   Application entry point.
@@ -58,30 +103,76 @@ int main(void) {
     /* Init FSL debug console. */
     BOARD_InitDebugConsole();
 
-    GPIO_PinInit(GPIOB, 19, &ptb19_config);
+    /* PTB19 e PTC1 com a função do TPM: as bordas são feitas pelo
+     * hardware, sem interrupção. */
+    CLOCK_EnableClock(kCLOCK_PortC);
+    PORT_SetPinMux(PORTB, 19U, kPORT_MuxAlt3);
+    PORT_SetPinMux(PORTC, 1U, kPORT_MuxAlt4);
 
-    TPM_GetDefaultConfig(&tpm0_config);
-    tpm0_config.prescale = kTPM_Prescale_Divide_128;
-    TPM_Init (TPM0, &tpm0_config);
-    CLOCK_SetTpmClock(1);
+    /* Em vez de escolher o prescaler e o período à mão, o planejador
+     * procura o prescaler com o menor erro de frequência e a maior
+     * resolução. A fonte de clock é a mesma para os dois TPMs. */
+    TpmPlan_GetDefaultRequest(&tpm_request, 2U * LED_HZ);
+    tpm_request.sources = TPM_PLAN_SOURCE(kTpmPlan_PllFllSelClk);
+    if(TpmPlan_Find(&tpm_request, &tpm2_plan) != kStatus_Success)
+    {
+    	for(;;);
+    }
+    TpmPlan_GetDefaultRequest(&tpm_request, STEP_MIN_HZ);
+    tpm_request.sources = TPM_PLAN_SOURCE(kTpmPlan_PllFllSelClk);
+    if(TpmPlan_Find(&tpm_request, &tpm0_plan) != kStatus_Success)
+    {
+    	for(;;);
+    }
 
-    TPM_SetTimerPeriod(TPM0, 0xBFFFU);
-    TPM_EnableInterrupts (TPM0, kTPM_TimeOverflowInterruptEnable);
-    NVIC_EnableIRQ(TPM0_IRQn);
+    TPM_GetDefaultConfig(&tpm_config);
+    TPM_Init (TPM2, &tpm_config);
+    TPM_Init (TPM0, &tpm_config);
+    TpmPlan_Apply(TPM2, &tpm2_plan);
+    TpmPlan_Apply(TPM0, &tpm0_plan);
+    TPM_StartTimer(TPM2, kTPM_SystemClock);
     TPM_StartTimer(TPM0, kTPM_SystemClock);
 
-    for(;;);
+    PRINTF("TPM2: source %u (%u Hz), prescaler %u, MOD %u, %u Hz (%d ppm)\n",
+    	   tpm2_plan.source, tpm2_plan.sourceClock_Hz, 1U << tpm2_plan.prescale,
+    	   tpm2_plan.mod, tpm2_plan.frequency_Hz, tpm2_plan.error_ppm);
 
-    return 0;
-}
+    /* O LED pisca pelo modo toggle da comparação, sem CPU. */
+    Waveform_StartSquare(TPM2, kTPM_Chnl_1, tpm2_plan.sourceClock_Hz >> tpm2_plan.prescale, LED_HZ);
 
-void TPM0_IRQHandler(void)
-{
-    if((TPM_GetStatusFlags(TPM0) & kTPM_TimeOverflowFlag) != 0)
+    /* Pulsos de largura fixa com o período de cada um vindo de uma
+     * tabela, escrito no MOD pelo DMA a cada estouro. */
+    step_clock = tpm0_plan.sourceClock_Hz >> tpm0_plan.prescale;
+    Waveform_GetDefaultConfig(&step_config);
+    step_config.base = TPM0;
+    step_config.channel = kTPM_Chnl_0;
+    step_config.dmaChannel = 0U;
+    step_config.mode = kWaveform_PulsePeriods;
+    step_config.pulseWidth = (step_clock * STEP_PULSE_US) / 1000000U;
+    step_config.callback = StepCallback;
+    if((step_config.pulseWidth == 0U) || (Waveform_Init(&step_config) != kStatus_Success))
     {
-        GPIO_TogglePinsOutput(GPIOB, 1 << 19);
+    	for(;;);
     }
 
-    TPM_ClearStatusFlags(TPM0, kTPM_TimeOverflowFlag);
-}
+    FillRamp(ramps[0], true);
+    FillRamp(ramps[1], false);
+    Waveform_Submit(ramps[0], RAMP_STEPS);
+    Waveform_Submit(ramps[1], RAMP_STEPS);
+    Waveform_Start();
+
+    for(;;)
+    {
+    	/* A tabela livre entra de novo na fila, alternando subida e descida. */
+    	if(free_ramp != NULL)
+    	{
+    		uint32_t *ramp = (uint32_t *)free_ramp;
 
+    		free_ramp = NULL;
+    		FillRamp(ramp, ramp == ramps[0]);
+    		Waveform_Submit(ramp, RAMP_STEPS);
+    	}
+    }
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file	tpm_plan.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * TPM planner.
+ *
+ * The counts per period are rounded, not truncated as by TPM_SetupPwm(),
+ * so the error is at most half a count. The errors are compared as
+ * |counter - steps * f| / (steps * f), by cross multiplication in 64 bits.
+ *
+ */
+
+#include <string.h>
+#include "tpm_plan.h"
+#include "fsl_clock.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Number of prescalers.*/
+#define TPM_PLAN_PRESCALERS 8U
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Gets the current frequency of a source, 0 if disabled.
+ *
+ */
+static uint32_t GetSourceClock(tpmPlanSource_t source);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t GetSourceClock(tpmPlanSource_t source)
+{
+	switch(source)
+	{
+		case kTpmPlan_PllFllSelClk:
+			return CLOCK_GetPllFllSelClkFreq();
+		case kTpmPlan_OscErClk:
+			return CLOCK_GetOsc0ErClkFreq();
+		case kTpmPlan_McgIrClk:
+			return CLOCK_GetInternalRefClkFreq();
+		default:
+			return 0U;
+	}
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+void TpmPlan_GetDefaultRequest(tpmPlanRequest_t *request, uint32_t frequency_Hz)
+{
+	memset(request, 0, sizeof(tpmPlanRequest_t));
+	request->frequency_Hz = frequency_Hz;
+	request->sources = TPM_PLAN_ALL_SOURCES;
+}
+
+status_t TpmPlan_Find(const tpmPlanRequest_t *request, tpmPlan_t *plan)
+{
+	uint32_t source, clock, counter, ps, steps, maxSteps, divider;
+	uint64_t made, error, bestError = 0U, bestMade = 1U;
+	bool found = false;
+
+	if((request == NULL) || (request->frequency_Hz == 0U))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	/* Counts per period, by the counter clock: f or 2f (up-down). */
+	divider = request->centerAligned ? 2U : 1U;
+	maxSteps = request->centerAligned ? 0x7FFFU : 0x10000U;
+
+	for(source = kTpmPlan_PllFllSelClk; source <= kTpmPlan_McgIrClk; source++)
+	{
+		clock = GetSourceClock((tpmPlanSource_t)source);
+		if(!(request->sources & TPM_PLAN_SOURCE(source)) || (clock == 0U))
+		{
+			continue;
+		}
+
+		for(ps = 0U; ps < TPM_PLAN_PRESCALERS; ps++)
+		{
+			counter = clock >> ps;
+			made = (uint64_t)request->frequency_Hz * divider;
+			steps = (uint32_t)((counter + made / 2U) / made);
+			if((steps < 2U) || (steps > maxSteps) || (steps < request->minSteps))
+			{
+				continue;
+			}
+			if((request->maxTick_ns != 0U) &&
+			   ((uint64_t)request->maxTick_ns * counter < 1000000000U))
+			{
+				continue;
+			}
+
+			/* |counter - steps * f| / (steps * f), against the best. */
+			made *= steps;
+			error = (counter > made) ? (counter - made) : (made - counter);
+			if(found && ((error * bestMade > bestError * made) ||
+			             ((error * bestMade == bestError * made) && (steps <= plan->steps))))
+			{
+				continue;
+			}
+
+			found = true;
+			bestError = error;
+			bestMade = made;
+			plan->source = (tpmPlanSource_t)source;
+			plan->sourceClock_Hz = clock;
+			plan->prescale = (tpm_clock_prescale_t)ps;
+			plan->steps = steps;
+			plan->mod = request->centerAligned ? steps : (steps - 1U);
+			plan->frequency_Hz = (uint32_t)((counter + (uint64_t)steps * divider / 2U) / ((uint64_t)steps * divider));
+			plan->error_ppm = (int32_t)((((int64_t)counter - (int64_t)made) * 1000000) / (int64_t)made);
+		}
+	}
+
+	return found ? kStatus_Success : kStatus_OutOfRange;
+}
+
+void TpmPlan_Apply(TPM_Type *base, const tpmPlan_t *plan)
+{
+	TPM_StopTimer(base);
+	CLOCK_SetTpmClock(plan->source);
+	base->SC = (base->SC & ~TPM_SC_PS_MASK) | TPM_SC_PS(plan->prescale);
+	TPM_SetTimerPeriod(base, plan->mod);
+}
@@ -0,0 +1,183 @@
+/**
+ * @file	tpm_plan.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * TPM clock source, prescaler and modulus planner.
+ *
+ * For a period frequency (overflow or PWM frequency), TpmPlan_Find()
+ * tries the TPM clock sources of CLOCK_SetTpmClock() with their current
+ * frequency and the 8 prescalers, and keeps the configuration with the
+ * lowest frequency error; between equal errors, the one with more counts
+ * per period (the best duty cycle or time resolution). A request can
+ * also ask for a minimum of counts per period or a maximum tick period.
+ *
+ * The clock source is common to all the TPMs (SIM->SOPT2[TPMSRC]), so
+ * plans for more than one TPM should be found with the same source.
+ *
+ * For a clock known at compile time, TPM_PLAN_PRESCALE() and
+ * TPM_PLAN_MOD() give the smallest prescaler and its modulus as constant
+ * expressions, usable in initializers, with no code:
+ *
+ *   #define BLINK_PRESCALE TPM_PLAN_PRESCALE(48000000U, 8U, false)
+ *   #define BLINK_MOD      TPM_PLAN_MOD(48000000U, 8U, false)
+ *
+ */
+
+#ifndef TPM_PLAN_H_
+#define TPM_PLAN_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "fsl_tpm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup tpm_plan
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Counts per period with a prescaler (ps = 0 to 7), rounded.*/
+#define TPM_PLAN_STEPS(clock_Hz, frequency_Hz, centerAligned, ps) \
+	((((clock_Hz) >> (ps)) + ((frequency_Hz) * ((centerAligned) ? 2U : 1U)) / 2U) / ((frequency_Hz) * ((centerAligned) ? 2U : 1U)))
+
+/*!< True if the counts fit in the modulus (edge aligned: MOD + 1 counts,
+ *   center aligned: MOD up to 0x7FFF, 2 * MOD counts).*/
+#define TPM_PLAN_FITS(clock_Hz, frequency_Hz, centerAligned, ps) \
+	(TPM_PLAN_STEPS(clock_Hz, frequency_Hz, centerAligned, ps) <= ((centerAligned) ? 0x7FFFU : 0x10000U))
+
+/*!< Smallest prescaler (tpm_clock_prescale_t) whose counts fit, constant
+ *   folded. Checks TPM_PLAN_VALID() for the largest one.*/
+#define TPM_PLAN_PRESCALE(clock_Hz, frequency_Hz, centerAligned)      \
+	(TPM_PLAN_FITS(clock_Hz, frequency_Hz, centerAligned, 0U) ? 0U : \
+	 TPM_PLAN_FITS(clock_Hz, frequency_Hz, centerAligned, 1U) ? 1U : \
+	 TPM_PLAN_FITS(clock_Hz, frequency_Hz, centerAligned, 2U) ? 2U : \
+	 TPM_PLAN_FITS(clock_Hz, frequency_Hz, centerAligned, 3U) ? 3U : \
+	 TPM_PLAN_FITS(clock_Hz, frequency_Hz, centerAligned, 4U) ? 4U : \
+	 TPM_PLAN_FITS(clock_Hz, frequency_Hz, centerAligned, 5U) ? 5U : \
+	 TPM_PLAN_FITS(clock_Hz, frequency_Hz, centerAligned, 6U) ? 6U : 7U)
+
+/*!< Modulus of TPM_PLAN_PRESCALE(), constant folded.*/
+#define TPM_PLAN_MOD(clock_Hz, frequency_Hz, centerAligned)                                                     \
+	(TPM_PLAN_STEPS(clock_Hz, frequency_Hz, centerAligned, TPM_PLAN_PRESCALE(clock_Hz, frequency_Hz, centerAligned)) - \
+	 ((centerAligned) ? 0U : 1U))
+
+/*!< True if the frequency can be made from the clock, to be checked by a
+ *   static assertion.*/
+#define TPM_PLAN_VALID(clock_Hz, frequency_Hz, centerAligned)            \
+	(((frequency_Hz) != 0U) && TPM_PLAN_FITS(clock_Hz, frequency_Hz, centerAligned, 7U) && \
+	 (TPM_PLAN_STEPS(clock_Hz, frequency_Hz, centerAligned, 0U) >= 2U))
+
+/*!
+ * @brief TPM clock sources, with the values of CLOCK_SetTpmClock().
+ */
+typedef enum{
+	kTpmPlan_PllFllSelClk = 1U, /*!< MCGFLLCLK or MCGPLLCLK / 2.*/
+	kTpmPlan_OscErClk = 2U,     /*!< OSCERCLK.*/
+	kTpmPlan_McgIrClk = 3U,     /*!< MCGIRCLK.*/
+}tpmPlanSource_t;
+
+/*!< Source mask bit of a source.*/
+#define TPM_PLAN_SOURCE(source) (1U << (source))
+
+/*!< All the sources.*/
+#define TPM_PLAN_ALL_SOURCES (TPM_PLAN_SOURCE(kTpmPlan_PllFllSelClk) | \
+                              TPM_PLAN_SOURCE(kTpmPlan_OscErClk) |    \
+                              TPM_PLAN_SOURCE(kTpmPlan_McgIrClk))
+
+/*!
+ * @brief A planner request.
+ */
+typedef struct{
+	uint32_t frequency_Hz; /*!< Period frequency.*/
+	uint32_t minSteps;     /*!< Minimum counts per period (0 for none).*/
+	uint32_t maxTick_ns;   /*!< Maximum counter tick period (0 for none).*/
+	bool centerAligned;    /*!< Center aligned PWM (up-down counter).*/
+	uint8_t sources;       /*!< Sources tried, TPM_PLAN_SOURCE() bits.*/
+}tpmPlanRequest_t;
+
+/*!
+ * @brief A plan.
+ */
+typedef struct{
+	tpmPlanSource_t source;         /*!< Clock source, for CLOCK_SetTpmClock().*/
+	uint32_t sourceClock_Hz;        /*!< Source frequency.*/
+	tpm_clock_prescale_t prescale;  /*!< Prescaler.*/
+	uint32_t mod;                   /*!< Modulus, for TPM_SetTimerPeriod().*/
+	uint32_t steps;                 /*!< Duty cycle steps: counts per period (edge
+	                                     aligned) or per half period (center aligned).*/
+	uint32_t frequency_Hz;          /*!< Period frequency made, rounded.*/
+	int32_t error_ppm;              /*!< Frequency error, in parts per million.*/
+}tpmPlan_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Gets a request for a frequency with the default constraints:
+ *        no minimum resolution and all the sources.
+ *
+ * @param request      - the request to be filled.
+ * @param frequency_Hz - the period frequency.
+ *
+ */
+void TpmPlan_GetDefaultRequest(tpmPlanRequest_t *request, uint32_t frequency_Hz);
+
+/**
+ * @brief Finds the best source, prescaler and modulus for a request.
+ *
+ * @param request - the request.
+ * @param plan    - where the plan is written.
+ *
+ * @return kStatus_Success if a plan was found;
+ *         kStatus_InvalidArgument if the frequency is 0;
+ *         kStatus_OutOfRange if no configuration meets the request.
+ *
+ */
+status_t TpmPlan_Find(const tpmPlanRequest_t *request, tpmPlan_t *plan);
+
+/**
+ * @brief Applies a plan: selects the TPM clock source (for all the TPMs)
+ *        and sets the prescaler and the modulus of a stopped TPM.
+ *
+ *        The TPM must be previously initialized by TPM_Init(); it must be
+ *        started by TPM_StartTimer() after.
+ *
+ * @param base - TPM peripheral base address.
+ * @param plan - the plan.
+ *
+ */
+void TpmPlan_Apply(TPM_Type *base, const tpmPlan_t *plan);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* TPM_PLAN_H_ */
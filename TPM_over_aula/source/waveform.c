@@ -0,0 +1,550 @@
+/**
+ * @file	waveform.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Waveform generator.
+ *
+ * The DMA channel is requested by the TPM event of the mode: the channel
+ * match for the edge times, the overflow for the PWM modes. Each request
+ * moves one 32 bit value (the TPM registers take only 32 bit accesses)
+ * and clears the TPM flag. At the end of a table the request is disabled
+ * by the hardware (D_REQ) and the DMA done interrupt loads the next one;
+ * a TPM event before the reload keeps its flag set, so it is moved late
+ * when the request is enabled again, and counted.
+ *
+ * Edge times: in output compare, CnV is updated at once. The value moved
+ * at a match is the time of the next edge, so a table ends with its last
+ * edge still to happen, and the reload has that edge interval to be done.
+ * The first time of the first table is written by the CPU. At an underrun
+ * the channel goes from toggle to set or clear on match, the same output
+ * compare mode, so the last edge drives the idle level and the later
+ * matches keep it.
+ *
+ * PWM modes: CnV and MOD are buffered and latched at the overflow, so the
+ * value moved at an overflow plays in the period after the next one. The
+ * first period after the start is idle (CnV = 0); the first value, written
+ * by the CPU, is latched at its end, when the second one is moved. At an
+ * underrun one more value, 0, is moved to CnV, so the last value plays and
+ * the pin stays low after it.
+ *
+ */
+
+#include <string.h>
+#include "waveform.h"
+#include "fsl_dmamux.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define WAVEFORM_MAX_BCR 0xFFFFFU /*!< 20 bits byte count.*/
+
+/*!< Generator runtime data.*/
+typedef struct{
+	TPM_Type *base;
+	tpm_chnl_t channel;
+	waveformMode_t mode;
+	uint32_t pulseWidth;
+	uint32_t period;
+	tpm_output_compare_mode_t idleMode; /*!< Edge times idle output.*/
+	volatile uint32_t *target;          /*!< Register written by the DMA.*/
+	dma_handle_t dma;
+	uint32_t *tables[2];
+	uint32_t counts[2];
+	uint16_t bases[2];                  /*!< Edge time before each table.*/
+	uint16_t lastTime;                  /*!< Last edge time submitted.*/
+	uint8_t playing;                    /*!< Table being played.*/
+	volatile uint8_t queued;            /*!< Tables playing and next.*/
+	volatile bool running;
+	volatile bool draining;             /*!< The idle value is being moved.*/
+	waveformCallback_t callback;
+	void *userData;
+	waveformStats_t stats;
+}waveformHandle_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Sets the channel to edge aligned PWM, high true, with CnV = 0.
+ *
+ */
+static void SetupPwm(TPM_Type *base, tpm_chnl_t channel);
+
+/**
+ * @brief Enables or disables the TPM DMA request of the mode.
+ *
+ */
+static inline void EnableTpmRequest(bool enable);
+
+/**
+ * @brief Tells if the TPM event of the mode happened and was not moved.
+ *
+ */
+static inline bool IsEventPending(void);
+
+/**
+ * @brief Points the DMA to a block of values and enables its request.
+ *
+ */
+static void Load(const uint32_t *values, uint32_t count);
+
+/**
+ * @brief A table was moved: loads the next one or idles the output.
+ *
+ */
+static void TableEnd(waveformHandle_t *waveform);
+
+/**
+ * @brief DMA done.
+ *
+ */
+static void DmaCallback(dma_handle_t *handle, void *userData);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static waveformHandle_t s_waveform;
+
+/*!< Value moved at an underrun of the PWM modes.*/
+static const uint32_t s_idleValue = 0U;
+
+static TPM_Type *const s_tpmBases[] = TPM_BASE_PTRS;
+
+/*!< DMA request sources of each TPM (the channel ones are consecutive).*/
+static const dma_request_source_t s_channelRequests[] = {
+	kDmaRequestMux0TPM0Channel0, kDmaRequestMux0TPM1Channel0, kDmaRequestMux0TPM2Channel0};
+static const dma_request_source_t s_overflowRequests[] = {
+	kDmaRequestMux0TPM0Overflow, kDmaRequestMux0TPM1Overflow, kDmaRequestMux0TPM2Overflow};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void SetupPwm(TPM_Type *base, tpm_chnl_t channel)
+{
+	uint32_t modeMask = TPM_CnSC_MSA_MASK | TPM_CnSC_MSB_MASK | TPM_CnSC_ELSA_MASK | TPM_CnSC_ELSB_MASK;
+
+	/* As TPM_SetupOutputCompare(): the mode change is acknowledged. */
+	base->CONTROLS[channel].CnSC &= ~modeMask;
+	while(base->CONTROLS[channel].CnSC & modeMask)
+	{
+	}
+	base->CONTROLS[channel].CnSC |= TPM_CnSC_MSB_MASK | TPM_CnSC_ELSB_MASK;
+	base->CONTROLS[channel].CnV = 0U;
+	while(!(base->CONTROLS[channel].CnSC & modeMask))
+	{
+	}
+}
+
+static inline void EnableTpmRequest(bool enable)
+{
+	TPM_Type *base = s_waveform.base;
+
+	/* The flags are cleared by writing 1: written as 0. */
+	if(s_waveform.mode == kWaveform_EdgeTimes)
+	{
+		base->CONTROLS[s_waveform.channel].CnSC =
+			(base->CONTROLS[s_waveform.channel].CnSC & ~(TPM_CnSC_CHF_MASK | TPM_CnSC_DMA_MASK)) |
+			(enable ? TPM_CnSC_DMA_MASK : 0U);
+	}
+	else
+	{
+		base->SC = (base->SC & ~(TPM_SC_TOF_MASK | TPM_SC_DMA_MASK)) | (enable ? TPM_SC_DMA_MASK : 0U);
+	}
+}
+
+static inline bool IsEventPending(void)
+{
+	if(s_waveform.mode == kWaveform_EdgeTimes)
+	{
+		return (s_waveform.base->CONTROLS[s_waveform.channel].CnSC & TPM_CnSC_CHF_MASK) != 0U;
+	}
+
+	return (s_waveform.base->SC & TPM_SC_TOF_MASK) != 0U;
+}
+
+static void Load(const uint32_t *values, uint32_t count)
+{
+	DMA_SetSourceAddress(DMA0, s_waveform.dma.channel, (uint32_t)values);
+	DMA_SetTransferSize(DMA0, s_waveform.dma.channel, count * sizeof(uint32_t));
+	DMA_EnableChannelRequest(DMA0, s_waveform.dma.channel);
+}
+
+static void TableEnd(waveformHandle_t *waveform)
+{
+	uint32_t *done;
+	uint32_t events = kWaveform_EventTableDone;
+
+	if(waveform->draining)
+	{
+		/* The idle value was moved: nothing more to request. */
+		waveform->draining = false;
+		EnableTpmRequest(false);
+		return;
+	}
+
+	done = waveform->tables[waveform->playing];
+	waveform->playing ^= 1U;
+	waveform->queued--;
+	waveform->stats.tables++;
+
+	if(waveform->queued != 0U)
+	{
+		/* Its first value is already due if the event was not moved. */
+		if(IsEventPending())
+		{
+			waveform->stats.lateReloads++;
+			events |= kWaveform_EventLate;
+		}
+		Load(waveform->tables[waveform->playing], waveform->counts[waveform->playing]);
+	}
+	else
+	{
+		waveform->stats.underruns++;
+		waveform->running = false;
+		events |= kWaveform_EventUnderrun;
+
+		if(waveform->mode == kWaveform_EdgeTimes)
+		{
+			/* Same output compare mode, other output action: no disable needed. */
+			waveform->base->CONTROLS[waveform->channel].CnSC =
+				(waveform->base->CONTROLS[waveform->channel].CnSC &
+				 ~(TPM_CnSC_CHF_MASK | TPM_CnSC_DMA_MASK | TPM_CnSC_ELSA_MASK | TPM_CnSC_ELSB_MASK)) |
+				(waveform->idleMode & (TPM_CnSC_ELSA_MASK | TPM_CnSC_ELSB_MASK));
+		}
+		else
+		{
+			waveform->draining = true;
+			DMA_SetDestinationAddress(DMA0, waveform->dma.channel,
+			                          (uint32_t)&waveform->base->CONTROLS[waveform->channel].CnV);
+			Load(&s_idleValue, 1U);
+		}
+	}
+
+	if(waveform->callback != NULL)
+	{
+		waveform->callback(done, events, waveform->userData);
+	}
+}
+
+static void DmaCallback(dma_handle_t *handle, void *userData)
+{
+	(void)handle;
+
+	/* DONE was cleared by DMA_HandleIRQ() and the request disabled (D_REQ). */
+	TableEnd((waveformHandle_t *)userData);
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t Waveform_StartSquare(TPM_Type *base, tpm_chnl_t channel, uint32_t counterClock_Hz, uint32_t frequency_Hz)
+{
+	uint64_t half;
+
+	if((frequency_Hz == 0U) || (counterClock_Hz == 0U))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	/* Half period, rounded: one toggle per overflow. */
+	half = ((uint64_t)counterClock_Hz + frequency_Hz) / (2U * (uint64_t)frequency_Hz);
+	if((half == 0U) || (half > 0x10000U))
+	{
+		return kStatus_OutOfRange;
+	}
+
+	TPM_SetTimerPeriod(base, (uint32_t)half - 1U);
+	TPM_SetupOutputCompare(base, channel, kTPM_ToggleOnMatch, 0U);
+
+	return kStatus_Success;
+}
+
+void Waveform_GetDefaultConfig(waveformConfig_t *config)
+{
+	memset(config, 0, sizeof(waveformConfig_t));
+	config->channel = kTPM_Chnl_0;
+	config->mode = kWaveform_EdgeTimes;
+}
+
+status_t Waveform_Init(const waveformConfig_t *config)
+{
+	dma_transfer_config_t transferConfig;
+	dma_request_source_t source;
+	uint32_t instance;
+
+	if((config == NULL) || (config->base == NULL) ||
+	   (config->dmaChannel >= FSL_FEATURE_DMA_MODULE_CHANNEL) ||
+	   ((config->mode == kWaveform_PulseWidths) && ((config->period < 2U) || (config->period > 0xFFFFU))) ||
+	   ((config->mode == kWaveform_PulsePeriods) && ((config->pulseWidth == 0U) || (config->pulseWidth > 0xFFFEU))))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	for(instance = 0U; instance < ARRAY_SIZE(s_tpmBases); instance++)
+	{
+		if(s_tpmBases[instance] == config->base)
+		{
+			break;
+		}
+	}
+	if((instance == ARRAY_SIZE(s_tpmBases)) ||
+	   ((uint32_t)config->channel >= (uint32_t)FSL_FEATURE_TPM_CHANNEL_COUNTn(config->base)))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	memset(&s_waveform, 0, sizeof(s_waveform));
+	s_waveform.base = config->base;
+	s_waveform.channel = config->channel;
+	s_waveform.mode = config->mode;
+	s_waveform.pulseWidth = config->pulseWidth;
+	s_waveform.period = config->period;
+	s_waveform.idleMode = config->idleHigh ? kTPM_SetOnMatch : kTPM_ClearOnMatch;
+	s_waveform.callback = config->callback;
+	s_waveform.userData = config->userData;
+
+	if(config->mode == kWaveform_EdgeTimes)
+	{
+		source = (dma_request_source_t)(s_channelRequests[instance] + config->channel);
+		s_waveform.target = &config->base->CONTROLS[config->channel].CnV;
+		/* Free running counter; the pin goes idle at the next match. */
+		TPM_SetTimerPeriod(config->base, 0xFFFFU);
+		TPM_SetupOutputCompare(config->base, config->channel, s_waveform.idleMode, 0U);
+	}
+	else
+	{
+		source = s_overflowRequests[instance];
+		s_waveform.target = (config->mode == kWaveform_PulseWidths) ?
+		                    &config->base->CONTROLS[config->channel].CnV : &config->base->MOD;
+		if(config->mode == kWaveform_PulseWidths)
+		{
+			TPM_SetTimerPeriod(config->base, config->period - 1U);
+		}
+		SetupPwm(config->base, config->channel);
+	}
+
+	DMAMUX_Init(DMAMUX0);
+	DMA_Init(DMA0);
+
+	DMAMUX_DisableChannel(DMAMUX0, config->dmaChannel);
+	DMAMUX_SetSource(DMAMUX0, config->dmaChannel, source & 0xFFU);
+	DMAMUX_EnableChannel(DMAMUX0, config->dmaChannel);
+
+	DMA_CreateHandle(&s_waveform.dma, DMA0, config->dmaChannel);
+	DMA_SetCallback(&s_waveform.dma, DmaCallback, &s_waveform);
+	DMA_PrepareTransfer(&transferConfig, (void *)&s_idleValue, sizeof(uint32_t),
+	                    (void *)s_waveform.target, sizeof(uint32_t),
+	                    sizeof(uint32_t), kDMA_MemoryToPeripheral);
+	/* Cycle steal and request disabled at the end of each table (D_REQ). */
+	DMA_SubmitTransfer(&s_waveform.dma, &transferConfig, kDMA_EnableInterrupt);
+
+	return kStatus_Success;
+}
+
+status_t Waveform_Submit(uint32_t *table, uint32_t count)
+{
+	uint32_t i, primask, time;
+	uint16_t before;
+	uint8_t slot;
+
+	if((table == NULL) || (count == 0U) || ((count * sizeof(uint32_t)) > WAVEFORM_MAX_BCR))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	/* Only the interrupt takes tables out: the room found is kept. */
+	if(s_waveform.queued == 2U)
+	{
+		return kStatus_Waveform_QueueFull;
+	}
+
+	for(i = 0U; i < count; i++)
+	{
+		if(((s_waveform.mode == kWaveform_EdgeTimes) && ((table[i] == 0U) || (table[i] > 0xFFFFU))) ||
+		   ((s_waveform.mode == kWaveform_PulseWidths) && (table[i] > s_waveform.period)) ||
+		   ((s_waveform.mode == kWaveform_PulsePeriods) &&
+		    ((table[i] <= s_waveform.pulseWidth) || (table[i] > 0x10000U))))
+		{
+			return kStatus_InvalidArgument;
+		}
+	}
+
+	/* Register values: absolute edge times, continuing the last one, or MOD. */
+	before = s_waveform.lastTime;
+	if(s_waveform.mode == kWaveform_EdgeTimes)
+	{
+		time = s_waveform.lastTime;
+		for(i = 0U; i < count; i++)
+		{
+			time = (time + table[i]) & 0xFFFFU;
+			table[i] = time;
+		}
+		s_waveform.lastTime = (uint16_t)time;
+	}
+	else if(s_waveform.mode == kWaveform_PulsePeriods)
+	{
+		for(i = 0U; i < count; i++)
+		{
+			table[i]--;
+		}
+	}
+
+	primask = DisableGlobalIRQ();
+	/* An underrun meanwhile leaves the queue empty, with the same slot free. */
+	slot = s_waveform.playing ^ s_waveform.queued;
+	s_waveform.tables[slot] = table;
+	s_waveform.counts[slot] = count;
+	s_waveform.bases[slot] = before;
+	s_waveform.queued++;
+	EnableGlobalIRQ(primask);
+
+	return kStatus_Success;
+}
+
+status_t Waveform_Start(void)
+{
+	TPM_Type *base = s_waveform.base;
+	uint32_t cmod, i, count;
+	uint16_t offset;
+	uint8_t k, slot;
+	uint32_t *table;
+
+	if(s_waveform.running)
+	{
+		return kStatus_Waveform_Busy;
+	}
+	if(s_waveform.queued == 0U)
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	DMA_AbortTransfer(&s_waveform.dma);
+	EnableTpmRequest(false);
+	s_waveform.draining = false;
+
+	/* Counter stopped from 0: the registers are written at once. */
+	cmod = base->SC & TPM_SC_CMOD_MASK;
+	base->SC &= ~TPM_SC_CMOD_MASK;
+	while(base->SC & TPM_SC_CMOD_MASK)
+	{
+	}
+	base->CNT = 0U;
+	DMA_SetDestinationAddress(DMA0, s_waveform.dma.channel, (uint32_t)s_waveform.target);
+	table = s_waveform.tables[s_waveform.playing];
+	count = s_waveform.counts[s_waveform.playing];
+	s_waveform.running = true;
+
+	if(s_waveform.mode == kWaveform_EdgeTimes)
+	{
+		/* The times continue the ones before an underrun: from 0 again. */
+		offset = s_waveform.bases[s_waveform.playing];
+		for(k = 0U; (offset != 0U) && (k < s_waveform.queued); k++)
+		{
+			slot = s_waveform.playing ^ k;
+			for(i = 0U; i < s_waveform.counts[slot]; i++)
+			{
+				s_waveform.tables[slot][i] = (s_waveform.tables[slot][i] - offset) & 0xFFFFU;
+			}
+			s_waveform.bases[slot] -= offset;
+		}
+		s_waveform.lastTime -= offset;
+
+		TPM_SetupOutputCompare(base, s_waveform.channel, kTPM_ToggleOnMatch, table[0]);
+		TPM_ClearStatusFlags(base, 1U << s_waveform.channel);
+	}
+	else
+	{
+		base->CONTROLS[s_waveform.channel].CnV = 0U;
+		if(s_waveform.mode == kWaveform_PulsePeriods)
+		{
+			/* The idle period is as long as the first one. */
+			base->MOD = table[0];
+		}
+		TPM_ClearStatusFlags(base, kTPM_TimeOverflowFlag);
+	}
+
+	/* The first value is written by the CPU. */
+	if(count > 1U)
+	{
+		Load(&table[1], count - 1U);
+	}
+	else
+	{
+		TableEnd(&s_waveform);
+	}
+
+	EnableTpmRequest(s_waveform.running || s_waveform.draining);
+	base->SC |= cmod;
+
+	if(s_waveform.mode != kWaveform_EdgeTimes)
+	{
+		/* Buffered: latched at the end of the idle period. */
+		*s_waveform.target = table[0];
+		if(s_waveform.mode == kWaveform_PulsePeriods)
+		{
+			base->CONTROLS[s_waveform.channel].CnV = s_waveform.pulseWidth;
+		}
+	}
+
+	return kStatus_Success;
+}
+
+void Waveform_Stop(void)
+{
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	DMA_AbortTransfer(&s_waveform.dma);
+	EnableTpmRequest(false);
+	s_waveform.running = false;
+	s_waveform.draining = false;
+	s_waveform.queued = 0U;
+	s_waveform.lastTime = 0U;
+	s_waveform.bases[s_waveform.playing] = 0U;
+
+	if(s_waveform.mode == kWaveform_EdgeTimes)
+	{
+		/* Idle at the next match, within a counter period. */
+		TPM_SetupOutputCompare(s_waveform.base, s_waveform.channel, s_waveform.idleMode, 0U);
+	}
+	else
+	{
+		s_waveform.base->CONTROLS[s_waveform.channel].CnV = 0U;
+	}
+	EnableGlobalIRQ(primask);
+}
+
+bool Waveform_IsBusy(void)
+{
+	return s_waveform.running || s_waveform.draining;
+}
+
+void Waveform_GetStats(waveformStats_t *stats)
+{
+	uint32_t primask = DisableGlobalIRQ();
+
+	*stats = s_waveform.stats;
+	EnableGlobalIRQ(primask);
+}
@@ -0,0 +1,233 @@
+/**
+ * @file	waveform.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Waveform generation by TPM output compare and DMA, with no CPU.
+ *
+ * Waveform_StartSquare() makes a square wave on a channel pin with the
+ * output compare toggle mode: the pin toggles in hardware at each counter
+ * overflow, so the edges have no interrupt latency jitter and the CPU is
+ * not used at all.
+ *
+ * For arbitrary pulse trains, a table of values is moved by the DMA to a
+ * TPM register, one value per TPM event, in one of the modes:
+ *
+ * - kWaveform_EdgeTimes: the pin toggles at each value; the table has the
+ *   intervals between the edges, in ticks (1 to 0xFFFF), and the counter
+ *   runs free (MOD = 0xFFFF). For any edge pattern, as IR remote frames.
+ *   The pin starts at its idle level and the last edge before an underrun
+ *   drives it to the idle level, toggling or not.
+ * - kWaveform_PulseWidths: edge aligned PWM with a fixed period; the table
+ *   has the pulse width of each period, in ticks (0 to period). For IR
+ *   carrier bursts: the carrier duty cycle in the marks, 0 in the spaces.
+ * - kWaveform_PulsePeriods: fixed width pulses; the table has the period of
+ *   each pulse, in ticks (pulseWidth + 1 to 0x10000). For stepper motor
+ *   step sequences with acceleration.
+ *
+ * The tables are queued with Waveform_Submit(): one being played and one
+ * next, reloaded by the DMA done interrupt, so a stream of tables plays
+ * with no gap if each one is submitted before the previous one ends. If
+ * there is no next table when one ends, an underrun is reported and the
+ * pin goes to its idle level after the last value; Waveform_Start() must
+ * be called again after new tables are submitted.
+ *
+ * The table memory belongs to the generator from Waveform_Submit() until
+ * the table done event; the values are converted in place to register
+ * values when submitted.
+ *
+ * The TPM must be previously initialized by TPM_Init() and started by
+ * TPM_StartTimer(); its counter and period are used by the generator. The
+ * DMA interrupt is handled by the fsl_dma driver.
+ *
+ */
+
+#ifndef WAVEFORM_H_
+#define WAVEFORM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "fsl_tpm.h"
+#include "fsl_dma.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup waveform
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Status codes.*/
+enum _waveform_status{
+	kStatus_Waveform_QueueFull = MAKE_STATUS(kStatusGroup_ApplicationRangeStart, 0), /*!< Two tables queued.*/
+	kStatus_Waveform_Busy = MAKE_STATUS(kStatusGroup_ApplicationRangeStart, 1),      /*!< Already playing.*/
+};
+
+/*!< Events reported to the callback (bit mask).*/
+enum _waveform_events{
+	kWaveform_EventTableDone = (1U << 0), /*!< A table was moved and can be reused.*/
+	kWaveform_EventUnderrun = (1U << 1),  /*!< No next table: the output goes idle.*/
+	kWaveform_EventLate = (1U << 2),      /*!< The next table was loaded after its first event.*/
+};
+
+/*!< Table modes.*/
+typedef enum{
+	kWaveform_EdgeTimes = 0U, /*!< Toggle at each edge time (CnV).*/
+	kWaveform_PulseWidths,    /*!< Pulse width of each period (CnV).*/
+	kWaveform_PulsePeriods,   /*!< Period of each pulse (MOD).*/
+}waveformMode_t;
+
+/*!< Table done callback, called in interrupt context (or by Waveform_Start()
+ *   for a first table of a single value). table is the one moved, free
+ *   to be reused or submitted again.*/
+typedef void (*waveformCallback_t)(uint32_t *table, uint32_t events, void *userData);
+
+/*!
+ * @brief Generator configuration structure.
+ */
+typedef struct{
+	TPM_Type *base;              /*!< TPM peripheral base address.*/
+	tpm_chnl_t channel;          /*!< Output channel.*/
+	uint8_t dmaChannel;          /*!< DMA channel used.*/
+	waveformMode_t mode;         /*!< Table mode.*/
+	uint32_t period;             /*!< kWaveform_PulseWidths period, in ticks (MOD + 1).*/
+	uint32_t pulseWidth;         /*!< kWaveform_PulsePeriods width, in ticks.*/
+	bool idleHigh;               /*!< Idle level of the pin, kWaveform_EdgeTimes only
+	                                  (the pulses of the PWM modes are high).*/
+	waveformCallback_t callback; /*!< Table done callback, can be NULL.*/
+	void *userData;              /*!< Parameter passed to the callback.*/
+}waveformConfig_t;
+
+/*!< Generator counters.*/
+typedef struct{
+	uint32_t tables;      /*!< Tables played.*/
+	uint32_t underruns;   /*!< Tables ended with no next one.*/
+	uint32_t lateReloads; /*!< Next tables loaded after their first event.*/
+}waveformStats_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Starts a square wave on a channel, toggled by the hardware.
+ *
+ *        Sets the TPM period to half of the wave period, so the other
+ *        channels of the TPM share it. The frequency made is
+ *        counterClock_Hz / (2 * (MOD + 1)), rounded to the nearest.
+ *
+ * @param base            - TPM peripheral base address.
+ * @param channel         - output channel.
+ * @param counterClock_Hz - TPM counter clock (after the prescaler).
+ * @param frequency_Hz    - wave frequency.
+ *
+ * @return kStatus_Success if started;
+ *         kStatus_InvalidArgument if the frequency is 0;
+ *         kStatus_OutOfRange if the half period does not fit in 1 to 0x10000 ticks.
+ *
+ */
+status_t Waveform_StartSquare(TPM_Type *base, tpm_chnl_t channel, uint32_t counterClock_Hz, uint32_t frequency_Hz);
+
+/**
+ * @brief Gets the default configuration: edge times on channel 0, DMA
+ *        channel 0, idle low.
+ *
+ * @param config - the configuration to be filled.
+ *
+ */
+void Waveform_GetDefaultConfig(waveformConfig_t *config);
+
+/**
+ * @brief Configures the channel and the DMA. The pin goes to its idle
+ *        level at the next match (edge times) or overflow; the tables play
+ *        from Waveform_Start().
+ *
+ * @param config - the configuration.
+ *
+ * @return kStatus_Success if configured;
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t Waveform_Init(const waveformConfig_t *config);
+
+/**
+ * @brief Queues a table. Can be called from the callback.
+ *
+ * @param table - the values, converted in place; must be kept until the
+ *                table done event.
+ * @param count - number of values.
+ *
+ * @return kStatus_Success if queued;
+ *         kStatus_Waveform_QueueFull if a table is playing and another is next;
+ *         kStatus_InvalidArgument if any value is out of the mode range.
+ *
+ */
+status_t Waveform_Submit(uint32_t *table, uint32_t count);
+
+/**
+ * @brief Starts playing the queued tables, restarting the TPM counter.
+ *
+ *        The first edge time is counted from the start; in the PWM modes,
+ *        the first value plays in the second period, the first one idle
+ *        (as long as the first value, for kWaveform_PulsePeriods).
+ *
+ * @return kStatus_Success if started;
+ *         kStatus_Waveform_Busy if already playing;
+ *         kStatus_InvalidArgument if no table is queued.
+ *
+ */
+status_t Waveform_Start(void);
+
+/**
+ * @brief Stops the generator and empties the queue. The pin goes to its
+ *        idle level.
+ *
+ */
+void Waveform_Stop(void);
+
+/**
+ * @brief Tells if the generator is playing a table.
+ *
+ * @return True while playing.
+ *
+ */
+bool Waveform_IsBusy(void);
+
+/**
+ * @brief Copies the generator counters.
+ *
+ * @param stats - where the counters will be copied.
+ *
+ */
+void Waveform_GetStats(waveformStats_t *stats);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* WAVEFORM_H_ */
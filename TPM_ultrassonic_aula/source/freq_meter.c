@@ -0,0 +1,444 @@
+/**
+ * @file	freq_meter.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Reciprocal and gated frequency meter on tpm_capture.
+ *
+ * The edges are processed in the tpm_capture callback, using only their
+ * timestamps. Everything that reads the current time is done after
+ * TpmCapture_IRQHandler() returns, when the overflow count is updated.
+ * The frequency comparisons of the mode switch are cross multiplications,
+ * with no division.
+ *
+ */
+
+#include <string.h>
+#include "freq_meter.h"
+#include "tpm_capture.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Meter states.*/
+typedef enum{
+	kFreqMeter_Stopped = 0U,
+	kFreqMeter_Sync,   /*!< Waiting a rising edge to start a window.*/
+	kFreqMeter_Run,    /*!< Reciprocal window open.*/
+	kFreqMeter_Paused, /*!< Edge budget spent, waiting the gate time.*/
+	kFreqMeter_Gating, /*!< Gated counting.*/
+}freqMeterState_t;
+
+/*!< Raw result of a window.*/
+typedef struct{
+	uint32_t cycles;
+	uint32_t ticks;
+	uint32_t high;
+	bool dutyValid;
+	freqMeterMode_t mode;
+	uint32_t sequence;
+}freqMeterResult_t;
+
+/*!< Meter runtime data.*/
+typedef struct{
+	TPM_Type *base;
+	TPM_Type *gateBase;
+	tpm_chnl_t channel;
+	uint32_t clock_Hz;
+	uint32_t gateTicks;
+	uint32_t timeoutTicks;
+	uint32_t minPeriods;
+	uint32_t maxPeriods;       /*!< Edge budget of a window.*/
+	uint32_t switchUp_Hz;
+	uint32_t switchDown_Hz;
+	volatile freqMeterState_t state;
+	GPIO_Type *pinGpio;
+	uint32_t pin;
+	bool risingOnly;           /*!< Only the rising edges are captured.*/
+	bool fallNext;             /*!< The next edge is a falling one.*/
+	uint32_t start;            /*!< Window start time.*/
+	uint32_t lastRise;
+	uint32_t periods;
+	uint32_t high;             /*!< Sum of the high times.*/
+	uint32_t syncTime;         /*!< Time the sync started.*/
+	bool gateRestart;          /*!< Gate window to be started.*/
+	uint32_t gateCount;        /*!< Gate TPM count at the window start.*/
+	freqMeterResult_t result;
+}freqMeterHandle_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Stores the result of a window.
+ *
+ */
+static void Publish(uint32_t cycles, uint32_t ticks, uint32_t high, bool dutyValid, freqMeterMode_t mode);
+
+/**
+ * @brief Restarts reciprocal counting, waiting a rising edge.
+ *
+ */
+static void Resync(uint32_t now);
+
+/**
+ * @brief Opens a reciprocal window at a rising edge.
+ *
+ */
+static void OpenWindow(uint32_t timestamp);
+
+/**
+ * @brief Processes the signal edges, from tpm_capture.
+ *
+ */
+static bool EdgeCallback(TPM_Type *base, const tpmCaptureEdge_t *edge, void *userData);
+
+/**
+ * @brief Timeouts, pauses and gated counting, after the edges.
+ *
+ */
+static void Service(void);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static freqMeterHandle_t s_meter;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void Publish(uint32_t cycles, uint32_t ticks, uint32_t high, bool dutyValid, freqMeterMode_t mode)
+{
+	s_meter.result.cycles = cycles;
+	s_meter.result.ticks = ticks;
+	s_meter.result.high = high;
+	s_meter.result.dutyValid = dutyValid;
+	s_meter.result.mode = mode;
+	s_meter.result.sequence++;
+}
+
+static void Resync(uint32_t now)
+{
+	s_meter.syncTime = now;
+	s_meter.state = kFreqMeter_Sync;
+	TpmCapture_EnableChannel(s_meter.base, s_meter.channel, kTPM_RisingEdge);
+}
+
+static void OpenWindow(uint32_t timestamp)
+{
+	s_meter.start = timestamp;
+	s_meter.periods = 0U;
+	s_meter.high = 0U;
+}
+
+static bool EdgeCallback(TPM_Type *base, const tpmCaptureEdge_t *edge, void *userData)
+{
+	uint32_t elapsed;
+	bool rising;
+
+	(void)userData;
+
+	if((edge->channel != s_meter.channel) || (s_meter.state == kFreqMeter_Stopped))
+	{
+		return false;
+	}
+
+	if(s_meter.state == kFreqMeter_Sync)
+	{
+		/* A known rising edge: from now on both edges, if the pin can
+		 * tell them apart. */
+		OpenWindow(edge->timestamp);
+		s_meter.lastRise = edge->timestamp;
+		s_meter.fallNext = true;
+		s_meter.state = kFreqMeter_Run;
+		if(!s_meter.risingOnly)
+		{
+			TPM_SetupInputCapture(base, s_meter.channel, kTPM_RiseAndFallEdge);
+		}
+		return false;
+	}
+
+	if(s_meter.state != kFreqMeter_Run)
+	{
+		return false;
+	}
+
+	/* The pin is read as soon as possible after the edge. */
+	rising = s_meter.risingOnly || (GPIO_ReadPinInput(s_meter.pinGpio, s_meter.pin) != 0U);
+	if(!s_meter.risingOnly && (rising == s_meter.fallNext))
+	{
+		/* Two edges of the same polarity: the one between was lost, or
+		 * the pulse ended before the pin was read. The periods and high
+		 * times are wrong, so the window is dropped, and the next ones
+		 * count the rising edges only. */
+		s_meter.risingOnly = true;
+		Resync(edge->timestamp);
+		return false;
+	}
+
+	if(!rising)
+	{
+		if(s_meter.fallNext)
+		{
+			s_meter.high += edge->timestamp - s_meter.lastRise;
+		}
+		s_meter.fallNext = false;
+		return false;
+	}
+
+	s_meter.periods++;
+	s_meter.lastRise = edge->timestamp;
+	s_meter.fallNext = true;
+
+	elapsed = edge->timestamp - s_meter.start;
+	if((s_meter.periods < s_meter.minPeriods) ||
+	   ((elapsed < s_meter.gateTicks) && (s_meter.periods < s_meter.maxPeriods)))
+	{
+		return false;
+	}
+
+	/* Tested before publishing: near the interrupt limit the periods
+	 * may be short of the signal cycles. */
+	if((s_meter.gateBase != NULL) &&
+	   ((uint64_t)s_meter.periods * s_meter.clock_Hz > (uint64_t)s_meter.switchUp_Hz * elapsed))
+	{
+		TpmCapture_DisableChannel(base, s_meter.channel);
+		s_meter.gateRestart = true;
+		s_meter.state = kFreqMeter_Gating;
+		return false;
+	}
+
+	Publish(s_meter.periods, elapsed, s_meter.high, !s_meter.risingOnly, kFreqMeter_Reciprocal);
+
+	if(elapsed < s_meter.gateTicks)
+	{
+		/* Budget spent: no edge interrupt until the gate time ends. */
+		TpmCapture_DisableChannel(base, s_meter.channel);
+		s_meter.state = kFreqMeter_Paused;
+	}
+	else
+	{
+		/* The closing rising edge opens the next window. */
+		OpenWindow(edge->timestamp);
+	}
+
+	return false;
+}
+
+static void Service(void)
+{
+	uint32_t primask, now, count, cycles, ticks;
+
+	switch(s_meter.state)
+	{
+		case kFreqMeter_Sync:
+		case kFreqMeter_Run:
+			now = TpmCapture_GetTime(s_meter.base);
+			if((now - ((s_meter.state == kFreqMeter_Run) ? s_meter.lastRise : s_meter.syncTime)) >= s_meter.timeoutTicks)
+			{
+				Publish(0U, 0U, 0U, false, kFreqMeter_Reciprocal);
+				s_meter.risingOnly = (s_meter.pinGpio == NULL);
+				Resync(now);
+			}
+			break;
+		case kFreqMeter_Paused:
+			now = TpmCapture_GetTime(s_meter.base);
+			if((now - s_meter.start) >= s_meter.gateTicks)
+			{
+				Resync(now);
+			}
+			break;
+		case kFreqMeter_Gating:
+			/* Time and count read together: the latency does not matter,
+			 * as the window time is measured. */
+			primask = DisableGlobalIRQ();
+			now = TpmCapture_GetTime(s_meter.base);
+			count = TpmCapture_GetTime(s_meter.gateBase);
+			EnableGlobalIRQ(primask);
+
+			if(s_meter.gateRestart)
+			{
+				s_meter.gateRestart = false;
+				s_meter.start = now;
+				s_meter.gateCount = count;
+				break;
+			}
+
+			ticks = now - s_meter.start;
+			if(ticks < s_meter.gateTicks)
+			{
+				break;
+			}
+			cycles = count - s_meter.gateCount;
+			Publish(cycles, ticks, 0U, false, kFreqMeter_Gated);
+
+			if((uint64_t)cycles * s_meter.clock_Hz < (uint64_t)s_meter.switchDown_Hz * ticks)
+			{
+				s_meter.risingOnly = (s_meter.pinGpio == NULL);
+				Resync(now);
+			}
+			else
+			{
+				s_meter.start = now;
+				s_meter.gateCount = count;
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+void FreqMeter_GetDefaultConfig(freqMeterConfig_t *config)
+{
+	memset(config, 0, sizeof(freqMeterConfig_t));
+	config->gate_us = 100000U;
+	config->minPeriods = 1U;
+	config->timeout_us = 20000000U;
+	config->switchUp_Hz = 20000U;
+	config->switchDown_Hz = 10000U;
+}
+
+status_t FreqMeter_Init(const freqMeterConfig_t *config)
+{
+	uint64_t gateTicks, timeoutTicks, maxPeriods;
+	status_t status;
+
+	if((config == NULL) || (config->counterClock_Hz == 0U) || (config->minPeriods == 0U) ||
+	   (config->gate_us == 0U) || (config->switchDown_Hz > config->switchUp_Hz))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	/* The windows must fit in half of the timestamp range. */
+	gateTicks = ((uint64_t)config->gate_us * config->counterClock_Hz) / 1000000U;
+	timeoutTicks = ((uint64_t)config->timeout_us * config->counterClock_Hz) / 1000000U;
+	if((gateTicks == 0U) || (gateTicks > 0x7FFFFFFFU) || (timeoutTicks <= gateTicks) || (timeoutTicks > 0x7FFFFFFFU))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	maxPeriods = ((uint64_t)config->switchUp_Hz * config->gate_us) / 1000000U;
+	if(maxPeriods < config->minPeriods)
+	{
+		maxPeriods = config->minPeriods;
+	}
+
+	status = TpmCapture_Init(config->base, EdgeCallback, NULL);
+	if(status != kStatus_Success)
+	{
+		return status;
+	}
+	if(config->gateBase != NULL)
+	{
+		status = TpmCapture_Init(config->gateBase, NULL, NULL);
+		if(status != kStatus_Success)
+		{
+			return status;
+		}
+	}
+
+	memset(&s_meter, 0, sizeof(s_meter));
+	s_meter.base = config->base;
+	s_meter.gateBase = config->gateBase;
+	s_meter.channel = config->channel;
+	s_meter.pinGpio = config->pinGpio;
+	s_meter.pin = config->pin;
+	s_meter.clock_Hz = config->counterClock_Hz;
+	s_meter.gateTicks = (uint32_t)gateTicks;
+	s_meter.timeoutTicks = (uint32_t)timeoutTicks;
+	s_meter.minPeriods = config->minPeriods;
+	s_meter.maxPeriods = (maxPeriods > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (uint32_t)maxPeriods;
+	s_meter.switchUp_Hz = config->switchUp_Hz;
+	s_meter.switchDown_Hz = config->switchDown_Hz;
+
+	return kStatus_Success;
+}
+
+void FreqMeter_Start(void)
+{
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	s_meter.risingOnly = (s_meter.pinGpio == NULL);
+	Resync(TpmCapture_GetTime(s_meter.base));
+	EnableGlobalIRQ(primask);
+}
+
+void FreqMeter_Stop(void)
+{
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	TpmCapture_DisableChannel(s_meter.base, s_meter.channel);
+	s_meter.state = kFreqMeter_Stopped;
+	EnableGlobalIRQ(primask);
+}
+
+void FreqMeter_GetReading(freqMeterReading_t *reading)
+{
+	freqMeterResult_t result;
+	uint32_t primask;
+	uint64_t rate;
+
+	primask = DisableGlobalIRQ();
+	result = s_meter.result;
+	EnableGlobalIRQ(primask);
+
+	memset(reading, 0, sizeof(freqMeterReading_t));
+	reading->valid = (result.cycles != 0U) && (result.ticks != 0U);
+	reading->mode = result.mode;
+	reading->cycles = result.cycles;
+	reading->ticks = result.ticks;
+	reading->sequence = result.sequence;
+
+	if(!reading->valid)
+	{
+		return;
+	}
+
+	/* f = cycles * clock / ticks, with the remainder for the fraction. */
+	rate = (uint64_t)result.cycles * s_meter.clock_Hz;
+	reading->frequency_uHz = (rate / result.ticks) * 1000000U +
+	                         ((rate % result.ticks) * 1000000U) / result.ticks;
+	reading->period_ns = ((uint64_t)result.ticks * 1000000000U) / rate;
+
+	reading->dutyValid = result.dutyValid;
+	if(result.dutyValid)
+	{
+		reading->duty_Q16 = (uint32_t)(((uint64_t)result.high << 16U) / result.ticks);
+	}
+}
+
+void FreqMeter_IRQHandler(TPM_Type *base)
+{
+	TpmCapture_IRQHandler(base);
+
+	if(base == s_meter.base)
+	{
+		Service();
+	}
+}
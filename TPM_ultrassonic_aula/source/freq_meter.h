@@ -0,0 +1,191 @@
+/**
+ * @file	freq_meter.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Frequency, period and duty cycle meter of an external signal.
+ *
+ * Low frequencies are measured by reciprocal counting: the signal edges
+ * are captured by tpm_capture on a TPM channel and a window counts N
+ * whole periods, from a rising edge to another, timed by the TPM clock.
+ * The frequency is N / time, so the resolution is that of the TPM clock,
+ * whatever the frequency. The high time of the periods is summed for the
+ * duty cycle. Per edge only additions are done; the divisions are done
+ * once per reading, by FreqMeter_GetReading().
+ *
+ * A window ends at the first rising edge after the gate time, or after
+ * the edge budget (the switch up frequency times the gate time), so the
+ * interrupt load is bounded: after a short window the channel is paused
+ * until the end of the gate time.
+ *
+ * High frequencies are measured by gated counting: the signal is also
+ * the external clock of another TPM (the gate TPM, TPM_CLKINx pin), whose
+ * count is read together with the capture TPM time at each gate time.
+ * No interrupt is taken per edge, only the overflows of the gate TPM.
+ * The meter switches to gated counting above switchUp_Hz and back to
+ * reciprocal counting below switchDown_Hz. The external clock is
+ * synchronized to the TPM clock, which limits its frequency (see the
+ * reference manual); the duty cycle is not measured in gated counting.
+ *
+ * The KL25 TPM has no dual edge capture (no COMBINE register), so the
+ * first edge of a window is captured as a rising one; after it, the
+ * channel captures both edges and the polarity of each one is read at the
+ * signal pin (its GPIO input), as a capture overwritten before its
+ * interrupt would put alternated edges out of step. Two edges of the same
+ * polarity mean a lost edge: the window is dropped, and the next ones
+ * capture only the rising edges, without the duty cycle (pulses shorter
+ * than the interrupt latency), until the meter is restarted, the signal
+ * times out or the gated counting ends. Without the pin, only the rising
+ * edges are captured. The switch up frequency must be below the edge rate
+ * the interrupt can take, so a signal too fast for it is switched to gated
+ * counting before a reading of its lost edges is published.
+ *
+ * The TPMs must be previously initialized by TPM_Init() and started by
+ * TPM_StartTimer(), the gate TPM with kTPM_ExternalClock and its clock
+ * input selected in SIM->SOPT4. The application must call
+ * FreqMeter_IRQHandler() from the interrupt handlers of both TPMs.
+ *
+ */
+
+#ifndef FREQ_METER_H_
+#define FREQ_METER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "fsl_tpm.h"
+#include "fsl_gpio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup freq_meter
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!
+ * @brief Measurement methods.
+ */
+typedef enum{
+	kFreqMeter_Reciprocal = 0U, /*!< Input capture of the edges.*/
+	kFreqMeter_Gated,           /*!< Count of the edges in the gate time.*/
+}freqMeterMode_t;
+
+/*!
+ * @brief A reading, in fixed point.
+ */
+typedef struct{
+	bool valid;              /*!< A signal was measured.*/
+	bool dutyValid;          /*!< The duty cycle was measured.*/
+	freqMeterMode_t mode;    /*!< Method of the measurement.*/
+	uint64_t frequency_uHz;  /*!< Frequency, in micro-hertz.*/
+	uint64_t period_ns;      /*!< Mean period, in nanoseconds.*/
+	uint32_t duty_Q16;       /*!< Duty cycle, 65536 = 100%.*/
+	uint32_t cycles;         /*!< Periods in the window.*/
+	uint32_t ticks;          /*!< Window time, in TPM clock ticks.*/
+	uint32_t sequence;       /*!< Number of readings.*/
+}freqMeterReading_t;
+
+/*!
+ * @brief Meter configuration structure.
+ */
+typedef struct{
+	TPM_Type *base;           /*!< TPM of the capture channel.*/
+	tpm_chnl_t channel;       /*!< Capture channel of the signal.*/
+	GPIO_Type *pinGpio;       /*!< GPIO of the signal pin, for the edge polarity; NULL for no duty cycle.*/
+	uint32_t pin;             /*!< Signal pin number.*/
+	uint32_t counterClock_Hz; /*!< Capture TPM counter clock (after the prescaler).*/
+	TPM_Type *gateBase;       /*!< TPM clocked by the signal, NULL for reciprocal only.*/
+	uint32_t gate_us;         /*!< Gate time, the shortest window.*/
+	uint32_t minPeriods;      /*!< Periods averaged at least (N).*/
+	uint32_t timeout_us;      /*!< Time without rising edges for no signal.*/
+	uint32_t switchUp_Hz;     /*!< Switch to gated counting above it.*/
+	uint32_t switchDown_Hz;   /*!< Switch to reciprocal counting below it.*/
+}freqMeterConfig_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Gets the default configuration: 100 ms gate, 1 period, 20 s
+ *        timeout (down to 0.1 Hz), gated counting above 20 kHz and back
+ *        below 10 kHz, and no signal pin (no duty cycle).
+ *
+ * @param config - the configuration to be filled.
+ *
+ */
+void FreqMeter_GetDefaultConfig(freqMeterConfig_t *config);
+
+/**
+ * @brief Configures the capture channel and the gate TPM.
+ *
+ * @param config - the configuration.
+ *
+ * @return kStatus_Success if configured;
+ *         kStatus_InvalidArgument if any parameter is invalid or a time
+ *         does not fit in half of the 32 bit timestamps.
+ *
+ */
+status_t FreqMeter_Init(const freqMeterConfig_t *config);
+
+/**
+ * @brief Starts measuring, by reciprocal counting.
+ *
+ */
+void FreqMeter_Start(void);
+
+/**
+ * @brief Stops measuring.
+ *
+ */
+void FreqMeter_Stop(void);
+
+/**
+ * @brief Gets the last reading.
+ *
+ * @param reading - where the reading is written.
+ *
+ */
+void FreqMeter_GetReading(freqMeterReading_t *reading);
+
+/**
+ * @brief The meter interrupt routine, which also serves tpm_capture.
+ *
+ *        Must be called from the interrupt handlers (TPMn_IRQHandler())
+ *        of the capture TPM and of the gate TPM.
+ *
+ * @param base - TPM peripheral base address.
+ *
+ */
+void FreqMeter_IRQHandler(TPM_Type *base);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* FREQ_METER_H_ */
@@ -43,45 +43,24 @@
 /* TODO: insert other include files here. */
 #include "fsl_tpm.h"
 #include "delay.h"
+#include "ranging.h"
 
 /* TODO: insert other definitions and declarations here. */
-bool isFallingEdgeWaiting, ultraIsCaptured;
-uint16_t ultraEchoPulseCount;
 
-#define TPM_TIMER_PERIOD     0xFFFFU
+/* Sensores ultrassônicos: pino de trigger e canal de captura do echo.
+ * O TPM1 tem só os canais 0 e 1, e o canal 1 é o do agendamento, então
+ * só cabe um sensor. Para mais sensores, usar um TPM com canais livres,
+ * como o TPM0 (até 5 canais de echo, mais o do agendamento). */
+static const rangingSensor_t g_sensors[] = {
+	{BOARD_INITPINS_TRIGGER_GPIO, BOARD_INITPINS_TRIGGER_PIN_MASK, kTPM_Chnl_0}, // PTB9, PTA12
+};
 
 void TPM1_IRQHandler(void)
 {
-	if(TPM_GetStatusFlags(TPM1) & kTPM_Chnl0Flag)
-	{
-		TPM_ClearStatusFlags(TPM1, kTPM_Chnl0Flag);
-		/* Na ocorrência de cada borda de echo, o valor do contador
-		 * é salvo em TPM0->CONTROLS[0].CnV.
-		 * Se for borda de descida...*/
-		if(isFallingEdgeWaiting)
-		{
-			/* ...obtém a largura do pulso em números de contagens.*/
-			if(TPM1->CONTROLS[0].CnV > ultraEchoPulseCount)
-			{
-				ultraEchoPulseCount = TPM1->CONTROLS[0].CnV - ultraEchoPulseCount;
-			}
-			else
-			{
-				/* Se ocorreu overflow de contagem, o valor atual do contador será
-				 * menor que o valor salvo anteriormente. Dessa forma, a equação abaixo
-				 * ajusta para que o valor absoluto entre esses tempos seja obtido.*/
-				ultraEchoPulseCount = TPM1->CONTROLS[0].CnV + (TPM_TIMER_PERIOD - ultraEchoPulseCount);
-			}
-			ultraIsCaptured = true;
-			isFallingEdgeWaiting = false;
-		}
-		else
-		{
-			/* ...Se for borda de subida, apenas salva o valor de TPM0->CONTROLS[0].CnV.*/
-			isFallingEdgeWaiting = true;
-			ultraEchoPulseCount = TPM1->CONTROLS[0].CnV;
-		}
-	}
+	/* Todo o ciclo de medição acontece aqui: os pulsos de trigger, a
+	 * captura das bordas de echo, o timeout e a espera até o próximo
+	 * sensor.*/
+	Ranging_IRQHandler();
 }
 
 /*
@@ -90,8 +69,11 @@ void TPM1_IRQHandler(void)
 int main(void)
 {
 	tpm_config_t tpm1_config;
-    uint16_t d; // distância dos objetos medidos
-	uint32_t tpm_timerResolution; // resolução do temporizador in ns
+	rangingConfig_t ranging_config;
+	rangingReading_t reading;
+	uint32_t sequence[ARRAY_SIZE(g_sensors)] = {0};
+	uint32_t tpm_clock; // frequência do temporizador em Hz
+	uint8_t i;
 
     /* Init board hardware. */
     BOARD_InitBootPins();
@@ -104,54 +86,59 @@ int main(void)
 
     Delay_Init();
 
+    /* Sem prescaler: como os estouros são contados, a resolução é de
+     * 21 ns sem limitar a largura máxima do pulso. */
     TPM_GetDefaultConfig(&tpm1_config);
-    tpm1_config.prescale = kTPM_Prescale_Divide_128;
+    tpm1_config.prescale = kTPM_Prescale_Divide_1;
     TPM_Init (TPM1, &tpm1_config);
 
     CLOCK_SetTpmClock(1);
-    TPM_SetTimerPeriod(TPM1, TPM_TIMER_PERIOD);
-
-    /* O modo captura de entrada é um modo de configuração do temporizador,
-     * assim como o PWM. Definimos o canal e a forma de interrupção no
-     * pino do canal. Então quando uma interrupção é gerada no canal,
-     * a ISR do TPM é chamada e o valor do contador na hora da interrupção
-     * é salvo automaticamente no registrador TPMx->CONTROLS[n].CnV,
-     * onde n é o numero do canal.
-     * Esse valor pode ser salvo em uma variável na chamada da ISR.*/
-    TPM_SetupInputCapture(TPM1, kTPM_Chnl_0, kTPM_RiseAndFallEdge); // PTA12
-
-    TPM_EnableInterrupts(TPM1, kTPM_Chnl0InterruptEnable);
-    NVIC_EnableIRQ(TPM1_IRQn);
+    tpm_clock = CLOCK_GetPllFllSelClkFreq();
+
+    /* O canal 0 captura o echo (PTA12) e o canal 1, sem pino, marca os
+     * tempos do ciclo: fim do trigger, timeout e início do próximo sensor.*/
+    Ranging_GetDefaultConfig(&ranging_config);
+    ranging_config.base = TPM1;
+    ranging_config.counterClock_Hz = tpm_clock;
+    ranging_config.alarmChannel = kTPM_Chnl_1;
+    ranging_config.sensors = g_sensors;
+    ranging_config.sensorsCount = ARRAY_SIZE(g_sensors);
+    Ranging_Init(&ranging_config);
 
     TPM_StartTimer(TPM1, kTPM_SystemClock);
 
     /* Esperar por ruidos de echo do ultrassonico gerados por causa
      * da inicilização do pino de trigger. */
     Delay_Waitms(500);
-    isFallingEdgeWaiting = false;
-    ultraIsCaptured = false;
-
-    tpm_timerResolution = 1000000000U/(CLOCK_GetPllFllSelClkFreq()/128U);
 
     PRINTF("TPM using ultrassonic example:\n");
-    PRINTF("\t-TPM clock freq: %u Hz\n", CLOCK_GetPllFllSelClkFreq()/128U);
-    PRINTF("\t-TPM clock resolution:%u (ns)\n", tpm_timerResolution);
+    PRINTF("\t-TPM clock freq: %u Hz\n", tpm_clock);
+    PRINTF("\t-TPM clock resolution:%u (ns)\n", 1000000000U/tpm_clock);
+
+    Ranging_Start();
 
     while(true)
     {
-    	/*Gera pulso de trigger - PTB9*/
-    	GPIO_SetPinsOutput(BOARD_INITPINS_TRIGGER_GPIO, BOARD_INITPINS_TRIGGER_PIN_MASK);
-    	Delay_Waitus(10);
-    	GPIO_ClearPinsOutput(BOARD_INITPINS_TRIGGER_GPIO, BOARD_INITPINS_TRIGGER_PIN_MASK);
-
-    	/*Espera pulso de echo ser capturado...*/
-    	while(!ultraIsCaptured);
-    	ultraIsCaptured = false;
-
-    	/*Calcula a distância do objeto em cm e imprime no console.*/
-    	d = (1715U*((ultraEchoPulseCount*tpm_timerResolution)/1000U))/100000U;
-    	PRINTF("Object distance: %u cm\n", d);
-    	Delay_Waitms(400);
+    	/*Imprime cada nova medida, sem esperas: o ritmo é o do
+    	 * agendamento, na máxima taxa segura de cada sensor.*/
+    	for(i = 0U; i < ARRAY_SIZE(g_sensors); i++)
+    	{
+    		Ranging_GetReading(i, &reading);
+    		if(reading.sequence == sequence[i])
+    		{
+    			continue;
+    		}
+    		sequence[i] = reading.sequence;
+
+    		if(reading.valid)
+    		{
+    			PRINTF("Sensor %u: %u mm (raw %u mm)\n", i, reading.distance_mm, reading.raw_mm);
+    		}
+    		else
+    		{
+    			PRINTF("Sensor %u: no echo (%u timeouts)\n", i, reading.timeouts);
+    		}
+    	}
     }
 
     return 0 ;
@@ -0,0 +1,433 @@
+/**
+ * @file	ranging.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * HC-SR04 ranging scheduler on tpm_capture.
+ *
+ * The alarm compare channel matches only the 16 lower bits of an alarm
+ * time, so at each match the 32 bit time is tested and, if the alarm is
+ * not due yet, the channel waits for the next wrap. An alarm set already
+ * due pends the TPM interrupt, instead of waiting a whole wrap.
+ *
+ * The distance is d = t * c / 2, with t = ticks / clock, done as
+ * (ticks * factor) >> shift, the shift being the largest one that keeps
+ * the product of the longest echo in 32 bits.
+ *
+ */
+
+#include <string.h>
+#include "ranging.h"
+#include "tpm_capture.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Width of the trigger pulse.*/
+#define RANGING_TRIGGER_US 10U
+
+/*!< Scheduler states.*/
+typedef enum{
+	kRanging_Stopped = 0U,
+	kRanging_Trigger,   /*!< Trigger pin high.*/
+	kRanging_Listening, /*!< Waiting the echo rising edge.*/
+	kRanging_Echo,      /*!< Waiting the echo falling edge.*/
+	kRanging_Received,  /*!< Echo complete, to be finished.*/
+	kRanging_Guard,     /*!< Waiting to fire the next sensor.*/
+}rangingState_t;
+
+/*!< Sensor runtime data.*/
+typedef struct{
+	GPIO_Type *triggerGpio;
+	uint32_t triggerPinMask;
+	tpm_chnl_t echoChannel;
+	uint32_t lastTrigger;
+	bool fired;                /*!< lastTrigger is valid.*/
+	uint16_t history[3];       /*!< Last valid distances, for the median.*/
+	uint8_t historyCount;
+	int32_t filtered;          /*!< Alpha filter output, Q8.*/
+	rangingReading_t reading;
+}rangingSensorHandle_t;
+
+/*!< Scheduler runtime data.*/
+typedef struct{
+	TPM_Type *base;
+	IRQn_Type irq;
+	tpm_chnl_t alarmChannel;
+	rangingSensorHandle_t sensors[RANGING_MAX_SENSORS];
+	uint8_t count;
+	uint8_t active;            /*!< Sensor being measured.*/
+	volatile rangingState_t state;
+	uint32_t alarm;            /*!< Alarm time.*/
+	volatile bool alarmDue;    /*!< Alarm set already due.*/
+	uint32_t riseTime;
+	uint32_t fallTime;
+	uint32_t triggerTicks;
+	uint32_t timeoutTicks;
+	uint32_t guardTicks;
+	uint32_t periodTicks;
+	uint32_t factor;           /*!< mm per tick, scaled by 2^shift.*/
+	uint8_t shift;
+	uint16_t alpha;
+	rangingCallback_t callback;
+	void *userData;
+}rangingHandle_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Converts microseconds to counter ticks.
+ *
+ */
+static uint32_t UsToTicks(uint32_t us, uint32_t clock_Hz);
+
+/**
+ * @brief Programs the alarm channel.
+ *
+ */
+static void SetAlarm(uint32_t time);
+
+/**
+ * @brief Fires a sensor.
+ *
+ */
+static void Fire(uint8_t sensor);
+
+/**
+ * @brief Ends the measurement of the active sensor and schedules the next.
+ *
+ */
+static void Finish(bool valid, uint32_t width);
+
+/**
+ * @brief Processes the echo edges, from tpm_capture.
+ *
+ */
+static bool EdgeCallback(TPM_Type *base, const tpmCaptureEdge_t *edge, void *userData);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static rangingHandle_t s_ranging;
+
+static TPM_Type *const s_tpmBases[] = TPM_BASE_PTRS;
+static const IRQn_Type s_tpmIrqs[] = TPM_IRQS;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t UsToTicks(uint32_t us, uint32_t clock_Hz)
+{
+	return (uint32_t)(((uint64_t)us * clock_Hz + 500000U) / 1000000U);
+}
+
+static void SetAlarm(uint32_t time)
+{
+	TPM_Type *base = s_ranging.base;
+
+	s_ranging.alarm = time;
+	base->CONTROLS[s_ranging.alarmChannel].CnV = time & 0xFFFFU;
+	TPM_ClearStatusFlags(base, 1U << s_ranging.alarmChannel);
+
+	/* Already due: the match would come only after a whole wrap. */
+	if((int32_t)(TpmCapture_GetTime(base) - time) >= 0)
+	{
+		s_ranging.alarmDue = true;
+		NVIC_SetPendingIRQ(s_ranging.irq);
+	}
+}
+
+static void Fire(uint8_t sensor)
+{
+	rangingSensorHandle_t *handle = &s_ranging.sensors[sensor];
+
+	s_ranging.active = sensor;
+	s_ranging.state = kRanging_Trigger;
+	GPIO_SetPinsOutput(handle->triggerGpio, handle->triggerPinMask);
+	handle->lastTrigger = TpmCapture_GetTime(s_ranging.base);
+	handle->fired = true;
+	SetAlarm(handle->lastTrigger + s_ranging.triggerTicks);
+}
+
+static void Finish(bool valid, uint32_t width)
+{
+	rangingSensorHandle_t *handle = &s_ranging.sensors[s_ranging.active];
+	rangingSensorHandle_t *next;
+	uint16_t a, b, c, median;
+	uint32_t now, start;
+
+	handle->reading.sequence++;
+	handle->reading.valid = valid;
+
+	if(valid)
+	{
+		handle->reading.raw_mm = (uint16_t)((width * s_ranging.factor) >> s_ranging.shift);
+
+		/* Median of the last 3 valid readings. */
+		handle->history[2] = handle->history[1];
+		handle->history[1] = handle->history[0];
+		handle->history[0] = handle->reading.raw_mm;
+		if(handle->historyCount < 3U)
+		{
+			handle->historyCount++;
+			median = handle->reading.raw_mm;
+			handle->filtered = (int32_t)median << 8;
+		}
+		else
+		{
+			a = handle->history[0];
+			b = handle->history[1];
+			c = handle->history[2];
+			median = (a > b) ? ((b > c) ? b : ((a > c) ? c : a)) : ((a > c) ? a : ((b > c) ? c : b));
+			handle->filtered += (((int32_t)median << 8) - handle->filtered) * s_ranging.alpha / 256;
+		}
+		handle->reading.distance_mm = (uint16_t)((handle->filtered + 128) >> 8);
+	}
+	else
+	{
+		handle->reading.timeouts++;
+	}
+
+	if(s_ranging.callback != NULL)
+	{
+		s_ranging.callback(s_ranging.active, &handle->reading, s_ranging.userData);
+	}
+
+	/* Next sensor after the guard time and its own period. */
+	s_ranging.active = (s_ranging.active + 1U < s_ranging.count) ? (s_ranging.active + 1U) : 0U;
+	next = &s_ranging.sensors[s_ranging.active];
+	now = TpmCapture_GetTime(s_ranging.base);
+	start = now + s_ranging.guardTicks;
+	if(next->fired && ((int32_t)(next->lastTrigger + s_ranging.periodTicks - start) > 0))
+	{
+		start = next->lastTrigger + s_ranging.periodTicks;
+	}
+
+	s_ranging.state = kRanging_Guard;
+	SetAlarm(start);
+}
+
+static bool EdgeCallback(TPM_Type *base, const tpmCaptureEdge_t *edge, void *userData)
+{
+	(void)base;
+	(void)userData;
+
+	/* Edges of the other sensors are late reflections or noise. */
+	if(edge->channel != s_ranging.sensors[s_ranging.active].echoChannel)
+	{
+		return false;
+	}
+
+	if(s_ranging.state == kRanging_Listening)
+	{
+		s_ranging.riseTime = edge->timestamp;
+		s_ranging.state = kRanging_Echo;
+	}
+	else if(s_ranging.state == kRanging_Echo)
+	{
+		/* Finished after tpm_capture: the overflow count is updated only
+		 * at its end. */
+		s_ranging.fallTime = edge->timestamp;
+		s_ranging.state = kRanging_Received;
+	}
+
+	return false;
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+void Ranging_GetDefaultConfig(rangingConfig_t *config)
+{
+	memset(config, 0, sizeof(rangingConfig_t));
+	config->speedOfSound_mmps = 343000U;
+	config->timeout_us = 25000U;
+	config->guard_us = 10000U;
+	config->sensorPeriod_us = 60000U;
+	config->alpha = 64U;
+}
+
+status_t Ranging_Init(const rangingConfig_t *config)
+{
+	uint32_t i, instance;
+	uint64_t factor;
+
+	if((config == NULL) || (config->base == NULL) || (config->sensors == NULL) ||
+	   (config->counterClock_Hz == 0U) || (config->sensorsCount == 0U) ||
+	   (config->sensorsCount > RANGING_MAX_SENSORS) || (config->timeout_us == 0U) ||
+	   (config->alpha == 0U) || (config->alpha > 256U))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	for(instance = 0U; instance < ARRAY_SIZE(s_tpmBases); instance++)
+	{
+		if(s_tpmBases[instance] == config->base)
+		{
+			break;
+		}
+	}
+	if(instance == ARRAY_SIZE(s_tpmBases))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	/* The alarm channel is in output compare: it can not capture an echo. */
+	for(i = 0U; i < config->sensorsCount; i++)
+	{
+		if(config->sensors[i].echoChannel == config->alarmChannel)
+		{
+			return kStatus_InvalidArgument;
+		}
+	}
+
+	memset(&s_ranging, 0, sizeof(s_ranging));
+	s_ranging.base = config->base;
+	s_ranging.irq = s_tpmIrqs[instance];
+	s_ranging.alarmChannel = config->alarmChannel;
+	s_ranging.count = config->sensorsCount;
+	s_ranging.alpha = config->alpha;
+	s_ranging.callback = config->callback;
+	s_ranging.userData = config->userData;
+
+	s_ranging.triggerTicks = UsToTicks(RANGING_TRIGGER_US, config->counterClock_Hz);
+	s_ranging.timeoutTicks = UsToTicks(config->timeout_us, config->counterClock_Hz);
+	s_ranging.guardTicks = UsToTicks(config->guard_us, config->counterClock_Hz);
+	s_ranging.periodTicks = UsToTicks(config->sensorPeriod_us, config->counterClock_Hz);
+
+	/* mm per tick = (c / 2) / clock, with the largest shift that keeps the
+	 * longest echo product in 32 bits. */
+	for(s_ranging.shift = 31U; s_ranging.shift > 0U; s_ranging.shift--)
+	{
+		factor = (((uint64_t)config->speedOfSound_mmps / 2U) << s_ranging.shift) / config->counterClock_Hz;
+		if((factor * s_ranging.timeoutTicks) <= 0xFFFFFFFFU)
+		{
+			break;
+		}
+	}
+	s_ranging.factor = (uint32_t)factor;
+
+	for(i = 0U; i < config->sensorsCount; i++)
+	{
+		s_ranging.sensors[i].triggerGpio = config->sensors[i].triggerGpio;
+		s_ranging.sensors[i].triggerPinMask = config->sensors[i].triggerPinMask;
+		s_ranging.sensors[i].echoChannel = config->sensors[i].echoChannel;
+		GPIO_ClearPinsOutput(config->sensors[i].triggerGpio, config->sensors[i].triggerPinMask);
+	}
+
+	(void)TpmCapture_Init(config->base, EdgeCallback, NULL);
+	for(i = 0U; i < config->sensorsCount; i++)
+	{
+		TpmCapture_EnableChannel(config->base, config->sensors[i].echoChannel, kTPM_RiseAndFallEdge);
+	}
+	TPM_SetupOutputCompare(config->base, config->alarmChannel, kTPM_NoOutputSignal, 0U);
+
+	return kStatus_Success;
+}
+
+void Ranging_Start(void)
+{
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	s_ranging.active = 0U;
+	s_ranging.state = kRanging_Guard;
+	TPM_EnableInterrupts(s_ranging.base, 1U << s_ranging.alarmChannel);
+	SetAlarm(TpmCapture_GetTime(s_ranging.base));
+	EnableGlobalIRQ(primask);
+}
+
+void Ranging_Stop(void)
+{
+	uint32_t i, primask;
+
+	primask = DisableGlobalIRQ();
+	TPM_DisableInterrupts(s_ranging.base, 1U << s_ranging.alarmChannel);
+	s_ranging.state = kRanging_Stopped;
+	s_ranging.alarmDue = false;
+	for(i = 0U; i < s_ranging.count; i++)
+	{
+		GPIO_ClearPinsOutput(s_ranging.sensors[i].triggerGpio, s_ranging.sensors[i].triggerPinMask);
+	}
+	EnableGlobalIRQ(primask);
+}
+
+void Ranging_GetReading(uint8_t sensor, rangingReading_t *reading)
+{
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	*reading = s_ranging.sensors[sensor].reading;
+	EnableGlobalIRQ(primask);
+}
+
+void Ranging_IRQHandler(void)
+{
+	TPM_Type *base = s_ranging.base;
+	rangingSensorHandle_t *handle;
+	uint32_t mask = 1U << s_ranging.alarmChannel;
+
+	/* Edges first: an echo ending with the timeout is still taken. */
+	TpmCapture_IRQHandler(base);
+
+	if(s_ranging.state == kRanging_Received)
+	{
+		Finish(true, s_ranging.fallTime - s_ranging.riseTime);
+		return;
+	}
+
+	if(!(base->STATUS & mask) && !s_ranging.alarmDue)
+	{
+		return;
+	}
+	TPM_ClearStatusFlags(base, mask);
+	s_ranging.alarmDue = false;
+
+	if((int32_t)(TpmCapture_GetTime(base) - s_ranging.alarm) < 0)
+	{
+		/* Matched the lower bits only: waits the next wrap. */
+		return;
+	}
+
+	handle = &s_ranging.sensors[s_ranging.active];
+
+	switch(s_ranging.state)
+	{
+		case kRanging_Trigger:
+			GPIO_ClearPinsOutput(handle->triggerGpio, handle->triggerPinMask);
+			s_ranging.state = kRanging_Listening;
+			SetAlarm(handle->lastTrigger + s_ranging.timeoutTicks);
+			break;
+		case kRanging_Listening:
+		case kRanging_Echo:
+			Finish(false, 0U);
+			break;
+		case kRanging_Guard:
+			Fire(s_ranging.active);
+			break;
+		default:
+			break;
+	}
+}
@@ -0,0 +1,176 @@
+/**
+ * @file	ranging.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Ranging scheduler for up to RANGING_MAX_SENSORS HC-SR04 ultrasonic
+ * sensors, with their echo pins on capture channels of one TPM.
+ *
+ * The sensors are fired one at a time, in turn, so the echo of one is
+ * never taken by another. The whole cycle runs from the TPM interrupt:
+ *
+ *   1. the trigger pin is set and, 10 us later, cleared;
+ *   2. the echo edges are captured by tpm_capture, with 32 bit times;
+ *   3. without the falling edge before the timeout, the reading is
+ *      marked invalid;
+ *   4. the next sensor is fired after the guard time (for the late
+ *      reflections to fade), but not before its own minimum period.
+ *
+ * The times are kept by a software compare channel (the alarm channel)
+ * of the same TPM, with no pin.
+ *
+ * The echo width is converted to millimeters by one multiplication and a
+ * shift, with the factor computed by Ranging_Init(). The readings pass
+ * through a median of 3 filter, against single outliers, and then an
+ * exponential (alpha) filter.
+ *
+ * The TPM must be previously initialized by TPM_Init() and started by
+ * TPM_StartTimer(); the trigger pins must be GPIO outputs. The
+ * application must call Ranging_IRQHandler() from the TPM interrupt
+ * handler.
+ *
+ */
+
+#ifndef RANGING_H_
+#define RANGING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "fsl_gpio.h"
+#include "fsl_tpm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup ranging
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Maximum number of sensors.*/
+#define RANGING_MAX_SENSORS 4U
+
+/*!
+ * @brief A sensor.
+ */
+typedef struct{
+	GPIO_Type *triggerGpio;  /*!< GPIO of the trigger pin.*/
+	uint32_t triggerPinMask; /*!< Trigger pin mask.*/
+	tpm_chnl_t echoChannel;  /*!< Capture channel of the echo pin.*/
+}rangingSensor_t;
+
+/*!
+ * @brief A reading.
+ */
+typedef struct{
+	uint16_t distance_mm; /*!< Filtered distance.*/
+	uint16_t raw_mm;      /*!< Last distance, not filtered.*/
+	bool valid;           /*!< The last echo arrived before the timeout.*/
+	uint32_t sequence;    /*!< Number of measurements.*/
+	uint32_t timeouts;    /*!< Number of echoes missed.*/
+}rangingReading_t;
+
+/*!< Measurement callback, called in interrupt context.*/
+typedef void (*rangingCallback_t)(uint8_t sensor, const rangingReading_t *reading, void *userData);
+
+/*!
+ * @brief Scheduler configuration structure.
+ */
+typedef struct{
+	TPM_Type *base;                 /*!< TPM of the echo and alarm channels.*/
+	uint32_t counterClock_Hz;       /*!< TPM counter clock (after the prescaler).*/
+	tpm_chnl_t alarmChannel;        /*!< Channel used as software compare.*/
+	const rangingSensor_t *sensors; /*!< Sensor list, the index is the sensor number.*/
+	uint8_t sensorsCount;           /*!< Number of sensors (1 to RANGING_MAX_SENSORS).*/
+	uint32_t speedOfSound_mmps;     /*!< Speed of sound, in mm/s.*/
+	uint32_t timeout_us;            /*!< Longest echo accepted (range limit).*/
+	uint32_t guard_us;              /*!< Wait after an echo, before the next sensor.*/
+	uint32_t sensorPeriod_us;       /*!< Shortest period between triggers of one sensor.*/
+	uint16_t alpha;                 /*!< Weight of a new reading, Q8 (256 = no filter).*/
+	rangingCallback_t callback;     /*!< Measurement callback, can be NULL.*/
+	void *userData;                 /*!< Parameter passed to the callback.*/
+}rangingConfig_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Gets the default timing and filters: 343 m/s, 25 ms timeout
+ *        (4.3 m), 10 ms guard, 60 ms sensor period and alpha of 0.25.
+ *
+ * @param config - the configuration to be filled.
+ *
+ */
+void Ranging_GetDefaultConfig(rangingConfig_t *config);
+
+/**
+ * @brief Configures the capture and alarm channels and the conversion.
+ *
+ * @param config - the configuration.
+ *
+ * @return kStatus_Success if configured;
+ *         kStatus_InvalidArgument if any parameter is invalid, or if an echo
+ *         channel is the alarm channel.
+ *
+ */
+status_t Ranging_Init(const rangingConfig_t *config);
+
+/**
+ * @brief Starts the measurement cycle, from the first sensor.
+ *
+ */
+void Ranging_Start(void);
+
+/**
+ * @brief Stops the measurement cycle.
+ *
+ */
+void Ranging_Stop(void);
+
+/**
+ * @brief Copies the last reading of a sensor.
+ *
+ * @param sensor  - the sensor number.
+ * @param reading - where the reading is copied.
+ *
+ */
+void Ranging_GetReading(uint8_t sensor, rangingReading_t *reading);
+
+/**
+ * @brief The scheduler interrupt routine, which also serves tpm_capture.
+ *
+ *        Must be called from the TPM interrupt handler (TPMn_IRQHandler()).
+ *
+ */
+void Ranging_IRQHandler(void);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* RANGING_H_ */
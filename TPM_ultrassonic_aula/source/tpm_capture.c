@@ -0,0 +1,247 @@
+/**
+ * @file	tpm_capture.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * TPM input capture extended to 32 bits by the overflow count.
+ *
+ * The interrupt takes one snapshot of STATUS and clears just those flags:
+ * the captures in it are ordered against the overflow in it, and any
+ * flag raised later is left for the next interrupt.
+ *
+ */
+
+#include <string.h>
+#include "tpm_capture.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define TPM_CAPTURE_QUEUE_MASK (TPM_CAPTURE_QUEUE_SIZE - 1U)
+
+#define TPM_CAPTURE_CHANNELS_MASK 0xFFU
+
+/*!< Captured values below it were taken after a pending overflow.*/
+#define TPM_CAPTURE_HALF_PERIOD 0x8000U
+
+/*!< Capture runtime data of one TPM.*/
+typedef struct{
+	volatile uint32_t overflows;        /*!< Upper 16 bits of the time.*/
+	uint32_t channels;                  /*!< Enabled channel flags.*/
+	tpmCaptureEdge_t queue[TPM_CAPTURE_QUEUE_SIZE];
+	volatile uint8_t head;
+	volatile uint8_t tail;
+	volatile uint32_t lost;
+	tpmCaptureCallback_t callback;
+	void *userData;
+}tpmCaptureHandle_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Gets the instance of a TPM, ARRAY_SIZE(s_tpmBases) if none.
+ *
+ */
+static uint32_t GetInstance(TPM_Type *base);
+
+/**
+ * @brief Gets the handle of a TPM.
+ *
+ */
+static inline tpmCaptureHandle_t *GetHandle(TPM_Type *base);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static TPM_Type *const s_tpmBases[] = TPM_BASE_PTRS;
+static const IRQn_Type s_tpmIrqs[] = TPM_IRQS;
+
+static tpmCaptureHandle_t s_captures[ARRAY_SIZE(s_tpmBases)];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t GetInstance(TPM_Type *base)
+{
+	uint32_t i;
+
+	for(i = 0U; i < ARRAY_SIZE(s_tpmBases); i++)
+	{
+		if(s_tpmBases[i] == base)
+		{
+			break;
+		}
+	}
+
+	return i;
+}
+
+static inline tpmCaptureHandle_t *GetHandle(TPM_Type *base)
+{
+	return &s_captures[GetInstance(base)];
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t TpmCapture_Init(TPM_Type *base, tpmCaptureCallback_t callback, void *userData)
+{
+	tpmCaptureHandle_t *handle;
+	uint32_t instance = GetInstance(base);
+
+	if(instance >= ARRAY_SIZE(s_tpmBases))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	handle = &s_captures[instance];
+	DisableIRQ(s_tpmIrqs[instance]);
+
+	memset(handle, 0, sizeof(tpmCaptureHandle_t));
+	handle->callback = callback;
+	handle->userData = userData;
+
+	TPM_SetTimerPeriod(base, 0xFFFFU);
+	TPM_ClearStatusFlags(base, kTPM_TimeOverflowFlag);
+	TPM_EnableInterrupts(base, kTPM_TimeOverflowInterruptEnable);
+
+	EnableIRQ(s_tpmIrqs[instance]);
+
+	return kStatus_Success;
+}
+
+void TpmCapture_EnableChannel(TPM_Type *base, tpm_chnl_t channel, tpm_input_capture_edge_t edge)
+{
+	tpmCaptureHandle_t *handle = GetHandle(base);
+
+	TPM_SetupInputCapture(base, channel, edge);
+	TPM_ClearStatusFlags(base, 1U << channel);
+	handle->channels |= (1U << channel);
+	TPM_EnableInterrupts(base, 1U << channel);
+}
+
+void TpmCapture_DisableChannel(TPM_Type *base, tpm_chnl_t channel)
+{
+	tpmCaptureHandle_t *handle = GetHandle(base);
+
+	TPM_DisableInterrupts(base, 1U << channel);
+	handle->channels &= ~(1U << channel);
+	TPM_ClearStatusFlags(base, 1U << channel);
+}
+
+uint32_t TpmCapture_GetTime(TPM_Type *base)
+{
+	tpmCaptureHandle_t *handle = GetHandle(base);
+	uint32_t primask, count, status, overflows;
+
+	primask = DisableGlobalIRQ();
+	/* The counter is read before the flag: an overflow between them comes
+	 * with a count in the upper half and is not counted twice. */
+	count = base->CNT & 0xFFFFU;
+	status = base->STATUS;
+	overflows = handle->overflows;
+	EnableGlobalIRQ(primask);
+
+	if((status & kTPM_TimeOverflowFlag) && (count < TPM_CAPTURE_HALF_PERIOD))
+	{
+		overflows++;
+	}
+
+	return (overflows << 16U) | count;
+}
+
+bool TpmCapture_GetEdge(TPM_Type *base, tpmCaptureEdge_t *edge)
+{
+	tpmCaptureHandle_t *handle = GetHandle(base);
+	uint8_t tail = handle->tail;
+
+	if(tail == handle->head)
+	{
+		return false;
+	}
+
+	*edge = handle->queue[tail & TPM_CAPTURE_QUEUE_MASK];
+	handle->tail = tail + 1U;
+
+	return true;
+}
+
+void TpmCapture_Flush(TPM_Type *base)
+{
+	tpmCaptureHandle_t *handle = GetHandle(base);
+
+	handle->tail = handle->head;
+}
+
+uint32_t TpmCapture_GetLostEdges(TPM_Type *base)
+{
+	return GetHandle(base)->lost;
+}
+
+void TpmCapture_IRQHandler(TPM_Type *base)
+{
+	tpmCaptureHandle_t *handle = GetHandle(base);
+	tpmCaptureEdge_t edge;
+	uint32_t status, pending, value, overflows;
+	uint8_t head;
+
+	status = base->STATUS & (handle->channels | kTPM_TimeOverflowFlag);
+	base->STATUS = status;
+
+	overflows = handle->overflows;
+	pending = status & handle->channels & TPM_CAPTURE_CHANNELS_MASK;
+
+	for(edge.channel = kTPM_Chnl_0; pending != 0U; edge.channel++, pending >>= 1U)
+	{
+		if(!(pending & 1U))
+		{
+			continue;
+		}
+
+		/* With the overflow pending, a low value was captured after it. */
+		value = base->CONTROLS[edge.channel].CnV & 0xFFFFU;
+		edge.timestamp = (((status & kTPM_TimeOverflowFlag) && (value < TPM_CAPTURE_HALF_PERIOD)) ?
+		                  ((overflows + 1U) << 16U) : (overflows << 16U)) | value;
+
+		if((handle->callback != NULL) && !handle->callback(base, &edge, handle->userData))
+		{
+			continue;
+		}
+
+		head = handle->head;
+		if((uint8_t)(head - handle->tail) >= TPM_CAPTURE_QUEUE_SIZE)
+		{
+			handle->lost++;
+			continue;
+		}
+		handle->queue[head & TPM_CAPTURE_QUEUE_MASK] = edge;
+		handle->head = head + 1U;
+	}
+
+	if(status & kTPM_TimeOverflowFlag)
+	{
+		handle->overflows = overflows + 1U;
+	}
+}
@@ -0,0 +1,251 @@
+/**
+ * @file	baud_plan.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A baud rate planner for the KL25Z serial ports.
+ *
+ * The search uses 64 bit arithmetic, that is slow in the Cortex-M0+,
+ * but it is done only once, when the port is configured.
+ *
+ */
+
+#include "baud_plan.h"
+#include "fsl_clock.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BAUD_PLAN_SBR_MAX 8191U  /*!< 13 bits SBR field.*/
+#define BAUD_PLAN_OSR_MIN 4U     /*!< UART0 minimum oversampling ratio.*/
+#define BAUD_PLAN_OSR_MAX 32U    /*!< UART0 maximum oversampling ratio.*/
+#define BAUD_PLAN_OSR_BOTH_EDGE 8U /*!< Below this ratio UART0 must sample in both edges.*/
+#define BAUD_PLAN_UART_OSR 16U   /*!< UART1/2 fixed oversampling ratio.*/
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Returns the error, in ppm, of dividing clock_Hz by divisor/scale
+ *        to get baudRate_Bps.
+ *
+ */
+static int32_t GetErrorPpm(uint32_t clock_Hz, uint32_t divisor, uint32_t scale, uint32_t baudRate_Bps);
+
+/**
+ * @brief Returns the absolute value of an error.
+ *
+ */
+static inline uint32_t AbsError(int32_t error)
+{
+	return (error < 0) ? (uint32_t)(-error) : (uint32_t)error;
+}
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static int32_t GetErrorPpm(uint32_t clock_Hz, uint32_t divisor, uint32_t scale, uint32_t baudRate_Bps)
+{
+	/* achieved / desired - 1 = (clock * scale) / (divisor * baud) - 1 */
+	uint64_t num = (uint64_t)clock_Hz * scale * 1000000U;
+	uint64_t den = (uint64_t)divisor * baudRate_Bps;
+
+	return (int32_t)((int64_t)((num + den / 2U) / den) - 1000000);
+}
+
+status_t BaudPlan_ComputeLpsci(uint32_t baudRate_Bps, uint32_t clock_Hz, baudPlan_t *plan)
+{
+	uint32_t osr, sbr, candidate;
+	uint32_t bestAbs = UINT32_MAX;
+	int32_t error;
+
+	if((baudRate_Bps == 0U) || (clock_Hz == 0U))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	for(osr = BAUD_PLAN_OSR_MIN; osr <= BAUD_PLAN_OSR_MAX; osr++)
+	{
+		/* The best SBR is one of the two around clock / (osr * baud). */
+		sbr = clock_Hz / (osr * baudRate_Bps);
+		for(candidate = sbr; candidate <= sbr + 1U; candidate++)
+		{
+			if((candidate == 0U) || (candidate > BAUD_PLAN_SBR_MAX))
+			{
+				continue;
+			}
+			error = GetErrorPpm(clock_Hz, osr * candidate, 1U, baudRate_Bps);
+			/* "<=": for the same error keeps the highest OSR. */
+			if(AbsError(error) <= bestAbs)
+			{
+				bestAbs = AbsError(error);
+				plan->osr = (uint8_t)osr;
+				plan->sbr = (uint16_t)candidate;
+				plan->error_ppm = error;
+			}
+		}
+	}
+
+	if(bestAbs == UINT32_MAX)
+	{
+		/* Even SBR = 8191 with OSR = 32 is too fast: clock too high for the baud rate. */
+		plan->osr = BAUD_PLAN_OSR_MAX;
+		plan->sbr = BAUD_PLAN_SBR_MAX;
+		plan->error_ppm = GetErrorPpm(clock_Hz, BAUD_PLAN_OSR_MAX * BAUD_PLAN_SBR_MAX, 1U, baudRate_Bps);
+		bestAbs = AbsError(plan->error_ppm);
+	}
+
+	plan->brfa = 0U;
+	plan->clock_Hz = clock_Hz;
+	plan->baudRate_Bps = (clock_Hz + (plan->osr * plan->sbr) / 2U) / (plan->osr * plan->sbr);
+
+	return (bestAbs <= BAUD_PLAN_MAX_ERROR_PPM) ? kStatus_Success : kStatus_OutOfRange;
+}
+
+status_t BaudPlan_ComputeUart(uint32_t baudRate_Bps, uint32_t clock_Hz, baudPlan_t *plan)
+{
+	uint32_t divisor;
+
+	if((baudRate_Bps == 0U) || (clock_Hz == 0U))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+#if defined(FSL_FEATURE_UART_HAS_BAUD_RATE_FINE_ADJUST_SUPPORT) && FSL_FEATURE_UART_HAS_BAUD_RATE_FINE_ADJUST_SUPPORT
+	/* Divisor in 1/32 steps: baud = clock / (16 * (SBR + BRFA/32)) = 2 * clock / (32 * SBR + BRFA). */
+	divisor = (uint32_t)(((uint64_t)clock_Hz * 2U + baudRate_Bps / 2U) / baudRate_Bps);
+	if(divisor < 32U)
+	{
+		divisor = 32U;
+	}
+	else if(divisor > (BAUD_PLAN_SBR_MAX * 32U + 31U))
+	{
+		divisor = BAUD_PLAN_SBR_MAX * 32U + 31U;
+	}
+	plan->sbr = (uint16_t)(divisor >> 5U);
+	plan->brfa = (uint8_t)(divisor & 0x1FU);
+	plan->error_ppm = GetErrorPpm(clock_Hz, divisor, 2U, baudRate_Bps);
+	plan->baudRate_Bps = (uint32_t)(((uint64_t)clock_Hz * 2U + divisor / 2U) / divisor);
+#else
+	divisor = (clock_Hz + (BAUD_PLAN_UART_OSR * baudRate_Bps) / 2U) / (BAUD_PLAN_UART_OSR * baudRate_Bps);
+	if(divisor == 0U)
+	{
+		divisor = 1U;
+	}
+	else if(divisor > BAUD_PLAN_SBR_MAX)
+	{
+		divisor = BAUD_PLAN_SBR_MAX;
+	}
+	plan->sbr = (uint16_t)divisor;
+	plan->brfa = 0U;
+	plan->error_ppm = GetErrorPpm(clock_Hz, BAUD_PLAN_UART_OSR * divisor, 1U, baudRate_Bps);
+	plan->baudRate_Bps = (clock_Hz + (BAUD_PLAN_UART_OSR * divisor) / 2U) / (BAUD_PLAN_UART_OSR * divisor);
+#endif
+	plan->osr = BAUD_PLAN_UART_OSR;
+	plan->clock_Hz = clock_Hz;
+
+	return (AbsError(plan->error_ppm) <= BAUD_PLAN_MAX_ERROR_PPM) ? kStatus_Success : kStatus_OutOfRange;
+}
+
+status_t BaudPlan_FindLpsci(uint32_t baudRate_Bps, baudPlan_t *plan)
+{
+	const baudPlanClock_t sources[] = {kBaudPlan_ClockPllFll, kBaudPlan_ClockOscEr, kBaudPlan_ClockMcgIr};
+	uint32_t frequencies[3];
+	baudPlan_t candidate;
+	status_t status = kStatus_InvalidArgument;
+	uint32_t i;
+
+	frequencies[0] = CLOCK_GetPllFllSelClkFreq();
+	frequencies[1] = CLOCK_GetOsc0ErClkFreq();
+	frequencies[2] = CLOCK_GetInternalRefClkFreq();
+
+	for(i = 0U; i < ARRAY_SIZE(sources); i++)
+	{
+		if(BaudPlan_ComputeLpsci(baudRate_Bps, frequencies[i], &candidate) == kStatus_InvalidArgument)
+		{
+			continue; /* Clock source not running. */
+		}
+		candidate.clockSource = sources[i];
+		/* Sources are in preference order, so a later one must be strictly better. */
+		if((status == kStatus_InvalidArgument) || (AbsError(candidate.error_ppm) < AbsError(plan->error_ppm)))
+		{
+			*plan = candidate;
+			status = kStatus_Success;
+		}
+	}
+
+	if((status == kStatus_Success) && (AbsError(plan->error_ppm) > BAUD_PLAN_MAX_ERROR_PPM))
+	{
+		status = kStatus_OutOfRange;
+	}
+
+	return status;
+}
+
+status_t BaudPlan_FindUart(uint32_t baudRate_Bps, baudPlan_t *plan)
+{
+	plan->clockSource = kBaudPlan_ClockBus;
+
+	return BaudPlan_ComputeUart(baudRate_Bps, CLOCK_GetBusClkFreq(), plan);
+}
+
+void BaudPlan_ApplyLpsci(UART0_Type *base, const baudPlan_t *plan)
+{
+	uint8_t oldCtrl = base->C2;
+
+	/* Disable TX and RX before changing the divisors. */
+	base->C2 &= ~(UART0_C2_TE_MASK | UART0_C2_RE_MASK);
+
+	CLOCK_SetLpsci0Clock(plan->clockSource);
+
+	/* Both edges sampling is mandatory for OSR from 4 to 7, and optional above. */
+	if(plan->osr < BAUD_PLAN_OSR_BOTH_EDGE)
+	{
+		base->C5 |= UART0_C5_BOTHEDGE_MASK;
+	}
+	else
+	{
+		base->C5 &= ~UART0_C5_BOTHEDGE_MASK;
+	}
+
+	/* The register holds the ratio minus one. */
+	base->C4 = (base->C4 & ~UART0_C4_OSR_MASK) | UART0_C4_OSR(plan->osr - 1U);
+	base->BDH = (base->BDH & ~UART0_BDH_SBR_MASK) | UART0_BDH_SBR(plan->sbr >> 8U);
+	base->BDL = (uint8_t)plan->sbr;
+
+	base->C2 = oldCtrl;
+}
+
+void BaudPlan_ApplyUart(UART_Type *base, const baudPlan_t *plan)
+{
+	uint8_t oldCtrl = base->C2;
+
+	base->C2 &= ~(UART_C2_TE_MASK | UART_C2_RE_MASK);
+
+	base->BDH = (base->BDH & ~UART_BDH_SBR_MASK) | UART_BDH_SBR(plan->sbr >> 8U);
+	base->BDL = (uint8_t)plan->sbr;
+#if defined(FSL_FEATURE_UART_HAS_BAUD_RATE_FINE_ADJUST_SUPPORT) && FSL_FEATURE_UART_HAS_BAUD_RATE_FINE_ADJUST_SUPPORT
+	base->C4 = (base->C4 & ~UART_C4_BRFA_MASK) | UART_C4_BRFA(plan->brfa);
+#endif
+
+	base->C2 = oldCtrl;
+}
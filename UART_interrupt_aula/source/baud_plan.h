@@ -0,0 +1,179 @@
+/**
+ * @file	baud_plan.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A baud rate planner for the KL25Z serial ports.
+ *
+ * LPSCI_Init() and UART_Init() derive the divisors from one fixed clock.
+ * For high rates (921600 bps, 1 to 3 Mbps) the error obtained can be out of
+ * the UART tolerance. The planner searches all the divisor combinations:
+ *
+ *   - UART0 (LPSCI): baud = clock / (OSR * SBR), OSR from 4 to 32,
+ *                    SBR from 1 to 8191, for each UART0 clock source
+ *                    (MCGFLLCLK/MCGPLLCLK/2, OSCERCLK and MCGIRCLK);
+ *   - UART1/2:       baud = busClock / (16 * (SBR + BRFA/32)), where the
+ *                    BRFA fine adjust is only used if the device has it.
+ *
+ * and returns the best achievable rate, its error and the clock source
+ * required. The plan is then applied with BaudPlan_ApplyLpsci() or
+ * BaudPlan_ApplyUart(), after LPSCI_Init()/UART_Init().
+ *
+ */
+
+#ifndef BAUD_PLAN_H_
+#define BAUD_PLAN_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup baud_plan
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Maximum accepted error, in parts per million. The receiver
+ *   tolerates about 3% (4.5% in both sides of a link), so keeping
+ *   each side below 2% leaves margin for the other side clock.*/
+#define BAUD_PLAN_MAX_ERROR_PPM 20000
+
+/*!< Clock sources, the values are the SIM_SOPT2[UART0SRC] field.*/
+typedef enum{
+	kBaudPlan_ClockPllFll = 1U, /*!< MCGFLLCLK or MCGPLLCLK/2 (UART0 only).*/
+	kBaudPlan_ClockOscEr = 2U,  /*!< OSCERCLK (UART0 only).*/
+	kBaudPlan_ClockMcgIr = 3U,  /*!< MCGIRCLK (UART0 only).*/
+	kBaudPlan_ClockBus = 4U,    /*!< Bus clock (UART1/2 only).*/
+}baudPlanClock_t;
+
+/*!
+ * @brief The divisors found by the planner.
+ */
+typedef struct{
+	baudPlanClock_t clockSource; /*!< Required clock source.*/
+	uint32_t clock_Hz;           /*!< Clock source frequency.*/
+	uint16_t sbr;                /*!< Baud rate modulo divisor (1 to 8191).*/
+	uint8_t osr;                 /*!< Oversampling ratio (4 to 32, always 16 in UART1/2).*/
+	uint8_t brfa;                /*!< Fine adjust in 1/32 steps (UART1/2 with BRFA only).*/
+	uint32_t baudRate_Bps;       /*!< Achieved baud rate.*/
+	int32_t error_ppm;           /*!< Achieved error, in parts per million.*/
+}baudPlan_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Computes the best UART0 divisors for one clock frequency.
+ *
+ *        For the same error, the highest oversampling ratio is chosen,
+ *        because it improves the noise immunity.
+ *
+ * @param baudRate_Bps - the desired baud rate.
+ * @param clock_Hz     - the UART0 clock frequency.
+ * @param plan         - where the result is stored. The clockSource
+ *                       field is not changed.
+ *
+ * @return kStatus_Success if the error is below BAUD_PLAN_MAX_ERROR_PPM;
+ *         kStatus_OutOfRange otherwise (the plan holds the best found);
+ *         kStatus_InvalidArgument if a frequency is zero.
+ *
+ */
+status_t BaudPlan_ComputeLpsci(uint32_t baudRate_Bps, uint32_t clock_Hz, baudPlan_t *plan);
+
+/**
+ * @brief Computes the best UART1/2 divisors for one clock frequency.
+ *
+ * @param baudRate_Bps - the desired baud rate.
+ * @param clock_Hz     - the bus clock frequency.
+ * @param plan         - where the result is stored. The clockSource
+ *                       field is not changed.
+ *
+ * @return kStatus_Success if the error is below BAUD_PLAN_MAX_ERROR_PPM;
+ *         kStatus_OutOfRange otherwise (the plan holds the best found);
+ *         kStatus_InvalidArgument if a frequency is zero.
+ *
+ */
+status_t BaudPlan_ComputeUart(uint32_t baudRate_Bps, uint32_t clock_Hz, baudPlan_t *plan);
+
+/**
+ * @brief Searches the best UART0 plan among the running clock sources.
+ *
+ *        The clock frequencies are read from the clock driver, so the
+ *        clocks must be configured before (BOARD_BootClockRUN()).
+ *
+ * @param baudRate_Bps - the desired baud rate.
+ * @param plan         - where the result is stored.
+ *
+ * @return kStatus_Success if the error is below BAUD_PLAN_MAX_ERROR_PPM;
+ *         kStatus_OutOfRange otherwise (the plan holds the best found);
+ *         kStatus_InvalidArgument if no clock source is running.
+ *
+ */
+status_t BaudPlan_FindLpsci(uint32_t baudRate_Bps, baudPlan_t *plan);
+
+/**
+ * @brief Searches the best UART1/2 plan, using the bus clock.
+ *
+ * @param baudRate_Bps - the desired baud rate.
+ * @param plan         - where the result is stored.
+ *
+ * @return The same as BaudPlan_ComputeUart().
+ *
+ */
+status_t BaudPlan_FindUart(uint32_t baudRate_Bps, baudPlan_t *plan);
+
+/**
+ * @brief Selects the UART0 clock source and writes the divisors.
+ *
+ *        The transmitter and receiver are disabled while the divisors
+ *        are written, and restored after.
+ *
+ * @param base - UART0 peripheral base address.
+ * @param plan - a plan returned by BaudPlan_FindLpsci() or
+ *               BaudPlan_ComputeLpsci().
+ *
+ */
+void BaudPlan_ApplyLpsci(UART0_Type *base, const baudPlan_t *plan);
+
+/**
+ * @brief Writes the UART1/2 divisors.
+ *
+ * @param base - UART1 or UART2 peripheral base address.
+ * @param plan - a plan returned by BaudPlan_FindUart() or
+ *               BaudPlan_ComputeUart().
+ *
+ */
+void BaudPlan_ApplyUart(UART_Type *base, const baudPlan_t *plan);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* BAUD_PLAN_H_ */
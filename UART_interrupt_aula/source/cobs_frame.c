@@ -0,0 +1,430 @@
+/**
+ * @file	cobs_frame.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A COBS packet framing layer over the uart_xfer engine.
+ *
+ * COBS encoding: the data, with an implicit 0x00 appended, is split in
+ * blocks ended by each zero. Each block is sent as a code byte (block
+ * length + 1) followed by its non-zero bytes; the zero is not sent. A
+ * block of 254 non-zero bytes has code 0xFF and no zero after it.
+ *
+ */
+
+#include "cobs_frame.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define COBS_FRAME_QUEUE_MASK (COBS_FRAME_POOL_SIZE - 1U)
+#define COBS_FRAME_MAX_CODE 0xFFU
+#define COBS_FRAME_BUFFER_SIZE (COBS_FRAME_MAX_PAYLOAD + COBS_FRAME_CRC_SIZE)
+
+/*!< State of the frame being received.*/
+typedef enum{
+	kCobsFrame_RxIdle = 0U,  /*!< Waiting the first byte of a frame.*/
+	kCobsFrame_RxActive,     /*!< Decoding.*/
+	kCobsFrame_RxBad,        /*!< Discarding up to the delimiter, bad frame.*/
+	kCobsFrame_RxDropped,    /*!< Discarding up to the delimiter, no buffer.*/
+}cobsFrameRxState_t;
+
+/*!< Runtime data of one port.
+ *   The queue indexes are free running, as in uart_xfer. Both queues
+ *   have room for the whole pool, so they never overflow.*/
+typedef struct{
+	/* Reception, only used by the ISR. */
+	cobsFramePacket_t *rxPacket; /*!< Buffer being filled, kept between frames.*/
+	uint16_t rxLength;           /*!< Decoded bytes, including the CRC.*/
+	uint16_t rxCrc;              /*!< CRC of the decoded bytes.*/
+	uint8_t rxCode;              /*!< Current block code, 0 before the first block.*/
+	uint8_t rxRemaining;         /*!< Bytes left in the current block.*/
+	cobsFrameRxState_t rxState;
+	cobsFramePacket_t *rxQueue[COBS_FRAME_POOL_SIZE];
+	volatile uint8_t rxHead;     /*!< Written by the ISR.*/
+	volatile uint8_t rxTail;     /*!< Written by the application.*/
+
+	/* Transmission. */
+	cobsFramePacket_t *txQueue[COBS_FRAME_POOL_SIZE];
+	volatile uint8_t txHead;     /*!< Written by the application.*/
+	volatile uint8_t txTail;     /*!< Written by the ISR.*/
+	cobsFramePacket_t *volatile txPacket; /*!< Packet being encoded.*/
+	uint16_t txIndex;            /*!< Next data byte to send.*/
+	uint16_t txBlockEnd;         /*!< End of the current block.*/
+	uint16_t txLength;           /*!< Payload + CRC length.*/
+	uint8_t txCode;              /*!< Current block code, 0 before the first block.*/
+
+	cobsFrameCallback_t callback;
+	void *userData;
+	cobsFrameStats_t stats;
+}cobsFrameLink_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief uart_xfer RX hook: decodes one byte.
+ *
+ */
+static void RxHook(uartXferPort_t port, uint8_t data, bool error, void *userData);
+
+/**
+ * @brief uart_xfer TX source: encodes the next byte.
+ *
+ */
+static bool TxSource(uartXferPort_t port, uint8_t *data, void *userData);
+
+/**
+ * @brief Updates the CRC with one byte, using a 16 entries (4 bits) table.
+ *
+ */
+static inline uint16_t Crc16Update(uint16_t crc, uint8_t data);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static cobsFrameLink_t s_links[kUartXfer_PortsNumber];
+
+static cobsFramePacket_t s_pool[COBS_FRAME_POOL_SIZE];
+static cobsFramePacket_t *s_freeList[COBS_FRAME_POOL_SIZE];
+static uint8_t s_freeCount;
+static bool s_poolReady = false;
+
+/*!< CRC-16/CCITT of each nibble. 32 bytes of flash instead of 512 of a
+ *   byte table, for two lookups per byte.*/
+static const uint16_t s_crcTable[16] = {
+	0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+	0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU,
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static inline uint16_t Crc16Update(uint16_t crc, uint8_t data)
+{
+	crc = (uint16_t)(crc << 4U) ^ s_crcTable[(crc >> 12U) ^ (data >> 4U)];
+	crc = (uint16_t)(crc << 4U) ^ s_crcTable[(crc >> 12U) ^ (data & 0x0FU)];
+
+	return crc;
+}
+
+uint16_t CobsFrame_Crc16(uint16_t crc, const uint8_t *data, size_t length)
+{
+	while(length--)
+	{
+		crc = Crc16Update(crc, *data++);
+	}
+
+	return crc;
+}
+
+status_t CobsFrame_Init(uartXferPort_t port, const cobsFrameConfig_t *config)
+{
+	cobsFrameLink_t *link;
+	uartXferConfig_t xferConfig;
+	uint32_t primask;
+	uint32_t i;
+
+	if((port >= kUartXfer_PortsNumber) || (config == NULL))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	primask = DisableGlobalIRQ();
+	if(!s_poolReady)
+	{
+		for(i = 0U; i < COBS_FRAME_POOL_SIZE; i++)
+		{
+			s_freeList[i] = &s_pool[i];
+		}
+		s_freeCount = COBS_FRAME_POOL_SIZE;
+		s_poolReady = true;
+	}
+	EnableGlobalIRQ(primask);
+
+	link = &s_links[port];
+	memset(link, 0, sizeof(*link));
+	link->callback = config->callback;
+	link->userData = config->userData;
+
+	xferConfig.rxBuffer = NULL;
+	xferConfig.rxBufferSize = 0U;
+	xferConfig.txBuffer = NULL;
+	xferConfig.txBufferSize = 0U;
+	xferConfig.enableIdleLine = false;
+	xferConfig.callback = NULL;
+	xferConfig.rxHook = RxHook;
+	xferConfig.txSource = TxSource;
+	xferConfig.userData = link;
+
+	return UartXfer_Init(port, &xferConfig);
+}
+
+cobsFramePacket_t *CobsFrame_Alloc(void)
+{
+	cobsFramePacket_t *packet = NULL;
+	uint32_t primask = DisableGlobalIRQ();
+
+	if(s_freeCount != 0U)
+	{
+		packet = s_freeList[--s_freeCount];
+	}
+	EnableGlobalIRQ(primask);
+
+	return packet;
+}
+
+void CobsFrame_Free(cobsFramePacket_t *packet)
+{
+	uint32_t primask = DisableGlobalIRQ();
+
+	s_freeList[s_freeCount++] = packet;
+	EnableGlobalIRQ(primask);
+}
+
+status_t CobsFrame_Send(uartXferPort_t port, cobsFramePacket_t *packet)
+{
+	cobsFrameLink_t *link = &s_links[port];
+	uint16_t crc;
+
+	if(packet->length > COBS_FRAME_MAX_PAYLOAD)
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	crc = CobsFrame_Crc16(0xFFFFU, packet->data, packet->length);
+	packet->data[packet->length] = (uint8_t)(crc >> 8U);
+	packet->data[packet->length + 1U] = (uint8_t)crc;
+
+	/* A packet is only in one queue at a time, so there is always room. */
+	link->txQueue[link->txHead & COBS_FRAME_QUEUE_MASK] = packet;
+	link->txHead++;
+	UartXfer_StartTx(port);
+
+	return kStatus_Success;
+}
+
+cobsFramePacket_t *CobsFrame_Receive(uartXferPort_t port)
+{
+	cobsFrameLink_t *link = &s_links[port];
+	cobsFramePacket_t *packet;
+	uint8_t tail = link->rxTail;
+
+	if(tail == link->rxHead)
+	{
+		return NULL;
+	}
+
+	packet = link->rxQueue[tail & COBS_FRAME_QUEUE_MASK];
+	link->rxTail = tail + 1U;
+
+	return packet;
+}
+
+bool CobsFrame_IsTxIdle(uartXferPort_t port)
+{
+	cobsFrameLink_t *link = &s_links[port];
+
+	return (link->txPacket == NULL) && (link->txHead == link->txTail);
+}
+
+void CobsFrame_GetStats(uartXferPort_t port, cobsFrameStats_t *stats)
+{
+	uint32_t primask = DisableGlobalIRQ();
+
+	*stats = s_links[port].stats;
+	EnableGlobalIRQ(primask);
+}
+
+/**
+ * @brief Stores one decoded byte, checking the buffer size.
+ *
+ */
+static inline void RxAppend(cobsFrameLink_t *link, uint8_t data)
+{
+	if(link->rxLength >= COBS_FRAME_BUFFER_SIZE)
+	{
+		link->rxState = kCobsFrame_RxBad;
+		return;
+	}
+	link->rxPacket->data[link->rxLength++] = data;
+	link->rxCrc = Crc16Update(link->rxCrc, data);
+}
+
+/**
+ * @brief Ends the frame at the delimiter: queues it or counts the error.
+ *
+ */
+static void RxEndFrame(uartXferPort_t port, cobsFrameLink_t *link)
+{
+	switch(link->rxState)
+	{
+	case kCobsFrame_RxIdle:
+		/* Empty frame, i.e. repeated delimiters: ignored. */
+		break;
+	case kCobsFrame_RxDropped:
+		link->stats.droppedFrames++;
+		break;
+	case kCobsFrame_RxBad:
+		link->stats.badFrames++;
+		break;
+	default:
+		if((link->rxRemaining != 0U) || (link->rxLength < COBS_FRAME_CRC_SIZE))
+		{
+			/* Delimiter in the middle of a block, or no room for the CRC. */
+			link->stats.badFrames++;
+		}
+		else if(link->rxCrc != 0U)
+		{
+			/* The CRC of the data followed by its own CRC is zero. */
+			link->stats.crcErrors++;
+		}
+		else
+		{
+			link->rxPacket->length = link->rxLength - COBS_FRAME_CRC_SIZE;
+			link->rxQueue[link->rxHead & COBS_FRAME_QUEUE_MASK] = link->rxPacket;
+			link->rxHead++;
+			link->rxPacket = NULL;
+			link->stats.rxFrames++;
+			if(link->callback != NULL)
+			{
+				link->callback(port, link->userData);
+			}
+		}
+		break;
+	}
+
+	/* A discarded frame buffer is kept for the next frame. */
+	link->rxState = kCobsFrame_RxIdle;
+}
+
+static void RxHook(uartXferPort_t port, uint8_t data, bool error, void *userData)
+{
+	cobsFrameLink_t *link = (cobsFrameLink_t *)userData;
+
+	if(data == COBS_FRAME_DELIMITER)
+	{
+		RxEndFrame(port, link);
+		return;
+	}
+
+	if(link->rxState == kCobsFrame_RxIdle)
+	{
+		/* First byte of a frame. */
+		if(link->rxPacket == NULL)
+		{
+			link->rxPacket = CobsFrame_Alloc();
+		}
+		link->rxLength = 0U;
+		link->rxCrc = 0xFFFFU;
+		link->rxCode = 0U;
+		link->rxRemaining = 0U;
+		link->rxState = (link->rxPacket != NULL) ? kCobsFrame_RxActive : kCobsFrame_RxDropped;
+	}
+
+	if(error && (link->rxState == kCobsFrame_RxActive))
+	{
+		link->rxState = kCobsFrame_RxBad;
+	}
+
+	if(link->rxState != kCobsFrame_RxActive)
+	{
+		return;
+	}
+
+	if(link->rxRemaining == 0U)
+	{
+		/* Code byte. The previous block was ended by a zero, unless it
+		 * was the first one or a maximum length block. */
+		if((link->rxCode != 0U) && (link->rxCode != COBS_FRAME_MAX_CODE))
+		{
+			RxAppend(link, 0U);
+		}
+		link->rxCode = data;
+		link->rxRemaining = data - 1U;
+	}
+	else
+	{
+		RxAppend(link, data);
+		link->rxRemaining--;
+	}
+}
+
+static bool TxSource(uartXferPort_t port, uint8_t *data, void *userData)
+{
+	cobsFrameLink_t *link = (cobsFrameLink_t *)userData;
+	cobsFramePacket_t *packet = link->txPacket;
+	uint16_t end;
+
+	(void)port;
+
+	if(packet == NULL)
+	{
+		uint8_t tail = link->txTail;
+
+		if(tail == link->txHead)
+		{
+			return false;
+		}
+		packet = link->txQueue[tail & COBS_FRAME_QUEUE_MASK];
+		link->txTail = tail + 1U;
+		link->txPacket = packet;
+		link->txLength = packet->length + COBS_FRAME_CRC_SIZE;
+		link->txIndex = 0U;
+		link->txBlockEnd = 0U;
+		link->txCode = 0U;
+	}
+
+	if(link->txIndex < link->txBlockEnd)
+	{
+		*data = packet->data[link->txIndex++];
+		return true;
+	}
+
+	/* End of a block. */
+	if((link->txCode != 0U) && (link->txCode != COBS_FRAME_MAX_CODE))
+	{
+		if(link->txIndex == link->txLength)
+		{
+			/* The zero was the implicit one: end of frame. */
+			*data = COBS_FRAME_DELIMITER;
+			link->txPacket = NULL;
+			link->stats.txFrames++;
+			CobsFrame_Free(packet);
+			return true;
+		}
+		link->txIndex++; /* Skips the zero that ended the block. */
+	}
+
+	/* Start of a block: looks for its end, up to 254 bytes ahead. */
+	end = link->txIndex;
+	while((end < link->txLength) && (packet->data[end] != 0U) && ((uint16_t)(end - link->txIndex) < (COBS_FRAME_MAX_CODE - 1U)))
+	{
+		end++;
+	}
+	link->txBlockEnd = end;
+	link->txCode = (uint8_t)(end - link->txIndex + 1U);
+	*data = link->txCode;
+
+	return true;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file	cobs_frame.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A binary packet framing layer over the uart_xfer engine, using the
+ * Consistent Overhead Byte Stuffing (COBS).
+ *
+ * On the line, each frame is COBS(payload + CRC) followed by a 0x00
+ * delimiter. COBS removes all the zeros from the data, so a receiver
+ * that lost synchronization (noise, reset in the middle of a frame)
+ * recovers in the next delimiter. The CRC is the CRC-16/CCITT-FALSE of
+ * the payload, sent most significant byte first.
+ *
+ * Reception: the uart_xfer RX hook decodes each byte in the ISR, straight
+ * into a packet buffer taken from a pool, so there is no intermediate
+ * copy. The CRC is also updated byte by byte. Complete frames are queued
+ * and got with CobsFrame_Receive().
+ *
+ * Transmission: the application takes a packet from the pool, writes the
+ * payload and queues it with CobsFrame_Send(). The uart_xfer TX source
+ * encodes the packet on the fly, one byte per TX interrupt.
+ *
+ * The pool is shared by all the ports and by both directions.
+ *
+ */
+
+#ifndef COBS_FRAME_H_
+#define COBS_FRAME_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "uart_xfer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup cobs_frame
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Maximum payload of one packet, in bytes (up to 65533).*/
+#ifndef COBS_FRAME_MAX_PAYLOAD
+#define COBS_FRAME_MAX_PAYLOAD 64U
+#endif
+
+/*!< Number of packets in the pool (power of two, up to 128).*/
+#ifndef COBS_FRAME_POOL_SIZE
+#define COBS_FRAME_POOL_SIZE 8U
+#endif
+
+/*!< CRC bytes appended to the payload.*/
+#define COBS_FRAME_CRC_SIZE 2U
+
+/*!< Frame delimiter.*/
+#define COBS_FRAME_DELIMITER 0x00U
+
+/*!< Maximum frame size on the line: one overhead byte each 254 bytes,
+ *   plus the code byte and the delimiter.*/
+#define COBS_FRAME_MAX_ENCODED_SIZE \
+	(COBS_FRAME_MAX_PAYLOAD + COBS_FRAME_CRC_SIZE + ((COBS_FRAME_MAX_PAYLOAD + COBS_FRAME_CRC_SIZE) / 254U) + 2U)
+
+/*!
+ * @brief A packet buffer.
+ *
+ * The CRC is stored after the payload, so there is room for it in data.
+ */
+typedef struct{
+	uint16_t length; /*!< Payload length.*/
+	uint8_t data[COBS_FRAME_MAX_PAYLOAD + COBS_FRAME_CRC_SIZE]; /*!< Payload.*/
+}cobsFramePacket_t;
+
+/*!< Frame received callback, called in interrupt context.*/
+typedef void (*cobsFrameCallback_t)(uartXferPort_t port, void *userData);
+
+/*!
+ * @brief Configuration structure.
+ */
+typedef struct{
+	cobsFrameCallback_t callback; /*!< Frame received callback, can be NULL.*/
+	void *userData;               /*!< Parameter passed to the callback.*/
+}cobsFrameConfig_t;
+
+/*!< Per port counters.*/
+typedef struct{
+	uint32_t rxFrames;      /*!< Good frames received.*/
+	uint32_t txFrames;      /*!< Frames sent.*/
+	uint32_t crcErrors;     /*!< Frames discarded by a wrong CRC.*/
+	uint32_t badFrames;     /*!< Frames discarded by bad encoding, size or UART errors.*/
+	uint32_t droppedFrames; /*!< Frames discarded because the pool was empty.*/
+}cobsFrameStats_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Starts the framing layer in a previously initialized port.
+ *
+ *        Calls UartXfer_Init() with the COBS RX hook and TX source, so
+ *        the port must not be used through the uart_xfer rings.
+ *
+ * @param port   - the serial port.
+ * @param config - the configuration.
+ *
+ * @return kStatus_Success if started;
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t CobsFrame_Init(uartXferPort_t port, const cobsFrameConfig_t *config);
+
+/**
+ * @brief Takes a packet from the pool.
+ *
+ * @return The packet, or NULL if the pool is empty.
+ *
+ */
+cobsFramePacket_t *CobsFrame_Alloc(void);
+
+/**
+ * @brief Returns a packet to the pool.
+ *
+ * @param packet - a packet got from CobsFrame_Alloc() or CobsFrame_Receive().
+ *
+ */
+void CobsFrame_Free(cobsFramePacket_t *packet);
+
+/**
+ * @brief Queues a packet to be sent, without blocking.
+ *
+ *        The CRC is appended and the packet is returned to the pool
+ *        after being sent, so it must not be used anymore.
+ *
+ * @param port   - the serial port.
+ * @param packet - a packet got from CobsFrame_Alloc(), with the payload
+ *                 and its length.
+ *
+ * @return kStatus_Success if queued;
+ *         kStatus_InvalidArgument if the length is invalid (the packet
+ *         is still owned by the caller).
+ *
+ */
+status_t CobsFrame_Send(uartXferPort_t port, cobsFramePacket_t *packet);
+
+/**
+ * @brief Gets the next received packet, without blocking.
+ *
+ * @param port - the serial port.
+ *
+ * @return The packet, that must be released with CobsFrame_Free()
+ *         (or sent back with CobsFrame_Send()), or NULL if there is none.
+ *
+ */
+cobsFramePacket_t *CobsFrame_Receive(uartXferPort_t port);
+
+/**
+ * @brief Tests if all the queued packets were sent.
+ *
+ * @param port - the serial port.
+ *
+ * @return true if there is no packet being sent.
+ *
+ */
+bool CobsFrame_IsTxIdle(uartXferPort_t port);
+
+/**
+ * @brief Copies the port counters.
+ *
+ * @param port  - the serial port.
+ * @param stats - where the counters will be copied.
+ *
+ */
+void CobsFrame_GetStats(uartXferPort_t port, cobsFrameStats_t *stats);
+
+/**
+ * @brief Computes the CRC-16/CCITT-FALSE (polynomial 0x1021, initial
+ *        value 0xFFFF) of a buffer.
+ *
+ * @param crc    - the initial value, or the result of a previous call.
+ * @param data   - the data.
+ * @param length - the data size in bytes.
+ *
+ * @return The updated CRC.
+ *
+ */
+uint16_t CobsFrame_Crc16(uint16_t crc, const uint8_t *data, size_t length);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* COBS_FRAME_H_ */
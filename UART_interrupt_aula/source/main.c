@@ -30,6 +30,7 @@
 
 #include "board.h"
 #include "fsl_uart.h"
+#include "uart_xfer.h"
 
 #include "pin_mux.h"
 #include "clock_config.h"
@@ -38,16 +39,14 @@
  ******************************************************************************/
 /* UART instance and clock */
 #define DEMO_UART UART1
+#define DEMO_UART_PORT kUartXfer_Uart1
 #define DEMO_UART_CLKSRC BUS_CLK
 #define DEMO_UART_CLK_FREQ CLOCK_GetFreq(BUS_CLK)
-#define DEMO_UART_IRQn UART1_IRQn
 #define DEMO_UART_IRQHandler UART1_IRQHandler
 
-/*! @brief Ring buffer size (Unit: Byte). */
+/*! @brief Ring buffers size (Unit: Byte), must be a power of two. */
 #define DEMO_RING_BUFFER_SIZE 16
 
-/*! @brief Ring buffer to save received data. */
-
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -60,15 +59,14 @@ uint8_t g_tipString[] =
     "Uart functional API interrupt example\r\nBoard receives characters then sends them out\r\nNow please input:\r\n";
 
 /*
-  Ring buffer for data input and output, in this example, input data are saved
-  to ring buffer in IRQ handler. The main function polls the ring buffer status,
-  if there are new data, then send them out.
-  Ring buffer full: (((rxIndex + 1) % DEMO_RING_BUFFER_SIZE) == txIndex)
-  Ring buffer empty: (rxIndex == txIndex)
+  Ring buffers for data input and output. Both are handled by the uart_xfer
+  engine: received data is saved to the RX ring in the IRQ handler, and the
+  TX ring is drained by the TX data register empty interrupt, which is only
+  enabled while there is data to send. So the main loop only moves data from
+  one ring to the other and sleeps while there is nothing to do.
 */
-uint8_t demoRingBuffer[DEMO_RING_BUFFER_SIZE];
-volatile uint16_t txIndex; /* Index of the data to send out. */
-volatile uint16_t rxIndex; /* Index of the memory to save new arrived data. */
+uint8_t demoRxRingBuffer[DEMO_RING_BUFFER_SIZE];
+uint8_t demoTxRingBuffer[DEMO_RING_BUFFER_SIZE];
 
 /*******************************************************************************
  * Code
@@ -76,21 +74,7 @@ volatile uint16_t rxIndex; /* Index of the memory to save new arrived data. */
 
 void DEMO_UART_IRQHandler(void)
 {
-    uint8_t data;
-
-    /* If new data arrived. */
-    if ((kUART_RxDataRegFullFlag | kUART_RxOverrunFlag) & UART_GetStatusFlags(DEMO_UART))
-    {
-        data = UART_ReadByte(DEMO_UART);
-
-        /* If ring buffer is not full, add data to ring buffer. */
-        if (((rxIndex + 1) % DEMO_RING_BUFFER_SIZE) != txIndex)
-        {
-            demoRingBuffer[rxIndex] = data;
-            rxIndex++;
-            rxIndex %= DEMO_RING_BUFFER_SIZE;
-        }
-    }
+    UartXfer_IRQHandler(DEMO_UART_PORT);
 }
 
 /*!
@@ -99,6 +83,10 @@ void DEMO_UART_IRQHandler(void)
 int main(void)
 {
     uart_config_t config;
+    uartXferConfig_t xferConfig;
+    uint8_t data[DEMO_RING_BUFFER_SIZE];
+    size_t count;
+    uint32_t primask;
 
     BOARD_InitPins();
     BOARD_BootClockRUN();
@@ -122,18 +110,33 @@ int main(void)
     /* Send g_tipString out. */
     UART_WriteBlocking(DEMO_UART, g_tipString, sizeof(g_tipString) / sizeof(g_tipString[0]));
 
-    /* Enable RX interrupt. */
-    UART_EnableInterrupts(DEMO_UART, kUART_RxDataRegFullInterruptEnable | kUART_RxOverrunInterruptEnable);
-    EnableIRQ(DEMO_UART_IRQn);
+    /* Start the interrupt driven engine: RX, idle line and error interrupts. */
+    xferConfig.rxBuffer = demoRxRingBuffer;
+    xferConfig.rxBufferSize = DEMO_RING_BUFFER_SIZE;
+    xferConfig.txBuffer = demoTxRingBuffer;
+    xferConfig.txBufferSize = DEMO_RING_BUFFER_SIZE;
+    xferConfig.enableIdleLine = true;
+    xferConfig.callback = NULL;
+    xferConfig.rxHook = NULL;
+    xferConfig.txSource = NULL;
+    xferConfig.userData = NULL;
+    UartXfer_Init(DEMO_UART_PORT, &xferConfig);
 
     while (1)
     {
-        /* Send data only when UART TX register is empty and ring buffer has data to send out. */
-        while ((kUART_TxDataRegEmptyFlag & UART_GetStatusFlags(DEMO_UART)) && (rxIndex != txIndex))
+        /* Echo only what fits in the TX ring, the rest stays in the RX ring. */
+        count = UartXfer_GetTxFree(DEMO_UART_PORT);
+        count = UartXfer_Read(DEMO_UART_PORT, data, count);
+        UartXfer_Write(DEMO_UART_PORT, data, count);
+
+        /* Sleep until the next interrupt. The check is done with the interrupts
+           masked: a pending interrupt still wakes up the WFI, so no byte arrived
+           between the check and the WFI is missed. */
+        primask = DisableGlobalIRQ();
+        if ((UartXfer_GetRxCount(DEMO_UART_PORT) == 0U) || (UartXfer_GetTxFree(DEMO_UART_PORT) == 0U))
         {
-            UART_WriteByte(DEMO_UART, demoRingBuffer[txIndex]);
-            txIndex++;
-            txIndex %= DEMO_RING_BUFFER_SIZE;
+            __WFI();
         }
+        EnableGlobalIRQ(primask);
     }
 }
@@ -0,0 +1,695 @@
+/**
+ * @file	modbus_rtu.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A Modbus RTU slave over the uart_xfer engine, with the silent
+ * intervals measured by a TPM.
+ *
+ */
+
+#include "modbus_rtu.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define MODBUS_RTU_CHAR_BITS 11U          /*!< Start + 8 data + parity/stop + stop.*/
+#define MODBUS_RTU_FIXED_BAUD 19200U      /*!< Above it the intervals are fixed.*/
+#define MODBUS_RTU_FIXED_T15_US 750U
+#define MODBUS_RTU_FIXED_T35_US 1750U
+#define MODBUS_RTU_MIN_FRAME 4U           /*!< Address + function + CRC.*/
+#define MODBUS_RTU_MAX_READ 125U          /*!< Registers per read request.*/
+#define MODBUS_RTU_MAX_WRITE 123U         /*!< Registers per write request.*/
+#define MODBUS_RTU_MAX_SLAVE_ADDRESS 247U
+#define MODBUS_RTU_TPM_MAX_TICKS 0x10000U
+
+/*!< Function codes.*/
+#define MODBUS_RTU_FC_READ_HOLDING 0x03U
+#define MODBUS_RTU_FC_READ_INPUT 0x04U
+#define MODBUS_RTU_FC_WRITE_SINGLE 0x06U
+#define MODBUS_RTU_FC_WRITE_MULTIPLE 0x10U
+#define MODBUS_RTU_EXCEPTION_FLAG 0x80U
+
+/*!< Exception codes.*/
+#define MODBUS_RTU_EX_NONE 0x00U
+#define MODBUS_RTU_EX_ILLEGAL_FUNCTION 0x01U
+#define MODBUS_RTU_EX_ILLEGAL_ADDRESS 0x02U
+#define MODBUS_RTU_EX_ILLEGAL_VALUE 0x03U
+
+/*!< Slave states.*/
+typedef enum{
+	kModbusRtu_StateInit = 0U, /*!< Waiting t3.5 of silence before accepting frames.*/
+	kModbusRtu_StateIdle,      /*!< Waiting the first byte of a frame.*/
+	kModbusRtu_StateReception, /*!< Receiving a frame.*/
+	kModbusRtu_StateTransmit,  /*!< Sending the response, RX bytes ignored.*/
+	kModbusRtu_StateDrain,     /*!< Last byte in the UART, waiting t1.5 to release the bus.*/
+}modbusRtuState_t;
+
+/*!< Register access done by AccessRegisters().*/
+typedef enum{
+	kModbusRtu_AccessCheck = 0U,
+	kModbusRtu_AccessRead,
+	kModbusRtu_AccessWrite,
+}modbusRtuAccess_t;
+
+/*!< Slave runtime data.*/
+typedef struct{
+	uartXferPort_t port;
+	TPM_Type *timer;
+	modbusRtuConfig_t config;
+	volatile modbusRtuState_t state;
+	bool frameBad;       /*!< t1.5 gap, overflow or UART error in this frame.*/
+	bool charGap;        /*!< t1.5 elapsed since the last byte.*/
+	uint16_t rxLength;
+	uint16_t rxCrc;
+	uint16_t txLength;
+	uint16_t txIndex;
+	uint8_t rxFrame[MODBUS_RTU_MAX_FRAME];
+	uint8_t txFrame[MODBUS_RTU_MAX_FRAME];
+	modbusRtuStats_t stats;
+}modbusRtuSlave_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief uart_xfer RX hook: stores one byte and restarts the timer.
+ *
+ */
+static void RxHook(uartXferPort_t port, uint8_t data, bool error, void *userData);
+
+/**
+ * @brief uart_xfer TX source: gives the next response byte.
+ *
+ */
+static bool TxSource(uartXferPort_t port, uint8_t *data, void *userData);
+
+/**
+ * @brief Checks, answers and sends the received frame.
+ *
+ */
+static void ProcessFrame(modbusRtuSlave_t *slave);
+
+/**
+ * @brief Restarts the silent interval measurement.
+ *
+ */
+static inline void RestartTimer(TPM_Type *base)
+{
+	base->CNT = 0U; /* Any write clears the counter. */
+	base->STATUS = TPM_STATUS_CH0F_MASK | TPM_STATUS_TOF_MASK;
+	base->SC |= TPM_SC_CMOD(kTPM_SystemClock);
+}
+
+/**
+ * @brief Reads a big endian 16 bits value.
+ *
+ */
+static inline uint16_t GetU16(const uint8_t *p)
+{
+	return (uint16_t)((p[0] << 8U) | p[1]);
+}
+
+/**
+ * @brief Writes a big endian 16 bits value.
+ *
+ */
+static inline void PutU16(uint8_t *p, uint16_t value)
+{
+	p[0] = (uint8_t)(value >> 8U);
+	p[1] = (uint8_t)value;
+}
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static modbusRtuSlave_t s_slave;
+
+static TPM_Type *const s_tpmBases[] = TPM_BASE_PTRS;
+static const IRQn_Type s_tpmIrqs[] = TPM_IRQS;
+
+/*!< CRC of each byte value, for the reflected polynomial 0xA001.*/
+static const uint16_t s_crcTable[256] = {
+	0x0000U, 0xC0C1U, 0xC181U, 0x0140U, 0xC301U, 0x03C0U, 0x0280U, 0xC241U,
+	0xC601U, 0x06C0U, 0x0780U, 0xC741U, 0x0500U, 0xC5C1U, 0xC481U, 0x0440U,
+	0xCC01U, 0x0CC0U, 0x0D80U, 0xCD41U, 0x0F00U, 0xCFC1U, 0xCE81U, 0x0E40U,
+	0x0A00U, 0xCAC1U, 0xCB81U, 0x0B40U, 0xC901U, 0x09C0U, 0x0880U, 0xC841U,
+	0xD801U, 0x18C0U, 0x1980U, 0xD941U, 0x1B00U, 0xDBC1U, 0xDA81U, 0x1A40U,
+	0x1E00U, 0xDEC1U, 0xDF81U, 0x1F40U, 0xDD01U, 0x1DC0U, 0x1C80U, 0xDC41U,
+	0x1400U, 0xD4C1U, 0xD581U, 0x1540U, 0xD701U, 0x17C0U, 0x1680U, 0xD641U,
+	0xD201U, 0x12C0U, 0x1380U, 0xD341U, 0x1100U, 0xD1C1U, 0xD081U, 0x1040U,
+	0xF001U, 0x30C0U, 0x3180U, 0xF141U, 0x3300U, 0xF3C1U, 0xF281U, 0x3240U,
+	0x3600U, 0xF6C1U, 0xF781U, 0x3740U, 0xF501U, 0x35C0U, 0x3480U, 0xF441U,
+	0x3C00U, 0xFCC1U, 0xFD81U, 0x3D40U, 0xFF01U, 0x3FC0U, 0x3E80U, 0xFE41U,
+	0xFA01U, 0x3AC0U, 0x3B80U, 0xFB41U, 0x3900U, 0xF9C1U, 0xF881U, 0x3840U,
+	0x2800U, 0xE8C1U, 0xE981U, 0x2940U, 0xEB01U, 0x2BC0U, 0x2A80U, 0xEA41U,
+	0xEE01U, 0x2EC0U, 0x2F80U, 0xEF41U, 0x2D00U, 0xEDC1U, 0xEC81U, 0x2C40U,
+	0xE401U, 0x24C0U, 0x2580U, 0xE541U, 0x2700U, 0xE7C1U, 0xE681U, 0x2640U,
+	0x2200U, 0xE2C1U, 0xE381U, 0x2340U, 0xE101U, 0x21C0U, 0x2080U, 0xE041U,
+	0xA001U, 0x60C0U, 0x6180U, 0xA141U, 0x6300U, 0xA3C1U, 0xA281U, 0x6240U,
+	0x6600U, 0xA6C1U, 0xA781U, 0x6740U, 0xA501U, 0x65C0U, 0x6480U, 0xA441U,
+	0x6C00U, 0xACC1U, 0xAD81U, 0x6D40U, 0xAF01U, 0x6FC0U, 0x6E80U, 0xAE41U,
+	0xAA01U, 0x6AC0U, 0x6B80U, 0xAB41U, 0x6900U, 0xA9C1U, 0xA881U, 0x6840U,
+	0x7800U, 0xB8C1U, 0xB981U, 0x7940U, 0xBB01U, 0x7BC0U, 0x7A80U, 0xBA41U,
+	0xBE01U, 0x7EC0U, 0x7F80U, 0xBF41U, 0x7D00U, 0xBDC1U, 0xBC81U, 0x7C40U,
+	0xB401U, 0x74C0U, 0x7580U, 0xB541U, 0x7700U, 0xB7C1U, 0xB681U, 0x7640U,
+	0x7200U, 0xB2C1U, 0xB381U, 0x7340U, 0xB101U, 0x71C0U, 0x7080U, 0xB041U,
+	0x5000U, 0x90C1U, 0x9181U, 0x5140U, 0x9301U, 0x53C0U, 0x5280U, 0x9241U,
+	0x9601U, 0x56C0U, 0x5780U, 0x9741U, 0x5500U, 0x95C1U, 0x9481U, 0x5440U,
+	0x9C01U, 0x5CC0U, 0x5D80U, 0x9D41U, 0x5F00U, 0x9FC1U, 0x9E81U, 0x5E40U,
+	0x5A00U, 0x9AC1U, 0x9B81U, 0x5B40U, 0x9901U, 0x59C0U, 0x5880U, 0x9841U,
+	0x8801U, 0x48C0U, 0x4980U, 0x8941U, 0x4B00U, 0x8BC1U, 0x8A81U, 0x4A40U,
+	0x4E00U, 0x8EC1U, 0x8F81U, 0x4F40U, 0x8D01U, 0x4DC0U, 0x4C80U, 0x8C41U,
+	0x4400U, 0x84C1U, 0x8581U, 0x4540U, 0x8701U, 0x47C0U, 0x4680U, 0x8641U,
+	0x8201U, 0x42C0U, 0x4380U, 0x8341U, 0x4100U, 0x81C1U, 0x8081U, 0x4040U,
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static inline uint16_t Crc16Update(uint16_t crc, uint8_t data)
+{
+	return (crc >> 8U) ^ s_crcTable[(crc ^ data) & 0xFFU];
+}
+
+uint16_t ModbusRtu_Crc16(uint16_t crc, const uint8_t *data, size_t length)
+{
+	while(length--)
+	{
+		crc = Crc16Update(crc, *data++);
+	}
+
+	return crc;
+}
+
+/**
+ * @brief Tests if a register table is sorted and without overlaps.
+ *
+ */
+static bool IsTableValid(const modbusRtuBlock_t *table, uint16_t count)
+{
+	uint16_t i;
+
+	if((table == NULL) && (count != 0U))
+	{
+		return false;
+	}
+
+	for(i = 0U; i < count; i++)
+	{
+		if((table[i].values == NULL) || (table[i].count == 0U) ||
+		   (((uint32_t)table[i].address + table[i].count) > 0x10000U))
+		{
+			return false;
+		}
+		if((i != 0U) && (table[i].address < ((uint32_t)table[i - 1U].address + table[i - 1U].count)))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Converts microseconds to timer ticks, rounding up.
+ *
+ */
+static uint32_t UsToTicks(uint32_t us, uint32_t clock_Hz)
+{
+	return (uint32_t)(((uint64_t)us * clock_Hz + 999999U) / 1000000U);
+}
+
+status_t ModbusRtu_Init(uartXferPort_t port, const modbusRtuConfig_t *config)
+{
+	uartXferConfig_t xferConfig;
+	tpm_config_t tpmConfig;
+	uint32_t t15_us, t35_us, t15, t35, instance;
+	uint8_t prescale;
+
+	if((config == NULL) || (config->timer == NULL) ||
+	   (config->address == MODBUS_RTU_BROADCAST_ADDRESS) || (config->address > MODBUS_RTU_MAX_SLAVE_ADDRESS) ||
+	   (config->baudRate_Bps == 0U) || (config->timerClock_Hz == 0U) ||
+	   ((config->deGpio != NULL) && (config->dePinMask == 0U)) ||
+	   !IsTableValid(config->holding, config->holdingCount) || !IsTableValid(config->input, config->inputCount))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	for(instance = 0U; instance < ARRAY_SIZE(s_tpmBases); instance++)
+	{
+		if(s_tpmBases[instance] == config->timer)
+		{
+			break;
+		}
+	}
+	if(instance == ARRAY_SIZE(s_tpmBases))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	if(config->baudRate_Bps > MODBUS_RTU_FIXED_BAUD)
+	{
+		t15_us = MODBUS_RTU_FIXED_T15_US;
+		t35_us = MODBUS_RTU_FIXED_T35_US;
+	}
+	else
+	{
+		t15_us = (uint32_t)((15000000ULL * MODBUS_RTU_CHAR_BITS) / (10U * config->baudRate_Bps));
+		t35_us = (uint32_t)((35000000ULL * MODBUS_RTU_CHAR_BITS) / (10U * config->baudRate_Bps));
+	}
+
+	/* Smallest prescaler that fits t3.5 in the 16 bits counter, for the best resolution. */
+	for(prescale = kTPM_Prescale_Divide_1; prescale <= kTPM_Prescale_Divide_128; prescale++)
+	{
+		t35 = UsToTicks(t35_us, config->timerClock_Hz >> prescale);
+		if(t35 <= MODBUS_RTU_TPM_MAX_TICKS)
+		{
+			break;
+		}
+	}
+	if(prescale > kTPM_Prescale_Divide_128)
+	{
+		return kStatus_InvalidArgument;
+	}
+	t15 = UsToTicks(t15_us, config->timerClock_Hz >> prescale);
+
+	DisableIRQ(s_tpmIrqs[instance]);
+
+	memset(&s_slave, 0, sizeof(s_slave));
+	s_slave.port = port;
+	s_slave.timer = config->timer;
+	s_slave.config = *config;
+	s_slave.state = kModbusRtu_StateInit;
+	if(config->deGpio != NULL)
+	{
+		GPIO_ClearPinsOutput(config->deGpio, config->dePinMask);
+	}
+
+	TPM_GetDefaultConfig(&tpmConfig);
+	tpmConfig.prescale = (tpm_clock_prescale_t)prescale;
+	TPM_Init(config->timer, &tpmConfig);
+	/* The overflow happens MOD + 1 ticks after the restart. */
+	TPM_SetTimerPeriod(config->timer, t35 - 1U);
+	TPM_SetupOutputCompare(config->timer, kTPM_Chnl_0, kTPM_NoOutputSignal, t15);
+	TPM_EnableInterrupts(config->timer, kTPM_Chnl0InterruptEnable | kTPM_TimeOverflowInterruptEnable);
+	EnableIRQ(s_tpmIrqs[instance]);
+
+	xferConfig.rxBuffer = NULL;
+	xferConfig.rxBufferSize = 0U;
+	xferConfig.txBuffer = NULL;
+	xferConfig.txBufferSize = 0U;
+	xferConfig.enableIdleLine = false;
+	xferConfig.callback = NULL;
+	xferConfig.rxHook = RxHook;
+	xferConfig.txSource = TxSource;
+	xferConfig.userData = &s_slave;
+
+	/* The first frame is accepted after t3.5 of silence. */
+	RestartTimer(config->timer);
+
+	return UartXfer_Init(port, &xferConfig);
+}
+
+void ModbusRtu_GetStats(modbusRtuStats_t *stats)
+{
+	uint32_t primask = DisableGlobalIRQ();
+
+	*stats = s_slave.stats;
+	EnableGlobalIRQ(primask);
+}
+
+static void RxHook(uartXferPort_t port, uint8_t data, bool error, void *userData)
+{
+	modbusRtuSlave_t *slave = (modbusRtuSlave_t *)userData;
+
+	(void)port;
+
+	switch(slave->state)
+	{
+	case kModbusRtu_StateTransmit:
+	case kModbusRtu_StateDrain:
+		/* Own echo in a half duplex bus, or a master error: ignored. */
+		return;
+	case kModbusRtu_StateIdle:
+		slave->state = kModbusRtu_StateReception;
+		slave->frameBad = false;
+		slave->rxLength = 0U;
+		slave->rxCrc = 0xFFFFU;
+		break;
+	case kModbusRtu_StateReception:
+		if(slave->charGap)
+		{
+			/* Silence longer than t1.5 inside the frame. */
+			slave->frameBad = true;
+		}
+		break;
+	default:
+		/* Init: the t3.5 wait starts again. */
+		break;
+	}
+
+	RestartTimer(slave->timer);
+	slave->charGap = false;
+
+	if(slave->state != kModbusRtu_StateReception)
+	{
+		return;
+	}
+
+	if(error || (slave->rxLength >= MODBUS_RTU_MAX_FRAME))
+	{
+		slave->frameBad = true;
+		return;
+	}
+	slave->rxFrame[slave->rxLength++] = data;
+	slave->rxCrc = Crc16Update(slave->rxCrc, data);
+}
+
+static bool TxSource(uartXferPort_t port, uint8_t *data, void *userData)
+{
+	modbusRtuSlave_t *slave = (modbusRtuSlave_t *)userData;
+
+	(void)port;
+
+	if((slave->state != kModbusRtu_StateTransmit) || (slave->txIndex >= slave->txLength))
+	{
+		if(slave->state == kModbusRtu_StateTransmit)
+		{
+			/* The last byte is still being shifted out: the driver is
+			 * released at t1.5 from now, and t3.5 covers the silence
+			 * required after the response. */
+			slave->stats.txFrames++;
+			slave->state = kModbusRtu_StateDrain;
+			RestartTimer(slave->timer);
+		}
+		return false;
+	}
+
+	*data = slave->txFrame[slave->txIndex++];
+
+	return true;
+}
+
+void ModbusRtu_TimerIRQHandler(void)
+{
+	TPM_Type *base = s_slave.timer;
+	uint32_t status = base->STATUS;
+
+	if(status & TPM_STATUS_CH0F_MASK)
+	{
+		base->STATUS = TPM_STATUS_CH0F_MASK;
+		s_slave.charGap = true;
+
+		if(s_slave.state == kModbusRtu_StateDrain)
+		{
+			/* The stop bit of the last byte has left: releases the bus. */
+			if(s_slave.config.deGpio != NULL)
+			{
+				GPIO_ClearPinsOutput(s_slave.config.deGpio, s_slave.config.dePinMask);
+			}
+			s_slave.state = kModbusRtu_StateInit;
+		}
+	}
+
+	if(status & TPM_STATUS_TOF_MASK)
+	{
+		/* t3.5 of silence: the timer waits for the next byte. */
+		base->SC &= ~TPM_SC_CMOD_MASK;
+		base->STATUS = TPM_STATUS_TOF_MASK | TPM_STATUS_CH0F_MASK;
+
+		if(s_slave.state == kModbusRtu_StateReception)
+		{
+			ProcessFrame(&s_slave);
+		}
+		else if(s_slave.state == kModbusRtu_StateInit)
+		{
+			s_slave.state = kModbusRtu_StateIdle;
+		}
+	}
+}
+
+/**
+ * @brief Finds the block holding an address, with a binary search.
+ *
+ * @return The block index, or -1 if the address is not mapped.
+ *
+ */
+static int32_t FindBlock(const modbusRtuBlock_t *table, uint16_t count, uint16_t address)
+{
+	int32_t low = 0;
+	int32_t high = (int32_t)count - 1;
+	int32_t middle;
+
+	while(low <= high)
+	{
+		middle = (low + high) / 2;
+		if(address < table[middle].address)
+		{
+			high = middle - 1;
+		}
+		else if(address >= ((uint32_t)table[middle].address + table[middle].count))
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			return middle;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Checks, reads or writes a range of registers, that can span
+ *        consecutive blocks. The data is big endian.
+ *
+ * @return MODBUS_RTU_EX_NONE or MODBUS_RTU_EX_ILLEGAL_ADDRESS.
+ *
+ */
+static uint8_t AccessRegisters(const modbusRtuBlock_t *table, uint16_t count, uint16_t address,
+                               uint16_t quantity, uint8_t *data, modbusRtuAccess_t access)
+{
+	int32_t index = FindBlock(table, count, address);
+	uint16_t offset, n, i;
+
+	if(index < 0)
+	{
+		return MODBUS_RTU_EX_ILLEGAL_ADDRESS;
+	}
+
+	while(quantity != 0U)
+	{
+		offset = address - table[index].address;
+		n = table[index].count - offset;
+		if(n > quantity)
+		{
+			n = quantity;
+		}
+
+		for(i = 0U; i < n; i++)
+		{
+			if(access == kModbusRtu_AccessRead)
+			{
+				PutU16(data, table[index].values[offset + i]);
+			}
+			else if(access == kModbusRtu_AccessWrite)
+			{
+				table[index].values[offset + i] = GetU16(data);
+			}
+			data += 2;
+		}
+
+		quantity -= n;
+		address += n;
+		index++;
+		if((quantity != 0U) && ((index >= count) || (table[index].address != address)))
+		{
+			/* The range continues in a hole of the map. */
+			return MODBUS_RTU_EX_ILLEGAL_ADDRESS;
+		}
+	}
+
+	return MODBUS_RTU_EX_NONE;
+}
+
+/**
+ * @brief Executes the request PDU and builds the response PDU.
+ *
+ * @return The exception code, or MODBUS_RTU_EX_NONE.
+ *
+ */
+static uint8_t ExecuteRequest(modbusRtuSlave_t *slave, const uint8_t *request, uint16_t length,
+                              uint8_t *response, uint16_t *responseLength)
+{
+	const modbusRtuConfig_t *config = &slave->config;
+	const modbusRtuBlock_t *table;
+	uint16_t tableCount, address, quantity;
+	uint8_t exception;
+
+	switch(request[0])
+	{
+	case MODBUS_RTU_FC_READ_HOLDING:
+	case MODBUS_RTU_FC_READ_INPUT:
+		if(length != 5U)
+		{
+			return MODBUS_RTU_EX_ILLEGAL_VALUE;
+		}
+		table = (request[0] == MODBUS_RTU_FC_READ_HOLDING) ? config->holding : config->input;
+		tableCount = (request[0] == MODBUS_RTU_FC_READ_HOLDING) ? config->holdingCount : config->inputCount;
+		address = GetU16(&request[1]);
+		quantity = GetU16(&request[3]);
+		if((quantity == 0U) || (quantity > MODBUS_RTU_MAX_READ))
+		{
+			return MODBUS_RTU_EX_ILLEGAL_VALUE;
+		}
+		exception = AccessRegisters(table, tableCount, address, quantity, &response[2], kModbusRtu_AccessRead);
+		if(exception != MODBUS_RTU_EX_NONE)
+		{
+			return exception;
+		}
+		response[1] = (uint8_t)(quantity * 2U);
+		*responseLength = 2U + quantity * 2U;
+		break;
+
+	case MODBUS_RTU_FC_WRITE_SINGLE:
+		if(length != 5U)
+		{
+			return MODBUS_RTU_EX_ILLEGAL_VALUE;
+		}
+		address = GetU16(&request[1]);
+		exception = AccessRegisters(config->holding, config->holdingCount, address, 1U,
+		                            (uint8_t *)&request[3], kModbusRtu_AccessWrite);
+		if(exception != MODBUS_RTU_EX_NONE)
+		{
+			return exception;
+		}
+		if(config->onWrite != NULL)
+		{
+			config->onWrite(address, 1U, config->userData);
+		}
+		/* The response is the request echo. */
+		memcpy(&response[1], &request[1], 4U);
+		*responseLength = 5U;
+		break;
+
+	case MODBUS_RTU_FC_WRITE_MULTIPLE:
+		if(length < 6U)
+		{
+			return MODBUS_RTU_EX_ILLEGAL_VALUE;
+		}
+		address = GetU16(&request[1]);
+		quantity = GetU16(&request[3]);
+		if((quantity == 0U) || (quantity > MODBUS_RTU_MAX_WRITE) ||
+		   (request[5] != quantity * 2U) || (length != 6U + request[5]))
+		{
+			return MODBUS_RTU_EX_ILLEGAL_VALUE;
+		}
+		/* All or nothing: the whole range is checked before writing. */
+		exception = AccessRegisters(config->holding, config->holdingCount, address, quantity,
+		                            NULL, kModbusRtu_AccessCheck);
+		if(exception != MODBUS_RTU_EX_NONE)
+		{
+			return exception;
+		}
+		(void)AccessRegisters(config->holding, config->holdingCount, address, quantity,
+		                      (uint8_t *)&request[6], kModbusRtu_AccessWrite);
+		if(config->onWrite != NULL)
+		{
+			config->onWrite(address, quantity, config->userData);
+		}
+		memcpy(&response[1], &request[1], 4U);
+		*responseLength = 5U;
+		break;
+
+	default:
+		return MODBUS_RTU_EX_ILLEGAL_FUNCTION;
+	}
+
+	return MODBUS_RTU_EX_NONE;
+}
+
+static void ProcessFrame(modbusRtuSlave_t *slave)
+{
+	uint8_t *rx = slave->rxFrame;
+	uint8_t *tx = slave->txFrame;
+	uint16_t pduLength, crc;
+	uint8_t exception;
+
+	slave->state = kModbusRtu_StateIdle;
+
+	if(slave->frameBad || (slave->rxLength < MODBUS_RTU_MIN_FRAME))
+	{
+		slave->stats.badFrames++;
+		return;
+	}
+	if(slave->rxCrc != 0U)
+	{
+		/* The CRC of the frame including its own CRC is zero. */
+		slave->stats.crcErrors++;
+		return;
+	}
+	slave->stats.rxFrames++;
+
+	if((rx[0] != slave->config.address) && (rx[0] != MODBUS_RTU_BROADCAST_ADDRESS))
+	{
+		return;
+	}
+
+	if(rx[0] == MODBUS_RTU_BROADCAST_ADDRESS)
+	{
+		/* Only writes can be broadcast; the rest is dropped silently. */
+		if((rx[1] == MODBUS_RTU_FC_WRITE_SINGLE) || (rx[1] == MODBUS_RTU_FC_WRITE_MULTIPLE))
+		{
+			(void)ExecuteRequest(slave, &rx[1], slave->rxLength - 3U, &tx[1], &pduLength);
+			slave->stats.broadcasts++;
+		}
+		return;
+	}
+
+	/* PDU: function code and data, without address and CRC. */
+	tx[1] = rx[1];
+	exception = ExecuteRequest(slave, &rx[1], slave->rxLength - 3U, &tx[1], &pduLength);
+
+	if(exception != MODBUS_RTU_EX_NONE)
+	{
+		tx[1] = rx[1] | MODBUS_RTU_EXCEPTION_FLAG;
+		tx[2] = exception;
+		pduLength = 2U;
+		slave->stats.exceptions++;
+	}
+
+	tx[0] = slave->config.address;
+	crc = ModbusRtu_Crc16(0xFFFFU, tx, 1U + pduLength);
+	tx[1U + pduLength] = (uint8_t)crc;
+	tx[2U + pduLength] = (uint8_t)(crc >> 8U);
+	slave->txLength = 3U + pduLength;
+	slave->txIndex = 0U;
+	slave->state = kModbusRtu_StateTransmit;
+	if(slave->config.deGpio != NULL)
+	{
+		GPIO_SetPinsOutput(slave->config.deGpio, slave->config.dePinMask);
+	}
+	UartXfer_StartTx(slave->port);
+}
@@ -0,0 +1,188 @@
+/**
+ * @file	modbus_rtu.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A Modbus RTU slave over the uart_xfer engine.
+ *
+ * The frame limits are detected by the silent intervals of the RTU mode,
+ * measured by a TPM instead of polling:
+ *
+ *   - each received byte restarts the TPM counter;
+ *   - the channel 0 compare fires after 1.5 characters of silence: a byte
+ *     received after it and before the end of the frame makes the frame
+ *     invalid;
+ *   - the overflow fires after 3.5 characters of silence: end of frame.
+ *
+ * Above 19200 bps the intervals are fixed in 750 us and 1750 us, as
+ * required by the Modbus serial line specification.
+ *
+ * The CRC is updated in the RX hook for each byte, so at the end of the
+ * frame the request is checked and answered straight in the TPM interrupt,
+ * with a response latency of t3.5 plus a bounded processing time. The
+ * response is sent by the uart_xfer TX source.
+ *
+ * The RS-485 transceiver driver enable (DE, and /RE if tied to it) can be
+ * given as a GPIO pin: it is set just before the response and cleared at
+ * the t1.5 compare after the last byte was handed to the UART, when its
+ * stop bit has already left, so the bus is released for the other nodes.
+ * The pin must be configured as a GPIO output (pin_mux).
+ *
+ * Supported functions: 0x03 Read Holding Registers, 0x04 Read Input
+ * Registers, 0x06 Write Single Register and 0x10 Write Multiple Registers.
+ * The registers are mapped by two tables of register blocks, sorted by
+ * address, that are searched with a binary search. Consecutive blocks
+ * can be accessed by the same request.
+ *
+ * The application must call UartXfer_IRQHandler() from the port interrupt
+ * handler and ModbusRtu_TimerIRQHandler() from the TPM interrupt handler.
+ * The TPM clock must be selected before (CLOCK_SetTpmClock()).
+ * Both interrupts must have the same priority (the reset default), so
+ * they do not preempt each other.
+ *
+ */
+
+#ifndef MODBUS_RTU_H_
+#define MODBUS_RTU_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "fsl_tpm.h"
+#include "fsl_gpio.h"
+#include "uart_xfer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup modbus_rtu
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Maximum RTU frame size (address + PDU + CRC).*/
+#define MODBUS_RTU_MAX_FRAME 256U
+
+/*!< Broadcast address: writes (06 and 16) are executed, but not answered;
+ *   other functions are dropped.*/
+#define MODBUS_RTU_BROADCAST_ADDRESS 0U
+
+/*!
+ * @brief A block of consecutive registers.
+ */
+typedef struct{
+	uint16_t address; /*!< Address of the first register.*/
+	uint16_t count;   /*!< Number of registers.*/
+	uint16_t *values; /*!< Register values.*/
+}modbusRtuBlock_t;
+
+/*!< Called in interrupt context after holding registers are written.*/
+typedef void (*modbusRtuWriteCallback_t)(uint16_t address, uint16_t count, void *userData);
+
+/*!
+ * @brief Slave configuration structure.
+ */
+typedef struct{
+	uint8_t address;                   /*!< Slave address, from 1 to 247.*/
+	uint32_t baudRate_Bps;             /*!< Port baud rate, used for the silent intervals.*/
+	TPM_Type *timer;                   /*!< TPM used for the silent intervals.*/
+	uint32_t timerClock_Hz;            /*!< TPM clock frequency.*/
+	const modbusRtuBlock_t *holding;   /*!< Holding registers, sorted by address.*/
+	uint16_t holdingCount;             /*!< Number of holding register blocks.*/
+	const modbusRtuBlock_t *input;     /*!< Input registers, sorted by address.*/
+	uint16_t inputCount;               /*!< Number of input register blocks.*/
+	modbusRtuWriteCallback_t onWrite;  /*!< Write notification, can be NULL.*/
+	void *userData;                    /*!< Parameter passed to onWrite.*/
+	GPIO_Type *deGpio;                 /*!< GPIO of the RS-485 driver enable, NULL if not used.*/
+	uint32_t dePinMask;                /*!< Driver enable pin mask (active high).*/
+}modbusRtuConfig_t;
+
+/*!< Slave counters.*/
+typedef struct{
+	uint32_t rxFrames;   /*!< Valid frames, to any address.*/
+	uint32_t txFrames;   /*!< Responses sent.*/
+	uint32_t crcErrors;  /*!< Frames with wrong CRC.*/
+	uint32_t badFrames;  /*!< Frames with a t1.5 gap, too long or short, or UART errors.*/
+	uint32_t exceptions; /*!< Exception responses.*/
+	uint32_t broadcasts; /*!< Broadcast requests executed.*/
+}modbusRtuStats_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Starts the slave in a previously initialized port.
+ *
+ *        Calls UartXfer_Init() with the slave RX hook and TX source and
+ *        initializes the TPM. The first request is accepted after 3.5
+ *        characters of silence.
+ *
+ * @param port   - the serial port.
+ * @param config - the configuration. The tables must stay valid.
+ *
+ * @return kStatus_Success if started;
+ *         kStatus_InvalidArgument if any parameter is invalid, the tables
+ *         are not sorted or the intervals do not fit in the TPM.
+ *
+ */
+status_t ModbusRtu_Init(uartXferPort_t port, const modbusRtuConfig_t *config);
+
+/**
+ * @brief Copies the slave counters.
+ *
+ * @param stats - where the counters will be copied.
+ *
+ */
+void ModbusRtu_GetStats(modbusRtuStats_t *stats);
+
+/**
+ * @brief The silent interval timer interrupt routine.
+ *
+ *        Must be called from TPMx_IRQHandler().
+ *
+ */
+void ModbusRtu_TimerIRQHandler(void);
+
+/**
+ * @brief Computes the Modbus CRC-16 (polynomial 0xA001 reflected, initial
+ *        value 0xFFFF) of a buffer.
+ *
+ * @param crc    - the initial value, or the result of a previous call.
+ * @param data   - the data.
+ * @param length - the data size in bytes.
+ *
+ * @return The updated CRC. In a frame it is sent low byte first.
+ *
+ */
+uint16_t ModbusRtu_Crc16(uint16_t crc, const uint8_t *data, size_t length);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* MODBUS_RTU_H_ */
@@ -0,0 +1,440 @@
+/**
+ * @file	uart_dma.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * DMA based transfers for the KL25Z serial ports: UART0 (LPSCI) and
+ * UART1/UART2 (UART).
+ *
+ */
+
+#include "uart_dma.h"
+#include "fsl_dmamux.h"
+#include "fsl_uart.h"
+#include "fsl_lpsci.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Receiver error flags. The bits have the same position in UART0_S1 and UARTx_S1.*/
+#define UART_DMA_S1_ERRORS (UART_S1_OR_MASK | UART_S1_NF_MASK | UART_S1_FE_MASK | UART_S1_PF_MASK)
+
+/*!< Byte count loaded in the RX channel. When it is exhausted the DMA
+ *   interrupt reloads it; the destination address keeps wrapping in the
+ *   ring by the modulo logic, so the reload is not seen by the reader.*/
+#define UART_DMA_RX_BLOCK_SIZE 0x80000U
+
+/*!< Maximum value of the DMA byte count register.*/
+#define UART_DMA_MAX_BCR 0xFFFFFU
+
+/*!< Runtime data of one port.*/
+typedef struct{
+	volatile uint8_t *s1;
+	volatile uint8_t *c2;
+	volatile uint8_t *d;
+	dma_handle_t rxDma;
+	dma_handle_t txDma;
+	uint8_t *rxRing;
+	uint16_t rxMask;
+	/*!< Bytes written by the DMA before the current RX block.*/
+	volatile uint32_t rxBlockBase;
+	/*!< Bytes consumed by the application (free running).*/
+	uint32_t rxRead;
+	/*!< Written bytes count at the last idle line event.*/
+	uint32_t rxIdleMark;
+	volatile bool txBusy;
+	uint32_t txLength;
+	uartDmaCallback_t callback;
+	void *userData;
+	uartDmaStats_t stats;
+}uartDmaHandle_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+static void RxDmaCallback(dma_handle_t *handle, void *userData);
+static void TxDmaCallback(dma_handle_t *handle, void *userData);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static uartDmaHandle_t s_handles[kUartXfer_PortsNumber];
+
+static const IRQn_Type s_irqs[kUartXfer_PortsNumber] = {UART0_IRQn, UART1_IRQn, UART2_IRQn};
+
+static const uint8_t s_rxSources[kUartXfer_PortsNumber] = {kDmaRequestMux0UART0Rx & 0xFFU,
+                                                           kDmaRequestMux0UART1Rx & 0xFFU,
+                                                           kDmaRequestMux0UART2Rx & 0xFFU};
+
+static const uint8_t s_txSources[kUartXfer_PortsNumber] = {kDmaRequestMux0UART0Tx & 0xFFU,
+                                                           kDmaRequestMux0UART1Tx & 0xFFU,
+                                                           kDmaRequestMux0UART2Tx & 0xFFU};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/**
+ * @brief Enables or disables the port TX DMA request.
+ *
+ */
+static void EnableTxDma(uartXferPort_t port, bool enable)
+{
+	if(port == kUartXfer_Uart0)
+	{
+		LPSCI_EnableTxDMA(UART0, enable);
+	}
+	else
+	{
+		UART_EnableTxDMA((port == kUartXfer_Uart1) ? UART1 : UART2, enable);
+	}
+}
+
+/**
+ * @brief Enables or disables the port RX DMA request.
+ *
+ */
+static void EnableRxDma(uartXferPort_t port, bool enable)
+{
+	if(port == kUartXfer_Uart0)
+	{
+		LPSCI_EnableRxDMA(UART0, enable);
+	}
+	else
+	{
+		UART_EnableRxDMA((port == kUartXfer_Uart1) ? UART1 : UART2, enable);
+	}
+}
+
+/**
+ * @brief Returns the total number of bytes written by the RX DMA.
+ *
+ */
+static uint32_t GetRxWritten(uartDmaHandle_t *handle)
+{
+	uint32_t primask = DisableGlobalIRQ();
+	uint32_t written = handle->rxBlockBase + UART_DMA_RX_BLOCK_SIZE -
+	                   DMA_GetRemainingBytes(handle->rxDma.base, handle->rxDma.channel);
+
+	EnableGlobalIRQ(primask);
+
+	return written;
+}
+
+/**
+ * @brief Reloads the RX byte count when the block is exhausted.
+ *
+ */
+static void RxDmaCallback(dma_handle_t *dmaHandle, void *userData)
+{
+	uartDmaHandle_t *handle = (uartDmaHandle_t *)userData;
+
+	/* DONE was cleared by DMA_HandleIRQ(). The DAR is untouched, the
+	 * modulo logic keeps it inside the ring. */
+	handle->rxBlockBase += UART_DMA_RX_BLOCK_SIZE;
+	DMA_SetTransferSize(dmaHandle->base, dmaHandle->channel, UART_DMA_RX_BLOCK_SIZE);
+}
+
+/**
+ * @brief Finishes the TX transfer.
+ *
+ */
+static void TxDmaCallback(dma_handle_t *dmaHandle, void *userData)
+{
+	uartXferPort_t port = (uartXferPort_t)(uint32_t)userData;
+	uartDmaHandle_t *handle = &s_handles[port];
+
+	(void)dmaHandle;
+
+	EnableTxDma(port, false);
+	handle->stats.txBytes += handle->txLength;
+	handle->txBusy = false;
+
+	if(handle->callback != NULL)
+	{
+		handle->callback(port, kUartDma_EventTxDone, handle->userData);
+	}
+}
+
+status_t UartDma_Init(uartXferPort_t port, const uartDmaConfig_t *config)
+{
+	uartDmaHandle_t *handle;
+	dma_transfer_config_t transferConfig;
+	dma_modulo_t modulo;
+	uint32_t dataRegister;
+	uint16_t size;
+
+	if((port >= kUartXfer_PortsNumber) || (config == NULL) || (config->rxRing == NULL) ||
+	   (config->rxChannel >= FSL_FEATURE_DMA_MODULE_CHANNEL) ||
+	   (config->txChannel >= FSL_FEATURE_DMA_MODULE_CHANNEL) ||
+	   (config->rxChannel == config->txChannel) ||
+	   (config->rxRingSize < UART_DMA_RX_RING_MIN_SIZE) ||
+	   (config->rxRingSize > UART_DMA_RX_RING_MAX_SIZE) ||
+	   (config->rxRingSize & (config->rxRingSize - 1U)) ||
+	   ((uint32_t)config->rxRing & (config->rxRingSize - 1U)))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	/* 16 bytes is kDMA_Modulo16Bytes, and each next power of two is the next modulo. */
+	modulo = kDMA_Modulo16Bytes;
+	for(size = UART_DMA_RX_RING_MIN_SIZE; size < config->rxRingSize; size <<= 1U)
+	{
+		modulo++;
+	}
+
+	DisableIRQ(s_irqs[port]);
+
+	handle = &s_handles[port];
+	memset(handle, 0, sizeof(*handle));
+
+	if(port == kUartXfer_Uart0)
+	{
+		handle->s1 = &UART0->S1;
+		handle->c2 = &UART0->C2;
+		handle->d = &UART0->D;
+		dataRegister = LPSCI_GetDataRegisterAddress(UART0);
+		UART0->C1 |= UART0_C1_ILT_MASK;
+		UART0->C3 |= UART0_C3_ORIE_MASK | UART0_C3_NEIE_MASK | UART0_C3_FEIE_MASK | UART0_C3_PEIE_MASK;
+	}
+	else
+	{
+		UART_Type *base = (port == kUartXfer_Uart1) ? UART1 : UART2;
+
+		handle->s1 = (volatile uint8_t *)&base->S1; /* Read only in UART1/2, writes are ignored. */
+		handle->c2 = &base->C2;
+		handle->d = &base->D;
+		dataRegister = UART_GetDataRegisterAddress(base);
+		base->C1 |= UART_C1_ILT_MASK;
+		base->C3 |= UART_C3_ORIE_MASK | UART_C3_NEIE_MASK | UART_C3_FEIE_MASK | UART_C3_PEIE_MASK;
+	}
+
+	handle->rxRing = config->rxRing;
+	handle->rxMask = config->rxRingSize - 1U;
+	handle->callback = config->callback;
+	handle->userData = config->userData;
+
+	DMAMUX_Init(DMAMUX0);
+	DMA_Init(DMA0);
+
+	/* RX channel: peripheral to circular ring, never stops. */
+	DMAMUX_DisableChannel(DMAMUX0, config->rxChannel);
+	DMAMUX_SetSource(DMAMUX0, config->rxChannel, s_rxSources[port]);
+	DMAMUX_EnableChannel(DMAMUX0, config->rxChannel);
+
+	DMA_CreateHandle(&handle->rxDma, DMA0, config->rxChannel);
+	DMA_SetCallback(&handle->rxDma, RxDmaCallback, handle);
+	DMA_PrepareTransfer(&transferConfig, (void *)dataRegister, 1U, config->rxRing, 1U,
+	                    UART_DMA_RX_BLOCK_SIZE, kDMA_PeripheralToMemory);
+	DMA_SubmitTransfer(&handle->rxDma, &transferConfig, kDMA_EnableInterrupt);
+	DMA_SetModulo(DMA0, config->rxChannel, kDMA_ModuloDisable, modulo);
+	/* Keeps the request enabled when the byte count is exhausted, so the
+	 * bytes received until the reload stay in the data register. */
+	DMA_EnableAutoStopRequest(DMA0, config->rxChannel, false);
+	DMA_StartTransfer(&handle->rxDma);
+
+	/* TX channel: memory to peripheral, configured at each send. */
+	DMAMUX_DisableChannel(DMAMUX0, config->txChannel);
+	DMAMUX_SetSource(DMAMUX0, config->txChannel, s_txSources[port]);
+	DMAMUX_EnableChannel(DMAMUX0, config->txChannel);
+
+	DMA_CreateHandle(&handle->txDma, DMA0, config->txChannel);
+	DMA_SetCallback(&handle->txDma, TxDmaCallback, (void *)(uint32_t)port);
+
+	/* Clear the stale flags before the DMA takes the data register. */
+	*handle->s1 = UART_DMA_S1_ERRORS | UART_S1_IDLE_MASK;
+	if(!(*handle->s1 & UART_S1_RDRF_MASK))
+	{
+		(void)*handle->d;
+	}
+
+	EnableRxDma(port, true);
+	*handle->c2 |= UART_C2_ILIE_MASK;
+
+	EnableIRQ(s_irqs[port]);
+
+	return kStatus_Success;
+}
+
+void UartDma_Deinit(uartXferPort_t port)
+{
+	uartDmaHandle_t *handle = &s_handles[port];
+
+	DisableIRQ(s_irqs[port]);
+	*handle->c2 &= ~UART_C2_ILIE_MASK;
+	EnableRxDma(port, false);
+	EnableTxDma(port, false);
+	DMA_AbortTransfer(&handle->rxDma);
+	DMA_AbortTransfer(&handle->txDma);
+	DMA_DisableInterrupts(DMA0, handle->rxDma.channel);
+	DMA_DisableInterrupts(DMA0, handle->txDma.channel);
+	DMAMUX_DisableChannel(DMAMUX0, handle->rxDma.channel);
+	DMAMUX_DisableChannel(DMAMUX0, handle->txDma.channel);
+	handle->txBusy = false;
+}
+
+status_t UartDma_Send(uartXferPort_t port, const uint8_t *data, size_t length)
+{
+	uartDmaHandle_t *handle = &s_handles[port];
+	dma_transfer_config_t transferConfig;
+	uint32_t dataRegister;
+
+	if((data == NULL) || (length == 0U) || (length > UART_DMA_MAX_BCR))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	if(handle->txBusy)
+	{
+		return kStatus_DMA_Busy;
+	}
+
+	handle->txBusy = true;
+	handle->txLength = length;
+
+	dataRegister = (uint32_t)handle->d;
+	DMA_PrepareTransfer(&transferConfig, (void *)data, 1U, (void *)dataRegister, 1U,
+	                    length, kDMA_MemoryToPeripheral);
+	DMA_SubmitTransfer(&handle->txDma, &transferConfig, kDMA_EnableInterrupt);
+	DMA_StartTransfer(&handle->txDma);
+	EnableTxDma(port, true);
+
+	return kStatus_Success;
+}
+
+bool UartDma_IsTxIdle(uartXferPort_t port)
+{
+	return !s_handles[port].txBusy;
+}
+
+size_t UartDma_GetRxCount(uartXferPort_t port)
+{
+	uartDmaHandle_t *handle = &s_handles[port];
+	uint32_t count = GetRxWritten(handle) - handle->rxRead;
+
+	if(count > (uint32_t)handle->rxMask + 1U)
+	{
+		count = (uint32_t)handle->rxMask + 1U;
+	}
+
+	return count;
+}
+
+size_t UartDma_Read(uartXferPort_t port, uint8_t *data, size_t length)
+{
+	uartDmaHandle_t *handle = &s_handles[port];
+	uint32_t written = GetRxWritten(handle);
+	uint32_t count = written - handle->rxRead;
+	uint32_t size = (uint32_t)handle->rxMask + 1U;
+	size_t i;
+
+	if(count > size)
+	{
+		/* The DMA lapped the reader: the oldest bytes were overwritten.
+		 * Keep the newest (size - 1) bytes, the last slot may be being
+		 * written right now. */
+		handle->stats.rxDropped += count - (size - 1U);
+		handle->rxRead = written - (size - 1U);
+		count = size - 1U;
+	}
+
+	if(length > count)
+	{
+		length = count;
+	}
+
+	for(i = 0U; i < length; i++)
+	{
+		data[i] = handle->rxRing[handle->rxRead & handle->rxMask];
+		handle->rxRead++;
+	}
+
+	return length;
+}
+
+void UartDma_GetStats(uartXferPort_t port, uartDmaStats_t *stats)
+{
+	uartDmaHandle_t *handle = &s_handles[port];
+	uint32_t primask = DisableGlobalIRQ();
+
+	*stats = handle->stats;
+	EnableGlobalIRQ(primask);
+	stats->rxBytes = GetRxWritten(handle);
+}
+
+void UartDma_IRQHandler(uartXferPort_t port)
+{
+	uartDmaHandle_t *handle = &s_handles[port];
+	uint32_t events = 0U;
+	uint8_t s1 = *handle->s1;
+	uint32_t written;
+
+	if(s1 & UART_DMA_S1_ERRORS)
+	{
+		if(s1 & UART_S1_OR_MASK)
+		{
+			handle->stats.overruns++;
+		}
+		if(s1 & UART_S1_FE_MASK)
+		{
+			handle->stats.framingErrors++;
+		}
+		if(s1 & UART_S1_NF_MASK)
+		{
+			handle->stats.noiseErrors++;
+		}
+		if(s1 & UART_S1_PF_MASK)
+		{
+			handle->stats.parityErrors++;
+		}
+		events |= kUartDma_EventRxError;
+	}
+
+	if(s1 & (UART_DMA_S1_ERRORS | UART_S1_IDLE_MASK))
+	{
+		/* UART0 flags are write 1 to clear. UART1/2 flags are cleared by
+		 * reading S1 then D. D is only read here when it is empty: if it
+		 * is full, the DMA reads it and completes the sequence, so no
+		 * received byte is stolen from the ring. */
+		*handle->s1 = s1 & (UART_DMA_S1_ERRORS | UART_S1_IDLE_MASK);
+		if(!(*handle->s1 & UART_S1_RDRF_MASK))
+		{
+			(void)*handle->d;
+		}
+	}
+
+	if(s1 & UART_S1_IDLE_MASK)
+	{
+		handle->stats.idleLines++;
+		written = GetRxWritten(handle);
+		if(written != handle->rxIdleMark)
+		{
+			handle->rxIdleMark = written;
+			events |= kUartDma_EventRxIdle;
+		}
+	}
+
+	if((events != 0U) && (handle->callback != NULL))
+	{
+		handle->callback(port, events, handle->userData);
+	}
+}
@@ -0,0 +1,207 @@
+/**
+ * @file	uart_dma.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * DMA based transfers for the KL25Z serial ports: UART0 (LPSCI) and
+ * UART1/UART2 (UART).
+ *
+ * Reception: one DMA channel writes continuously into a circular buffer,
+ * using the DMA destination address modulo, so no CPU is used per byte.
+ * The idle line interrupt notifies the application when a burst ends,
+ * and the application reads the data with UartDma_Read().
+ *
+ * Transmission: another DMA channel sends straight from the caller
+ * buffer, that must stay valid until the kUartDma_EventTxDone event.
+ *
+ * The port must be previously configured with UART_Init() or LPSCI_Init().
+ * The application must call UartDma_IRQHandler() from the port interrupt
+ * handler. The DMA interrupts are handled by the fsl_dma driver.
+ *
+ * A port can be used either by this module or by the uart_xfer engine.
+ *
+ */
+
+#ifndef UART_DMA_H_
+#define UART_DMA_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+#include "fsl_dma.h"
+#include "uart_xfer.h" /* uartXferPort_t */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup uart_dma
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Minimum and maximum RX ring sizes supported by the DMA modulo.*/
+#define UART_DMA_RX_RING_MIN_SIZE 16U
+#define UART_DMA_RX_RING_MAX_SIZE 4096U
+
+/*!< Declares a RX ring with the alignment required by the DMA modulo.*/
+#define UART_DMA_RX_RING_DEFINE(name, size) uint8_t name[size] __attribute__((aligned(size)))
+
+/*!< Events reported to the application callback (bit mask).*/
+enum _uart_dma_events{
+	kUartDma_EventRxIdle = (1U << 0),  /*!< Line became idle after receiving data.*/
+	kUartDma_EventRxError = (1U << 1), /*!< Overrun, framing, noise or parity error.*/
+	kUartDma_EventTxDone = (1U << 2),  /*!< Caller TX buffer completely sent.*/
+};
+
+/*!< Application callback, called in interrupt context.*/
+typedef void (*uartDmaCallback_t)(uartXferPort_t port, uint32_t events, void *userData);
+
+/*!
+ * @brief Configuration structure.
+ */
+typedef struct{
+	uint8_t *rxRing;           /*!< RX ring, aligned to its size (see UART_DMA_RX_RING_DEFINE).*/
+	uint16_t rxRingSize;       /*!< RX ring size: power of two, from 16 to 4096 bytes.*/
+	uint8_t rxChannel;         /*!< DMA channel used for reception.*/
+	uint8_t txChannel;         /*!< DMA channel used for transmission.*/
+	uartDmaCallback_t callback; /*!< Events callback, can be NULL.*/
+	void *userData;            /*!< Parameter passed to the callback.*/
+}uartDmaConfig_t;
+
+/*!< Per port counters.*/
+typedef struct{
+	uint32_t rxBytes;       /*!< Bytes written in the RX ring by the DMA.*/
+	uint32_t txBytes;       /*!< Bytes sent by the DMA.*/
+	uint32_t rxDropped;     /*!< Bytes overwritten before being read.*/
+	uint32_t overruns;      /*!< Hardware receiver overruns.*/
+	uint32_t framingErrors; /*!< Framing errors.*/
+	uint32_t noiseErrors;   /*!< Noise errors.*/
+	uint32_t parityErrors;  /*!< Parity errors.*/
+	uint32_t idleLines;     /*!< Idle line events.*/
+}uartDmaStats_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Starts the DMA transfers in a previously initialized port.
+ *
+ *        The DMA and DMAMUX are initialized and the circular reception
+ *        is started immediately.
+ *
+ * @param port   - the serial port.
+ * @param config - the configuration.
+ *
+ * @return kStatus_Success if started;
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t UartDma_Init(uartXferPort_t port, const uartDmaConfig_t *config);
+
+/**
+ * @brief Stops the DMA transfers and the port interrupts.
+ *
+ * @param port - the serial port.
+ *
+ */
+void UartDma_Deinit(uartXferPort_t port);
+
+/**
+ * @brief Sends a buffer through DMA, without blocking and without copy.
+ *
+ * @param port   - the serial port.
+ * @param data   - the data to send. Must remain valid until the
+ *                 kUartDma_EventTxDone event.
+ * @param length - the data size in bytes (up to 0xFFFFF).
+ *
+ * @return kStatus_Success if the transfer was started;
+ *         kStatus_DMA_Busy if a previous transfer is not finished;
+ *         kStatus_InvalidArgument if length is invalid.
+ *
+ */
+status_t UartDma_Send(uartXferPort_t port, const uint8_t *data, size_t length);
+
+/**
+ * @brief Tests if the last UartDma_Send() transfer is finished.
+ *
+ * @param port - the serial port.
+ *
+ * @return true if there is no transfer in progress.
+ *
+ */
+bool UartDma_IsTxIdle(uartXferPort_t port);
+
+/**
+ * @brief Returns the number of received bytes not read yet.
+ *
+ * @param port - the serial port.
+ *
+ * @return The number of bytes, limited to the RX ring size.
+ *
+ */
+size_t UartDma_GetRxCount(uartXferPort_t port);
+
+/**
+ * @brief Gets received data from the RX ring, without blocking.
+ *
+ *        If the DMA has overwritten data not read yet, the oldest
+ *        bytes are discarded and counted in rxDropped.
+ *
+ * @param port   - the serial port.
+ * @param data   - where the data will be stored.
+ * @param length - the maximum number of bytes to get.
+ *
+ * @return The number of bytes read.
+ *
+ */
+size_t UartDma_Read(uartXferPort_t port, uint8_t *data, size_t length);
+
+/**
+ * @brief Copies the port counters.
+ *
+ * @param port  - the serial port.
+ * @param stats - where the counters will be copied.
+ *
+ */
+void UartDma_GetStats(uartXferPort_t port, uartDmaStats_t *stats);
+
+/**
+ * @brief The port interrupt routine (idle line and errors).
+ *
+ *        Must be called from UARTx_IRQHandler().
+ *
+ * @param port - the serial port.
+ *
+ */
+void UartDma_IRQHandler(uartXferPort_t port);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* UART_DMA_H_ */
@@ -0,0 +1,379 @@
+/**
+ * @file	uart_xfer.c
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A fully interrupt driven transfer engine for the KL25Z serial ports:
+ * UART0 (LPSCI) and UART1/UART2 (UART).
+ *
+ */
+
+#include "uart_xfer.h"
+#include "fsl_device_registers.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Receiver error flags. The bits have the same position in UART0_S1 and UARTx_S1.*/
+#define UART_XFER_S1_ERRORS (UART_S1_OR_MASK | UART_S1_NF_MASK | UART_S1_FE_MASK | UART_S1_PF_MASK)
+
+/*!< Runtime data of one port.
+ *   The ring indexes are free running: the number of stored bytes is
+ *   (head - tail) and the position in memory is (index & mask).
+ *   RX: head written by the ISR, tail by the application.
+ *   TX: head written by the application, tail by the ISR.*/
+typedef struct{
+	/*!< UART0 and UART1/2 have the S1, C2 and D registers at the same
+	 *   offsets and with the same bits, so the ISR does not care about
+	 *   the port type.*/
+	volatile uint8_t *s1;
+	volatile uint8_t *c2;
+	volatile uint8_t *d;
+	uint8_t *rxBuffer;
+	uint8_t *txBuffer;
+	uint16_t rxMask;
+	uint16_t txMask;
+	volatile uint16_t rxHead;
+	volatile uint16_t rxTail;
+	volatile uint16_t txHead;
+	volatile uint16_t txTail;
+	bool rxPending; /*!< Data received since the last idle line event.*/
+	uartXferCallback_t callback;
+	uartXferRxHook_t rxHook;
+	uartXferTxSource_t txSource;
+	void *userData;
+	uartXferStats_t stats;
+}uartXferHandle_t;
+
+/*******************************************************************************
+ * Private Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Tests if a buffer size is a power of two, from 1 to
+ *        UART_XFER_MAX_BUFFER_SIZE.
+ *
+ */
+static inline bool IsValidSize(uint32_t x)
+{
+	return (x != 0U) && (x <= UART_XFER_MAX_BUFFER_SIZE) && ((x & (x - 1U)) == 0U);
+}
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static uartXferHandle_t s_handles[kUartXfer_PortsNumber];
+
+static const IRQn_Type s_irqs[kUartXfer_PortsNumber] = {UART0_IRQn, UART1_IRQn, UART2_IRQn};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+status_t UartXfer_Init(uartXferPort_t port, const uartXferConfig_t *config)
+{
+	uartXferHandle_t *handle;
+	uint8_t c2;
+
+	if((port >= kUartXfer_PortsNumber) || (config == NULL) ||
+	   ((config->rxHook == NULL) && ((config->rxBuffer == NULL) || !IsValidSize(config->rxBufferSize))) ||
+	   ((config->txSource == NULL) && ((config->txBuffer == NULL) || !IsValidSize(config->txBufferSize))))
+	{
+		return kStatus_InvalidArgument;
+	}
+
+	DisableIRQ(s_irqs[port]);
+
+	handle = &s_handles[port];
+	memset(handle, 0, sizeof(*handle));
+
+	if(port == kUartXfer_Uart0)
+	{
+		handle->s1 = &UART0->S1;
+		handle->c2 = &UART0->C2;
+		handle->d = &UART0->D;
+		/* Idle character count starts after the stop bit. */
+		UART0->C1 |= UART0_C1_ILT_MASK;
+		/* Overrun, noise, framing and parity interrupts. */
+		UART0->C3 |= UART0_C3_ORIE_MASK | UART0_C3_NEIE_MASK | UART0_C3_FEIE_MASK | UART0_C3_PEIE_MASK;
+	}
+	else
+	{
+		UART_Type *base = (port == kUartXfer_Uart1) ? UART1 : UART2;
+
+		handle->s1 = (volatile uint8_t *)&base->S1; /* Read only in UART1/2, writes are ignored. */
+		handle->c2 = &base->C2;
+		handle->d = &base->D;
+		base->C1 |= UART_C1_ILT_MASK;
+		base->C3 |= UART_C3_ORIE_MASK | UART_C3_NEIE_MASK | UART_C3_FEIE_MASK | UART_C3_PEIE_MASK;
+	}
+
+	handle->rxBuffer = config->rxBuffer;
+	handle->rxMask = (uint16_t)(config->rxBufferSize - 1U);
+	handle->txBuffer = config->txBuffer;
+	handle->txMask = (uint16_t)(config->txBufferSize - 1U);
+	handle->callback = config->callback;
+	handle->rxHook = config->rxHook;
+	handle->txSource = config->txSource;
+	handle->userData = config->userData;
+
+	/* Discard any stale data and clear the error flags. */
+	(void)*handle->s1;
+	(void)*handle->d;
+	*handle->s1 = UART_XFER_S1_ERRORS | UART_S1_IDLE_MASK;
+
+	/* TX interrupt stays disabled until there is data to send. */
+	c2 = *handle->c2 & ~(UART_C2_TIE_MASK | UART_C2_TCIE_MASK | UART_C2_ILIE_MASK);
+	c2 |= UART_C2_RIE_MASK;
+	if(config->enableIdleLine)
+	{
+		c2 |= UART_C2_ILIE_MASK;
+	}
+	*handle->c2 = c2;
+
+	EnableIRQ(s_irqs[port]);
+
+	return kStatus_Success;
+}
+
+void UartXfer_Deinit(uartXferPort_t port)
+{
+	uartXferHandle_t *handle = &s_handles[port];
+
+	DisableIRQ(s_irqs[port]);
+	*handle->c2 &= ~(UART_C2_TIE_MASK | UART_C2_TCIE_MASK | UART_C2_RIE_MASK | UART_C2_ILIE_MASK);
+	handle->txTail = handle->txHead;
+}
+
+size_t UartXfer_Write(uartXferPort_t port, const uint8_t *data, size_t length)
+{
+	uartXferHandle_t *handle = &s_handles[port];
+	uint16_t head = handle->txHead;
+	size_t space = (size_t)handle->txMask + 1U - (uint16_t)(head - handle->txTail);
+	size_t i;
+
+	if(handle->txBuffer == NULL)
+	{
+		return 0U;
+	}
+
+	if(length > space)
+	{
+		length = space;
+	}
+
+	for(i = 0U; i < length; i++)
+	{
+		handle->txBuffer[head & handle->txMask] = data[i];
+		head++;
+	}
+
+	if(length != 0U)
+	{
+		/* Publish the data before enabling the interrupt. If the ISR
+		 * preempts the read-modify-write below it can only clear TIE,
+		 * and that is overwritten with TIE set, which is correct
+		 * because there is data pending. */
+		handle->txHead = head;
+		*handle->c2 |= UART_C2_TIE_MASK;
+	}
+
+	return length;
+}
+
+void UartXfer_StartTx(uartXferPort_t port)
+{
+	/* Same race as in UartXfer_Write(): the ISR can only clear TIE. */
+	*s_handles[port].c2 |= UART_C2_TIE_MASK;
+}
+
+size_t UartXfer_Read(uartXferPort_t port, uint8_t *data, size_t length)
+{
+	uartXferHandle_t *handle = &s_handles[port];
+	uint16_t tail = handle->rxTail;
+	size_t count = (uint16_t)(handle->rxHead - tail);
+	size_t i;
+
+	if(length > count)
+	{
+		length = count;
+	}
+
+	for(i = 0U; i < length; i++)
+	{
+		data[i] = handle->rxBuffer[tail & handle->rxMask];
+		tail++;
+	}
+
+	handle->rxTail = tail;
+
+	return length;
+}
+
+size_t UartXfer_GetRxCount(uartXferPort_t port)
+{
+	uartXferHandle_t *handle = &s_handles[port];
+
+	return (uint16_t)(handle->rxHead - handle->rxTail);
+}
+
+size_t UartXfer_GetTxFree(uartXferPort_t port)
+{
+	uartXferHandle_t *handle = &s_handles[port];
+
+	if(handle->txBuffer == NULL)
+	{
+		return 0U;
+	}
+
+	return (size_t)handle->txMask + 1U - (uint16_t)(handle->txHead - handle->txTail);
+}
+
+bool UartXfer_IsTxIdle(uartXferPort_t port)
+{
+	uartXferHandle_t *handle = &s_handles[port];
+
+	return handle->txHead == handle->txTail;
+}
+
+void UartXfer_GetStats(uartXferPort_t port, uartXferStats_t *stats)
+{
+	uint32_t primask = DisableGlobalIRQ();
+
+	*stats = s_handles[port].stats;
+	EnableGlobalIRQ(primask);
+}
+
+void UartXfer_ResetStats(uartXferPort_t port)
+{
+	uint32_t primask = DisableGlobalIRQ();
+
+	memset(&s_handles[port].stats, 0, sizeof(uartXferStats_t));
+	EnableGlobalIRQ(primask);
+}
+
+void UartXfer_IRQHandler(uartXferPort_t port)
+{
+	uartXferHandle_t *handle = &s_handles[port];
+	uint32_t events = 0U;
+	uint8_t s1 = *handle->s1;
+	uint8_t data;
+
+	if(s1 & UART_XFER_S1_ERRORS)
+	{
+		if(s1 & UART_S1_OR_MASK)
+		{
+			handle->stats.overruns++;
+		}
+		if(s1 & UART_S1_FE_MASK)
+		{
+			handle->stats.framingErrors++;
+		}
+		if(s1 & UART_S1_NF_MASK)
+		{
+			handle->stats.noiseErrors++;
+		}
+		if(s1 & UART_S1_PF_MASK)
+		{
+			handle->stats.parityErrors++;
+		}
+		/* UART0 flags are write 1 to clear. On UART1/2 the write is
+		 * ignored and the flags are cleared by the S1 then D reads. */
+		*handle->s1 = s1 & UART_XFER_S1_ERRORS;
+		events |= kUartXfer_EventRxError;
+	}
+
+	if(s1 & UART_S1_RDRF_MASK)
+	{
+		uint16_t head = handle->rxHead;
+
+		data = *handle->d;
+		if(handle->rxHook != NULL)
+		{
+			handle->rxHook(port, data, (s1 & UART_XFER_S1_ERRORS) != 0U, handle->userData);
+			handle->stats.rxBytes++;
+		}
+		else if((uint16_t)(head - handle->rxTail) <= handle->rxMask)
+		{
+			handle->rxBuffer[head & handle->rxMask] = data;
+			handle->rxHead = head + 1U;
+			handle->stats.rxBytes++;
+		}
+		else
+		{
+			handle->stats.rxDropped++;
+			events |= kUartXfer_EventRxOverflow;
+		}
+		handle->rxPending = true;
+	}
+	else if(s1 & (UART_XFER_S1_ERRORS | UART_S1_IDLE_MASK))
+	{
+		/* Completes the UART1/2 flags clearing sequence. */
+		(void)*handle->d;
+	}
+
+	if(s1 & UART_S1_IDLE_MASK)
+	{
+		*handle->s1 = UART_S1_IDLE_MASK;
+		handle->stats.idleLines++;
+		/* Idle after a burst: notify so a partial frame is flushed. */
+		if(handle->rxPending)
+		{
+			handle->rxPending = false;
+			events |= kUartXfer_EventRxIdle;
+		}
+	}
+
+	if((s1 & UART_S1_TDRE_MASK) && (*handle->c2 & UART_C2_TIE_MASK))
+	{
+		uint16_t tail = handle->txTail;
+		bool sent = false;
+
+		if(tail != handle->txHead)
+		{
+			*handle->d = handle->txBuffer[tail & handle->txMask];
+			handle->txTail = tail + 1U;
+			handle->stats.txBytes++;
+			sent = true;
+		}
+		else if((handle->txSource != NULL) && handle->txSource(port, &data, handle->userData))
+		{
+			*handle->d = data;
+			handle->stats.txBytes++;
+			sent = true;
+		}
+
+		/* Without a TX source the end is known as soon as the ring is
+		 * drained. With it, only when the source has nothing to give. */
+		if(!sent || ((handle->txSource == NULL) && (handle->txTail == handle->txHead)))
+		{
+			/* Nothing else to send: stop the TX interrupt, so the CPU
+			 * is not waken up while the line has nothing to do. */
+			*handle->c2 &= ~UART_C2_TIE_MASK;
+			events |= kUartXfer_EventTxDone;
+		}
+	}
+
+	if((events != 0U) && (handle->callback != NULL))
+	{
+		handle->callback(port, events, handle->userData);
+	}
+}
@@ -0,0 +1,258 @@
+/**
+ * @file	uart_xfer.h
+ * @author  Matheus Leitzke Pinto <matheus.pinto@ifsc.edu.br>
+ * @version 1.0
+ * @date    2026
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * http://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A fully interrupt driven transfer engine for the KL25Z serial ports:
+ * UART0 (LPSCI) and UART1/UART2 (UART).
+ *
+ * Reception and transmission are done through two ring buffers. The
+ * TX data register empty interrupt is only enabled while there is data
+ * pending in the TX ring, so the CPU can sleep (WFI) between bursts.
+ * The idle line interrupt notifies the application when the line goes
+ * quiet, so it can flush partially received frames.
+ *
+ * The port must be previously configured with UART_Init() or LPSCI_Init()
+ * (baud rate, parity, TX/RX enable). The application must call
+ * UartXfer_IRQHandler() from the port interrupt handler.
+ *
+ * Protocol layers can bypass the rings: a RX hook receives each byte
+ * straight from the ISR, and a TX source is asked for the next byte
+ * when the TX ring is empty (see the cobs_frame module).
+ *
+ */
+
+#ifndef UART_XFER_H_
+#define UART_XFER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup uart_xfer
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!< Largest ring buffer size: the 16 bit indexes must tell a full ring
+ *   from an empty one.*/
+#define UART_XFER_MAX_BUFFER_SIZE 32768U
+
+/*!< Serial ports handled by the engine.*/
+typedef enum{
+	kUartXfer_Uart0 = 0U, /*!< UART0, driven by the LPSCI driver.*/
+	kUartXfer_Uart1 = 1U, /*!< UART1, driven by the UART driver.*/
+	kUartXfer_Uart2 = 2U, /*!< UART2, driven by the UART driver.*/
+	kUartXfer_PortsNumber
+}uartXferPort_t;
+
+/*!< Events reported to the application callback (bit mask).*/
+enum _uart_xfer_events{
+	kUartXfer_EventRxIdle = (1U << 0),     /*!< Line became idle after receiving data.*/
+	kUartXfer_EventRxOverflow = (1U << 1), /*!< Byte dropped because the RX ring was full.*/
+	kUartXfer_EventRxError = (1U << 2),    /*!< Overrun, framing, noise or parity error.*/
+	kUartXfer_EventTxDone = (1U << 3),     /*!< TX ring drained.*/
+};
+
+/*!< Application callback, called in interrupt context.*/
+typedef void (*uartXferCallback_t)(uartXferPort_t port, uint32_t events, void *userData);
+
+/*!< RX hook, called in interrupt context for each received byte, instead
+ *   of storing it in the RX ring. error is true if the byte came with a
+ *   framing, noise or parity error, or after an overrun.*/
+typedef void (*uartXferRxHook_t)(uartXferPort_t port, uint8_t data, bool error, void *userData);
+
+/*!< TX source, called in interrupt context when the TX ring is empty.
+ *   Returns true and the next byte in data, or false if there is nothing
+ *   else to send.*/
+typedef bool (*uartXferTxSource_t)(uartXferPort_t port, uint8_t *data, void *userData);
+
+/*!
+ * @brief Engine configuration structure.
+ *
+ * The buffer sizes must be powers of two, up to
+ * UART_XFER_MAX_BUFFER_SIZE, so the ring indexes are wrapped with a mask
+ * instead of a division.
+ */
+typedef struct{
+	uint8_t *rxBuffer;           /*!< RX ring buffer memory (NULL if rxHook is used).*/
+	uint32_t rxBufferSize;       /*!< RX ring buffer size (power of two).*/
+	uint8_t *txBuffer;           /*!< TX ring buffer memory (can be NULL if txSource is used).*/
+	uint32_t txBufferSize;       /*!< TX ring buffer size (power of two).*/
+	bool enableIdleLine;         /*!< Enables the idle line detection.*/
+	uartXferCallback_t callback; /*!< Events callback, can be NULL.*/
+	uartXferRxHook_t rxHook;     /*!< RX hook, can be NULL.*/
+	uartXferTxSource_t txSource; /*!< TX source, can be NULL.*/
+	void *userData;              /*!< Parameter passed to the callback, hook and source.*/
+}uartXferConfig_t;
+
+/*!< Per port counters, updated in interrupt context.*/
+typedef struct{
+	uint32_t rxBytes;       /*!< Bytes stored in the RX ring or passed to the RX hook.*/
+	uint32_t txBytes;       /*!< Bytes written to the data register.*/
+	uint32_t rxDropped;     /*!< Bytes dropped because the RX ring was full.*/
+	uint32_t overruns;      /*!< Hardware receiver overruns.*/
+	uint32_t framingErrors; /*!< Framing errors.*/
+	uint32_t noiseErrors;   /*!< Noise errors.*/
+	uint32_t parityErrors;  /*!< Parity errors.*/
+	uint32_t idleLines;     /*!< Idle line events.*/
+}uartXferStats_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Starts the transfer engine in a previously initialized port.
+ *
+ *        The RX, idle line and error interrupts are enabled. The NVIC
+ *        interrupt is also enabled.
+ *
+ * @param port   - the serial port.
+ * @param config - the engine configuration.
+ *
+ * @return kStatus_Success if started;
+ *         kStatus_InvalidArgument if any parameter is invalid.
+ *
+ */
+status_t UartXfer_Init(uartXferPort_t port, const uartXferConfig_t *config);
+
+/**
+ * @brief Stops the transfer engine, disabling the port interrupts.
+ *
+ *        Pending TX data is discarded.
+ *
+ * @param port - the serial port.
+ *
+ */
+void UartXfer_Deinit(uartXferPort_t port);
+
+/**
+ * @brief Queues data to be sent, without blocking.
+ *
+ *        The data is copied to the TX ring and the TX data register
+ *        empty interrupt is enabled.
+ *
+ * @param port   - the serial port.
+ * @param data   - the data to send.
+ * @param length - the data size in bytes.
+ *
+ * @return The number of bytes queued, that can be lower than length
+ *         if the TX ring has not enough space.
+ *
+ */
+size_t UartXfer_Write(uartXferPort_t port, const uint8_t *data, size_t length);
+
+/**
+ * @brief Enables the TX data register empty interrupt, so the TX source
+ *        is asked for data.
+ *
+ *        Must be called when the TX source gets new data to send.
+ *
+ * @param port - the serial port.
+ *
+ */
+void UartXfer_StartTx(uartXferPort_t port);
+
+/**
+ * @brief Gets received data, without blocking.
+ *
+ * @param port   - the serial port.
+ * @param data   - where the data will be stored.
+ * @param length - the maximum number of bytes to get.
+ *
+ * @return The number of bytes read.
+ *
+ */
+size_t UartXfer_Read(uartXferPort_t port, uint8_t *data, size_t length);
+
+/**
+ * @brief Returns the number of bytes available in the RX ring.
+ *
+ * @param port - the serial port.
+ *
+ * @return The number of bytes.
+ *
+ */
+size_t UartXfer_GetRxCount(uartXferPort_t port);
+
+/**
+ * @brief Returns the free space in the TX ring.
+ *
+ * @param port - the serial port.
+ *
+ * @return The number of bytes, 0 if there is no TX ring.
+ *
+ */
+size_t UartXfer_GetTxFree(uartXferPort_t port);
+
+/**
+ * @brief Tests if all TX data was moved to the hardware.
+ *
+ * @param port - the serial port.
+ *
+ * @return true if the TX ring is empty. The TX source state is
+ *         not considered.
+ *
+ */
+bool UartXfer_IsTxIdle(uartXferPort_t port);
+
+/**
+ * @brief Copies the port counters.
+ *
+ * @param port  - the serial port.
+ * @param stats - where the counters will be copied.
+ *
+ */
+void UartXfer_GetStats(uartXferPort_t port, uartXferStats_t *stats);
+
+/**
+ * @brief Clears the port counters.
+ *
+ * @param port - the serial port.
+ *
+ */
+void UartXfer_ResetStats(uartXferPort_t port);
+
+/**
+ * @brief The engine interrupt routine.
+ *
+ *        Must be called from UARTx_IRQHandler().
+ *
+ * @param port - the serial port.
+ *
+ */
+void UartXfer_IRQHandler(uartXferPort_t port);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* UART_XFER_H_ */